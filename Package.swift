@@ -12,9 +12,35 @@ fileprivate let cswiftslashTargets:[Target] = [
 		name:"__cswiftslash_types",
 		publicHeadersPath:"."
 	),
+	// node pool
+	.target(
+		name:"__cswiftslash_pool",
+		dependencies: [
+			"__cswiftslash_types"
+		],
+		publicHeadersPath:"."
+	),
 	// fifo
 	.target(
 		name:"__cswiftslash_fifo",
+		dependencies: [
+			"__cswiftslash_types",
+			"__cswiftslash_pool",
+			"__cswiftslash_timer"
+		],
+		publicHeadersPath:"."
+	),
+	// doorbell
+	.target(
+		name:"__cswiftslash_doorbell",
+		dependencies: [
+			"__cswiftslash_types"
+		],
+		publicHeadersPath:"."
+	),
+	// broadcast
+	.target(
+		name:"__cswiftslash_broadcast",
 		dependencies: [
 			"__cswiftslash_types"
 		],
@@ -24,7 +50,6 @@ fileprivate let cswiftslashTargets:[Target] = [
 	.target(
 		name:"__cswiftslash_future",
 		dependencies: [
-			"__cswiftslash_identified_list",
 			"__cswiftslash_types"
 		],
 		publicHeadersPath:"."
@@ -42,11 +67,20 @@ fileprivate let cswiftslashTargets:[Target] = [
 		name:"__cswiftslash_posix_helpers",
 		publicHeadersPath:"."
 	),
+	// timer
+	.target(
+		name:"__cswiftslash_timer",
+		dependencies: [
+			"__cswiftslash_types"
+		],
+		publicHeadersPath:"."
+	),
 	// identified list
 	.target(
 		name:"__cswiftslash_identified_list",
 		dependencies: [
-			"__cswiftslash_types"
+			"__cswiftslash_types",
+			"__cswiftslash_pool"
 		],
 		publicHeadersPath:"."
 	),
@@ -63,6 +97,7 @@ fileprivate let swiftTargets:[Target] = [
 		name:"SwiftSlashFuture",
 		dependencies:[
 			"__cswiftslash_future",
+			"__cswiftslash_timer",
 			"SwiftSlashContained"
 		]
 	),
@@ -78,6 +113,9 @@ fileprivate let swiftTargets:[Target] = [
 		name:"SwiftSlashFIFO",
 		dependencies:[
 			"__cswiftslash_fifo",
+			"__cswiftslash_doorbell",
+			"__cswiftslash_broadcast",
+			"__cswiftslash_timer",
 			"SwiftSlashContained"
 		]
 	),
@@ -91,6 +129,7 @@ fileprivate let swiftTargets:[Target] = [
 		name:"SwiftSlashEventTrigger",
 		dependencies:[
 			"__cswiftslash_eventtrigger",
+			"__cswiftslash_timer",
 			"SwiftSlashPThread",
 			"SwiftSlashFIFO",
 			"SwiftSlashFHHelpers"
@@ -113,11 +152,14 @@ fileprivate let testTarget:Target = .testTarget(
 	name:"SwiftSlashInternalTests",
 	dependencies:[
 		"__cswiftslash_fifo",
+		"__cswiftslash_doorbell",
+		"__cswiftslash_broadcast",
 		"__cswiftslash_future",
 		"__cswiftslash_types",
 		"__cswiftslash_threads",
 		"__cswiftslash_eventtrigger",
 		"__cswiftslash_identified_list",
+		"__cswiftslash_timer",
 		"SwiftSlashFuture",
 		"SwiftSlashContained",
 		"SwiftSlashPThread",
@@ -10,6 +10,8 @@ copyright (c) tanner silva 2025. all rights reserved.
 */
 
 import __cswiftslash_posix_helpers
+import SwiftSlashEventTrigger
+import SwiftSlashGlobalSerialization
 
 /// Comprehensive tool for launching `Command`s.
 /// - NOTE: When SwiftSlash launches a process, the launched process is referred to as a *child* process.
@@ -51,6 +53,23 @@ public actor ChildProcess {
 		case signal(Int32)
 	}
 
+	/// Describes how a child process is stopped when it runs past its deadline.
+	public struct Escalation:Sendable {
+		/// The signal that is sent to the child process when the deadline passes.
+		public let signal:Int32
+		/// The time that the child process is given to exit after the first signal. If it is still running once this has passed, it is sent `SIGKILL`.
+		public let grace:Duration
+
+		/// Initialize an escalation.
+		/// - Parameters:
+		/// 	- signal: The signal that is sent to the child process when the deadline passes.
+		/// 	- grace: The time that the child process is given to exit after the first signal, before it is sent `SIGKILL`.
+		public init(signal:Int32 = SIGTERM, grace:Duration = .seconds(5)) {
+			self.signal = signal
+			self.grace = grace
+		}
+	}
+
 	/// The current operating state of the process. This is a primary pillar of logic for the ChildProcess functionality.
 	public private(set) var state:State = .initialized
 
@@ -116,6 +135,21 @@ public actor ChildProcess {
 	/// This function will not return until the child process exits.
 	/// - Returns: The exit or signal code that the child process exited with.
 	public func run() async throws -> Exit {
+		return try await launchAndReap(deadline:nil, escalation:Escalation())
+	}
+
+	/// Launches the child process by executing the configured command with the configured data channels, and stops the child process if it is still running at the deadline.
+	/// This function will not return until the child process exits. The deadline is enforced by the event trigger that monitors the child process, so no task or thread is spent waiting on it.
+	/// - Parameters:
+	/// 	- deadline: The time by which the child process should have exited.
+	/// 	- escalation: How the child process is stopped once the deadline passes. By default, it is sent `SIGTERM`, then `SIGKILL` five seconds later.
+	/// - Returns: The exit or signal code that the child process exited with.
+	public func run(deadline:ContinuousClock.Instant, escalation:Escalation = Escalation()) async throws -> Exit {
+		return try await launchAndReap(deadline:deadline, escalation:escalation)
+	}
+
+	/// launches the child process, enforces its deadline (if any), and reaps it.
+	private func launchAndReap(deadline:ContinuousClock.Instant?, escalation:Escalation) async throws -> Exit {
 		// check the current state of the process. 
 		switch state {
 			case .initialized:
@@ -147,8 +181,15 @@ public actor ChildProcess {
 						curRead.launch(taskGroup:&tg)
 					}
 					
+					// schedule the termination of the running process if it has a deadline.
+					let terminationTimers = deadline.map { preapredPackage.scheduleTermination(at:$0, signal:escalation.signal, grace:escalation.grace) } ?? []
+
 					// reap the running process
-					switch await preapredPackage.launchedPID.waitPID() {
+					let reapResult = await preapredPackage.reap()
+					for curTimer in terminationTimers {
+						try? curTimer.cancel()
+					}
+					switch reapResult {
 						case .exited(let exitCode):
 							state = .reaped(.code(exitCode))
 							try await tg.waitForAll()
@@ -219,6 +260,23 @@ extension ChildProcess {
 	}
 }
 
+extension ChildProcess {
+	/// Configures the event trigger shards that monitor the data channels of child processes. Each shard polls on its own thread, and every child process is assigned to a single shard when it launches.
+	/// - Parameters:
+	///   - shards: The number of event trigger shards. Values less than one are treated as one.
+	///   - policy: The policy used to assign newly launched child processes to a shard.
+	///   - backend: The engine that each shard runs on. Shards that cannot run on the requested engine fall back to the readiness interface of the platform.
+	/// - NOTE: Child processes that are already running are not moved. The new configuration applies to child processes launched after this call.
+	@SwiftSlashGlobalSerialization public static func configureEventTriggers(shards:Int, policy:EventTriggerShards.AssignmentPolicy = .leastLoaded, backend:EventTrigger.Backend = .poll) {
+		ProcessLogistics.configureEventTriggers(count:shards, policy:policy, backend:backend)
+	}
+
+	/// The number of file handles that are registered with each event trigger shard, in shard order. Empty until a child process is launched under the current configuration.
+	@SwiftSlashGlobalSerialization public static var eventTriggerLoad:[Int] {
+		return ProcessLogistics.eventTriggerLoad()
+	}
+}
+
 extension ChildProcess.Exit:Hashable, Equatable, CustomDebugStringConvertible {
 	public static func == (lhs:ChildProcess.Exit, rhs:ChildProcess.Exit) -> Bool {
 		switch (lhs, rhs) {
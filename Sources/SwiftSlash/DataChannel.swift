@@ -11,6 +11,7 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 import SwiftSlashFIFO
 import SwiftSlashFuture
+import Synchronization
 
 /// Represents a unidirectional data channel that will connect to the launched process.
 /// Data channels must be prepared for a child process **before** the process is launched.
@@ -35,43 +36,118 @@ public enum DataChannel:Sendable {
 			/// Multiple lines or segments are grouped into a single array to reduce async context switching and ensure timely delivery of data.
 			public typealias Element = [[UInt8]]
 			
+			/// A snapshot of how much data the channel is buffering for its iterators.
+			public struct Statistics:Sendable {
+				/// The number of data chunks currently buffered because at least one iterator has yet to consume them.
+				public let bufferedChunks:Int
+				/// The highest number of data chunks the channel has buffered at once.
+				public let highWaterMark:Int
+				/// The total number of data chunks the channel has received from the child process.
+				public let totalChunks:UInt64
+			}
+
 			/// Create a new data channel for child-to-parent streaming.
-			public init() {}
+			public init() {
+				let newBroadcast = BroadcastFIFO<[[UInt8]], Never>()
+				primary = Primary(newBroadcast.subscribe())
+				broadcast = newBroadcast
+			}
 	
-			/// Returns an async iterator yielding data chunks until the channel closes.
+			/// Returns an async iterator yielding data chunks until the channel closes. Every data chunk is buffered for this iterator from the moment the channel is created, unless ``makeSubscriberIterator()`` was called first, in which case this iterator receives the data chunks written after this call.
+			/// - NOTE: Cancelling a task that is waiting on this iterator closes the channel.
 			public borrowing func makeAsyncIterator() -> AsyncIterator {
-				AsyncIterator(fifo.makeAsyncConsumerExplicit())
+				AsyncIterator(primary.claim(from:broadcast), whenTaskCancelled:.finish)
+			}
+
+			/// Returns an additional async iterator that receives its own copy of every data chunk the child writes after this call. Any number of iterators may be created, and each data chunk is stored once and released after the slowest iterator has consumed it.
+			/// - NOTE: Cancelling a task that is waiting on this iterator does not affect the channel or any other iterator. If ``makeAsyncIterator()`` has not been called yet, the data chunks that were being buffered for it are released.
+			public borrowing func makeSubscriberIterator() -> AsyncIterator {
+				primary.releaseUnclaimed()
+				return AsyncIterator(broadcast.subscribe(), whenTaskCancelled:.noAction)
 			}
 			
-			/// Internal FIFO for buffering incoming data.
-			internal let fifo:FIFO<[[UInt8]], Never> = .init()
+			/// Returns a snapshot of how much data the channel is buffering. A steadily rising ``Statistics/bufferedChunks`` indicates that an iterator is falling behind the child process.
+			public var statistics:Statistics {
+				let broadcastStatistics = broadcast.statistics
+				return Statistics(bufferedChunks:broadcastStatistics.depth, highWaterMark:broadcastStatistics.highWaterMark, totalChunks:broadcastStatistics.totalPassed)
+			}
+
+			/// Internal broadcast FIFO for buffering incoming data for each iterator.
+			internal let broadcast:BroadcastFIFO<[[UInt8]], Never>
+
+			/// The subscriber that backs ``makeAsyncIterator()``.
+			private let primary:Primary
+
+			/// Holds the subscriber that backs ``makeAsyncIterator()``. It is subscribed when the channel is created so that no data is lost before iteration begins, and released if ``makeSubscriberIterator()`` is called before it is claimed, so that a channel consumed only through subscriber iterators does not buffer every data chunk for an iterator that will never exist.
+			internal final class Primary:Sendable {
+				private enum State {
+					/// Subscribed at creation and buffering every data chunk.
+					case unclaimed(BroadcastFIFO<[[UInt8]], Never>.Subscriber)
+					/// Backing one or more iterators returned by ``makeAsyncIterator()``.
+					case claimed(BroadcastFIFO<[[UInt8]], Never>.Subscriber)
+					/// Released before it was claimed.
+					case released
+				}
+				private let state:Mutex<State>
+				internal init(_ subscriber:consuming BroadcastFIFO<[[UInt8]], Never>.Subscriber) {
+					state = Mutex(.unclaimed(subscriber))
+				}
+				/// Returns the primary subscriber, claiming it on first use. A new subscriber is created if the primary subscriber was released.
+				internal borrowing func claim(from broadcast:borrowing BroadcastFIFO<[[UInt8]], Never>) -> BroadcastFIFO<[[UInt8]], Never>.Subscriber {
+					return state.withLock { state in
+						switch state {
+						case .unclaimed(let subscriber), .claimed(let subscriber):
+							state = .claimed(subscriber)
+							return subscriber
+						case .released:
+							let subscriber = broadcast.subscribe()
+							state = .claimed(subscriber)
+							return subscriber
+						}
+					}
+				}
+				/// Releases the primary subscriber and the data chunks it is holding, unless it has already been claimed.
+				internal borrowing func releaseUnclaimed() {
+					// the subscriber is moved out of the lock so that its data chunks are released after the lock is dropped.
+					let released:BroadcastFIFO<[[UInt8]], Never>.Subscriber? = state.withLock { state in
+						guard case .unclaimed(let subscriber) = state else {
+							return nil
+						}
+						state = .released
+						return subscriber
+					}
+					_ = released
+				}
+			}
 	
-			/// Yields a new data chunk into the channel’s FIFO.
+			/// Yields a new data chunk to every iterator of the channel.
 			internal borrowing func yield(_ element:consuming [[UInt8]]) {
-				fifo.yield(element)
+				broadcast.yield(element)
 			}
 	
 			/// Closes the channel, signaling no further data.
 			/// - Note: downstream consumers (e.g., parent or other) will see EOF.
 			internal borrowing func closeDataChannel() {
-				fifo.finish()
+				broadcast.finish()
 			}
 	
 			/// AsyncIterator for consuming data until the channel finishes.
 			public struct AsyncIterator:AsyncIteratorProtocol {
-				internal let fifo: FIFO<[[UInt8]], Never>.AsyncConsumerExplicit
-				internal init(_ fifo:consuming FIFO<[[UInt8]], Never>.AsyncConsumerExplicit) {
-					self.fifo = fifo
+				internal let subscriber:BroadcastFIFO<[[UInt8]], Never>.Subscriber
+				internal let cancelAction:BroadcastFIFO<[[UInt8]], Never>.Subscriber.WhenConsumingTaskCancelled
+				internal init(_ subscriber:consuming BroadcastFIFO<[[UInt8]], Never>.Subscriber, whenTaskCancelled cancelAction:BroadcastFIFO<[[UInt8]], Never>.Subscriber.WhenConsumingTaskCancelled) {
+					self.subscriber = subscriber
+					self.cancelAction = cancelAction
 				}
 				/// Returns the next chunk of data, or `nil` when the channel is closed.
 				public borrowing func next() async -> [[UInt8]]? {
-					switch await fifo.next(whenTaskCancelled:.finish) {
+					switch await subscriber.next(whenTaskCancelled:cancelAction) {
 					case .element(let element):
 						return element
 					case .capped(_):
 						return nil
 					case .wouldBlock:
-						fatalError("SwiftSlashFIFO internal error :: AsyncConsumer would block, but not expecting to be working with a limited FIFO here. this is a critical error. \(#file):\(#line)")
+						fatalError("SwiftSlashFIFO internal error :: broadcast subscriber would block, but async subscribers always wait for the next element. this is a critical error. \(#file):\(#line)")
 					}
 				}
 			}
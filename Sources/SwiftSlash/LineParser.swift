@@ -20,6 +20,8 @@ internal struct LineParser:~Copyable {
 	internal enum Output {
 		/// pass the lines into a `FIFO` for async consumption
 		case fifo(FIFO<[LineOutput], Never>)
+		/// pass the lines into a `BroadcastFIFO` for async consumption by every subscriber
+		case broadcast(BroadcastFIFO<[LineOutput], Never>)
 		/// pass the lines to a function closure
 		case handler(([LineOutput]?) -> Void)
 	}
@@ -54,6 +56,10 @@ internal struct LineParser:~Copyable {
 		self.init(separator: sepArg, initialCapacity: 4_096, output: .fifo(output))
 	}
 
+	internal init(separator sepArg:[UInt8], nasync output: BroadcastFIFO<[LineOutput], Never>) {
+		self.init(separator: sepArg, initialCapacity: 4_096, output: .broadcast(output))
+	}
+
 	internal init(separator sepArg: [UInt8], handler handlerArg: @escaping ([LineOutput]?) -> Void) {
 		self.init(separator: sepArg, initialCapacity: 4_096, output: .handler(handlerArg))
 	}
@@ -83,6 +89,8 @@ internal struct LineParser:~Copyable {
 			switch handler {
 				case .fifo(let stream):
 					stream.yield([slice])
+				case .broadcast(let stream):
+					stream.yield([slice])
 				case .handler(let h):
 					h([slice])
 			}
@@ -119,6 +127,9 @@ internal struct LineParser:~Copyable {
 				case .fifo(let stream):
 					stream.yield([final])
 					stream.finish()
+				case .broadcast(let stream):
+					stream.yield([final])
+					stream.finish()
 				case .handler(let h):
 					h([final])
 					h(nil)
@@ -129,6 +140,8 @@ internal struct LineParser:~Copyable {
 			switch handler {
 				case .fifo(let stream):
 					stream.finish()
+				case .broadcast(let stream):
+					stream.finish()
 				case .handler(let h):
 					h(nil)
 			}
@@ -192,6 +205,8 @@ internal struct LineParser:~Copyable {
 			switch handler {
 				case .fifo(let stream):
 					stream.yield(lines)
+				case .broadcast(let stream):
+					stream.yield(lines)
 				case .handler(let h):
 					h(lines)
 			}
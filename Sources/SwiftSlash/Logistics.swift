@@ -17,13 +17,9 @@ import SwiftSlashFIFO
 import SwiftSlashFuture
 import SwiftSlashGlobalSerialization
 
-internal enum WaitPIDResult {
-	case signaled(Int32)
-	case exited(Int32)
-	case failed(errno:Int32)
-}
 extension pid_t {
-	internal func waitPID() async -> WaitPIDResult {
+	/// reaps the child process with a blocking wait. the wait occupies the calling thread until the child process exits, so this is only used for child processes that the event trigger cannot watch.
+	internal func waitPID() async -> ProcessReapResult {
 		let (statusValue, errnoValue) = await withUnsafeContinuation({ (continuation:UnsafeContinuation<(Int32, Int32?), Never>) in
 			var statusCapture:Int32 = 0
 			let wpidReturn = waitpid(self, &statusCapture, 0)
@@ -34,12 +30,12 @@ extension pid_t {
 			continuation.resume(returning:(statusCapture, errnoValue))
 		})
 		guard errnoValue == nil else {
-			return WaitPIDResult.failed(errno:errnoValue!)
+			return ProcessReapResult.failed(errno:errnoValue!)
 		}
 		if __cswiftslash_eventtrigger_wifsignaled(statusValue) != 0 {
-			return WaitPIDResult.signaled(__cswiftslash_eventtrigger_wtermsig(statusValue))
+			return ProcessReapResult.signaled(__cswiftslash_eventtrigger_wtermsig(statusValue))
 		} else if __cswiftslash_eventtrigger_wifexited(statusValue) != 0 {
-			return WaitPIDResult.exited(__cswiftslash_eventtrigger_wexitstatus(statusValue))
+			return ProcessReapResult.exited(__cswiftslash_eventtrigger_wexitstatus(statusValue))
 		}
 		fatalError("SwiftSlash WaitPID error - unrecognized exit code & status combination. this is a critical and unexpected bug. \(#file):\(#line)")
 	}
@@ -101,19 +97,55 @@ internal struct ProcessLogistics {
 			internal let writeTasks:[WriteTask]
 			internal let readTasks:[ReadTask]
 			internal let launchedPID:pid_t
+			/// completed once the child process has been reaped.
+			internal let reapFuture:Future<ProcessReapResult, Never>
+			/// true if the event trigger is watching the child process and reaps it. otherwise, the child process is reaped with a blocking wait.
+			internal let reapedByEventTrigger:Bool
+			/// the event trigger shard that the child process was assigned to. held here so that the shard outlives the reaping of the child process.
+			internal let eventTrigger:EventTrigger
+
+			/// waits for the child process to exit and returns the outcome of reaping it.
+			internal func reap() async -> ProcessReapResult {
+				guard reapedByEventTrigger == true else {
+					// the event trigger could not watch the child process, so it is reaped with a blocking wait instead.
+					let reapResult = await launchedPID.waitPID()
+					try? reapFuture.setSuccess(reapResult)
+					return reapResult
+				}
+				return await reapFuture.result()!.get()
+			}
+
+			/// schedules the child process to be sent a signal at the deadline, and SIGKILL once the grace period after the deadline has passed. the signals are sent from the event trigger pthread, and are skipped for a child process that has already been reaped (its pid may belong to another process by then). where the event trigger reaps the child process, the check and the reap happen on the same pthread and cannot race.
+			/// - returns: the futures of the scheduled timers. these should be cancelled once the child process is reaped.
+			internal func scheduleTermination(at deadline:ContinuousClock.Instant, signal:Int32, grace:Duration) -> [Future<Void, Never>] {
+				var timerFutures = [Future<Void, Never>]()
+				// both timers are scheduled up front. a callback that scheduled the second timer would hold the event trigger from its own pthread.
+				for (timerDeadline, timerSignal) in [(deadline, signal), (deadline.advanced(by:grace), SIGKILL)] {
+					let timerFuture = Future<Void, Never>()
+					timerFuture.whenResult({ [pid = launchedPID, reaped = reapFuture] result in
+						guard case .success? = result, reaped.hasResult() == false else {
+							return
+						}
+						_ = kill(pid, timerSignal)
+					})
+					eventTrigger.register(timer:timerDeadline, timerFuture)
+					timerFutures.append(timerFuture)
+				}
+				return timerFutures
+			}
 			
 			internal struct WriteTask {
 				internal let terminationFuture:Future<Void, Never>
 				internal let userDataStream:DataChannel.ChildRead.ParentWrite
-				internal let writeConsumerFIFO:FIFO<Void, Never>
+				internal let writableDoorbell:Doorbell
 				internal let wFH:Int32
 				internal let eventTrigger:EventTrigger
 				internal func launch(taskGroup:inout ThrowingTaskGroup<Void, Swift.Error>) {
-					terminationFuture.whenResult({ [f = writeConsumerFIFO, uds = userDataStream.fifo] _ in
-						f.finish()
+					terminationFuture.whenResult({ [d = writableDoorbell, uds = userDataStream.fifo] _ in
+						d.finish()
 						uds.finish()
 					})
-					taskGroup.addTask { [writeConsumer = writeConsumerFIFO.makeAsyncConsumerExplicit(), et = eventTrigger] in
+					taskGroup.addTask { [writeConsumer = writableDoorbell.makeAsyncConsumer(), et = eventTrigger] in
 						defer {
 							try! et.deregister(writer:wFH)
 							try! wFH.closeFileHandle()
@@ -150,23 +182,19 @@ internal struct ProcessLogistics {
 						// main loop. if this loop is broken, it means that the termination future has been set.
 						systemEventLoopInfinite: repeat {
 							// wait for the system to indicate that the file handle is ready for writing.
-							switch await writeConsumer.next(whenTaskCancelled:.noAction) {
-								case .element(_):
-									if currentWriteStepper == nil {
-										// this is a signal that the file handle is ready for writing.
-										currentWriteStepper = await getNextWriteStep(iterator:userDataConsume)
-										guard currentWriteStepper != nil else {
-											// user is ready for this stream to be closed.
-											break systemEventLoopInfinite
-										}
-									}
-									try flushCurrentStep(&currentWriteStepper)
-								case .capped(_):
-									// this is a signal that the file handle is not ready for writing.
+							guard await writeConsumer.next(whenTaskCancelled:.noAction) != nil else {
+								// the doorbell was finished. this is a signal that the file handle is not ready for writing.
+								break systemEventLoopInfinite
+							}
+							if currentWriteStepper == nil {
+								// this is a signal that the file handle is ready for writing.
+								currentWriteStepper = await getNextWriteStep(iterator:userDataConsume)
+								guard currentWriteStepper != nil else {
+									// user is ready for this stream to be closed.
 									break systemEventLoopInfinite
-								case .wouldBlock:
-									fatalError("SwiftSlashFIFO :: unexpected wouldBlock condition in WriteTask.launch()")
+								}
 							}
+							try flushCurrentStep(&currentWriteStepper)
 						} while true
 						// data channel has been terminated. now we need to just cleanup any pending writes that the user might have stored in the FIFO. all futures found in the fifo at this point will be returned with an error instead of a successful completion or cancellation.
 						finalFlushLoop: while currentWriteStepper != nil {
@@ -187,53 +215,62 @@ internal struct ProcessLogistics {
 				internal let terminationFuture:Future<Void, Never>
 				internal let separator:[UInt8]
 				internal let userDataStream:DataChannel.ChildWrite.ParentRead
-				internal let systemReadEventsFIFO:FIFO<Int, Never>
+				internal let readableDoorbell:Doorbell
 				internal let rFH:Int32
 				internal let eventTrigger:EventTrigger
+				/// the smallest and largest number of bytes that a single read will request from the file handle.
+				fileprivate static let minimumReadSize = 256
+				fileprivate static let maximumReadSize = 65536
 				internal func launch(taskGroup:inout ThrowingTaskGroup<Void, Swift.Error>) {
-					terminationFuture.whenResult({ [f = systemReadEventsFIFO] _ in
-						f.finish()
+					terminationFuture.whenResult({ [d = readableDoorbell] _ in
+						d.finish()
 					})
 
-					taskGroup.addTask { [systemReadEvents = systemReadEventsFIFO.makeAsyncConsumer(), et = eventTrigger] in
+					taskGroup.addTask { [systemReadEvents = readableDoorbell.makeAsyncConsumer(), et = eventTrigger] in
 						// this is the line parsing mechanism that allows us to separate arbitrary data into lines of a given specifier.
-						var lineParser = LineParser(separator:separator, nasync:userDataStream.fifo)
+						var lineParser = LineParser(separator:separator, nasync:userDataStream.broadcast)
 						defer {
 							// this is the only place where action happens with the file handle,
 							try! et.deregister(reader:rFH)
 							try! rFH.closeFileHandle()
 							lineParser.finish()
 						}
-						// wait for the system to indicate that the file handle is ready for reading.
-						var largestReadSize = 256
-						readLoop: while let readableSize = await systemReadEvents.next(whenTaskCancelled:.finish) {
-							do {
-								if readableSize > largestReadSize {
-									largestReadSize = readableSize
-								}
-								// prepare the lineparser to intake the data.
-								_ = try lineParser.intake(bytes:readableSize) { wptr in
+						// the size of the next read. grows while reads keep filling the chunk and shrinks when they come back mostly empty.
+						var readSize = ReadTask.minimumReadSize
+						// reads from the handle until the system reports that it would block (or the handle reaches end of file). the handle is registered edge triggered, so no readable signal will arrive for data that is left behind.
+						func drainReadable() throws(FileHandleError) {
+							drainLoop: repeat {
+								let chunkSize = readSize
+								let readCount:Int
+								do {
 									// read the data directly from the handle to the lineparser.
-									return try rFH.readFH(into:wptr.baseAddress!, size:readableSize)
+									readCount = try lineParser.intake(bytes:chunkSize) { wptr throws(FileHandleError) in
+										return try rFH.readFH(into:wptr.baseAddress!, size:chunkSize)
+									}
+								} catch .error_wouldblock {
+									return
 								}
-							} catch FileHandleError.error_wouldblock {
-								continue readLoop
-							}
-						}
-						do {
-							// prepare the lineparser to intake the data.
-							var writtenCount:Int
-							repeat {
-								writtenCount = try lineParser.intake(bytes:largestReadSize) { wptr in
-									// read the data directly from the handle to the lineparser.
-									return try rFH.readFH(into:wptr.baseAddress!, size:largestReadSize)
+								guard readCount > 0 else {
+									// end of file.
+									return
 								}
-							} while writtenCount > 0
-						} catch FileHandleError.error_wouldblock {
-							// no action
-						} catch let error {
-							throw error
+								if readCount == chunkSize {
+									readSize = min(chunkSize * 2, ReadTask.maximumReadSize)
+								} else if readCount * 4 < chunkSize {
+									readSize = max(chunkSize / 2, ReadTask.minimumReadSize)
+								}
+							} while true
 						}
+						// wait for the system to indicate that the file handle is ready for reading.
+						readLoop: while let readableHint = await systemReadEvents.next(whenTaskCancelled:.finish) {
+							// some platforms report the number of readable bytes with the event at no extra cost. use it to size the first read.
+							if readableHint > readSize {
+								readSize = min(readableHint, ReadTask.maximumReadSize)
+							}
+							try drainReadable()
+						}
+						// the data channel has been terminated. collect anything the child wrote before its end of the pipe closed.
+						try drainReadable()
 					}
 				}
 			}
@@ -248,12 +285,28 @@ internal struct ProcessLogistics {
 		case writePipe(PosixPipe)
 	}
 
-	/// the event trigger that will be used to facilitate the IO exchange between the parent and child process.
-	@SwiftSlashGlobalSerialization fileprivate static var eventTrigger:EventTrigger? = nil
+	/// the event trigger shards that will be used to facilitate the IO exchange between the parent and child processes. created lazily on the first launch.
+	@SwiftSlashGlobalSerialization fileprivate static var eventTriggers:EventTriggerShards? = nil
+	/// the shard configuration that will be used the next time the event trigger shards are created.
+	@SwiftSlashGlobalSerialization fileprivate static var eventTriggerConfiguration:(count:Int, policy:EventTriggerShards.AssignmentPolicy, backend:EventTrigger.Backend) = (EventTriggerShards.defaultShardCount, .leastLoaded, .poll)
+
+	/// replaces the event trigger shards with a new set of the given configuration. child processes that are already running stay on the shard they were assigned, and a retired shard shuts down once its last child process is done with it.
+	@SwiftSlashGlobalSerialization internal static func configureEventTriggers(count:Int, policy:EventTriggerShards.AssignmentPolicy, backend:EventTrigger.Backend) {
+		eventTriggerConfiguration = (count, policy, backend)
+		eventTriggers = nil
+	}
+
+	/// the number of file handles registered with each event trigger shard. empty if no child process has been launched under the current configuration.
+	@SwiftSlashGlobalSerialization internal static func eventTriggerLoad() -> [Int] {
+		return eventTriggers?.load ?? []
+	}
+
 	@SwiftSlashGlobalSerialization internal static func launch(package:borrowing LaunchPackage) throws -> LaunchPackage.Launched {
-		if eventTrigger == nil {
-			eventTrigger = try EventTrigger()
+		if eventTriggers == nil {
+			eventTriggers = try EventTriggerShards(count:eventTriggerConfiguration.count, policy:eventTriggerConfiguration.policy, backend:eventTriggerConfiguration.backend)
 		}
+		// every data channel of this child process is handled by the same event trigger shard.
+		let eventTrigger = eventTriggers!.assign()
 		// pipes that will be used to facilitate io exchange with the child process.
 		var processPipes = [Int32:Pipe]()
 		var nullPipes = Set<PosixPipe>()
@@ -272,11 +325,11 @@ internal struct ProcessLogistics {
 							// the child process shall read from a file handle that blocks (as is typically the case with newly launched processes). this process (parent) will write to the file handle in a non-blocking context.
 							let newPipe = try PosixPipe.forChildReading()
 
-							// create a new FIFO that is used to signal when more data can be written. since this is only a momentary signal 
-							let writerFIFO = EventTrigger.WriterFIFO(maximumElementCount:1)
+							// create a new doorbell that is used to signal when more data can be written. writability signals that arrive before the writer task consumes them coalesce into a single pending ring.
+							let writableDoorbell = Doorbell()
 
-							// register the writer FH and FIFO with the event trigger so that it can signal when the file handle is ready for writing.
-							try eventTrigger!.register(writer:newPipe.writing, writerFIFO, finishFuture:terminationFuture)
+							// register the writer FH and doorbell with the event trigger so that it can signal when the file handle is ready for writing.
+							try eventTrigger.register(writer:newPipe.writing, writableDoorbell, finishFuture:terminationFuture)
 							
 							// this pipe needs to be further handled after the process fork so we will store it for future reference.
 							processPipes[fh] = .writePipe(newPipe)
@@ -284,9 +337,9 @@ internal struct ProcessLogistics {
 							writeTasks.append(LaunchPackage.Launched.WriteTask(
 								terminationFuture:terminationFuture,
 								userDataStream:channel,
-								writeConsumerFIFO:writerFIFO,
+								writableDoorbell:writableDoorbell,
 								wFH:newPipe.writing,
-								eventTrigger:eventTrigger!
+								eventTrigger:eventTrigger
 							))
 						case .fromNull:
 							let newPipe = try PosixPipe.createNull()
@@ -301,8 +354,8 @@ internal struct ProcessLogistics {
 							
 							// the child process shall write to a file handle that blocks (as is typically the case with newly launched processes). this process (parent) will read from the file handle in a non-blocking context.
 							let newPipe = try PosixPipe.forChildWriting()
-							let readerFIFO = EventTrigger.ReaderFIFO()
-							try eventTrigger!.register(reader:newPipe.reading, readerFIFO, finishFuture:terminationFuture)
+							let readableDoorbell = Doorbell()
+							try eventTrigger.register(reader:newPipe.reading, readableDoorbell, finishFuture:terminationFuture)
 
 							// close the writing end of the pipe after fork.
 							processPipes[fh] = .readPipe(newPipe)
@@ -311,9 +364,9 @@ internal struct ProcessLogistics {
 								terminationFuture:terminationFuture,
 								separator:sep,
 								userDataStream:channel,
-								systemReadEventsFIFO:readerFIFO,
+								readableDoorbell:readableDoorbell,
 								rFH:newPipe.reading,
-								eventTrigger:eventTrigger!
+								eventTrigger:eventTrigger
 							))
 							break;
 						case .toNull:
@@ -337,7 +390,7 @@ internal struct ProcessLogistics {
 				switch curPipe.value {
 					case .readPipe(let possibleEnabledReader):
 						if nullPipes.contains(possibleEnabledReader) == false {
-							try! eventTrigger!.deregister(reader:possibleEnabledReader.reading)
+							try! eventTrigger.deregister(reader:possibleEnabledReader.reading)
 						}
 
 						// the user configured this pipe to be "null piped" so we must close both ends of the pipe. this is a pipe that goes to /dev/null and our process has nothing to do with it.
@@ -345,7 +398,7 @@ internal struct ProcessLogistics {
 						try! possibleEnabledReader.reading.closeFileHandle()
 					case .writePipe(let possibleEnabledWriter):
 						if nullPipes.contains(possibleEnabledWriter) == false {
-							try! eventTrigger!.deregister(writer:possibleEnabledWriter.writing)
+							try! eventTrigger.deregister(writer:possibleEnabledWriter.writing)
 						}
 
 						// the user configured this pipe to be "null piped" so we must close both ends of the pipe. this is a pipe that goes to /dev/null and our process has nothing to do with it.
@@ -380,10 +433,24 @@ internal struct ProcessLogistics {
 					}
 			}
 		}
+
+		// hand the child process to its event trigger shard, which reaps it as soon as it exits. this is not possible on every system (such as linux kernels without pidfds), in which case the child process is reaped with a blocking wait.
+		let reapFuture = Future<ProcessReapResult, Never>()
+		let reapedByEventTrigger:Bool
+		do {
+			try eventTrigger.register(process:launchedPID, reapFuture)
+			reapedByEventTrigger = true
+		} catch {
+			reapedByEventTrigger = false
+		}
+
 		return LaunchPackage.Launched(
 			writeTasks:writeTasks,
 			readTasks:readTasks,
-			launchedPID:launchedPID
+			launchedPID:launchedPID,
+			reapFuture:reapFuture,
+			reapedByEventTrigger:reapedByEventTrigger,
+			eventTrigger:eventTrigger
 		)
 	}
 
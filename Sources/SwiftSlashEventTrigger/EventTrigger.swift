@@ -10,6 +10,7 @@ copyright (c) tanner silva 2025. all rights reserved.
 */
 
 import __cswiftslash_eventtrigger
+import Synchronization
 import SwiftSlashPThread
 import SwiftSlashFIFO
 import SwiftSlashFHHelpers
@@ -25,75 +26,114 @@ public final class EventTrigger:Sendable {
 	internal typealias PlatformSpecificETImplementation = MacOSEventTrigger
 	#endif
 
-	/// the type of registration that is being made to the event trigger for readers.
-	public typealias ReaderFIFO = FIFO<Int, Never>
-	/// the type of registration that is being made to the event trigger for writers.
-	public typealias WriterFIFO = FIFO<Void, Never>
+	/// the engines that an event trigger may be backed by.
+	public enum Backend:Sendable, Equatable {
+		/// the readiness interface of the platform. epoll on linux, kqueue on macos.
+		case poll
+		/// multishot polls on an io_uring instance (linux only). where the kernel does not provide io_uring or refuses it, the event trigger falls back to ``poll``. on other platforms this is the same as ``poll``.
+		case ioUring
+	}
+
+	/// the engine that is running the event trigger.
+	private let driver:any EventTriggerDriver
+	/// the backend that is actually running the event trigger. may differ from the requested backend if the request could not be honored.
+	public let backend:Backend
+	/// the stream of records that have been deregistered from the event trigger. the records are released by the pthread that is triggering the events, once it is no longer handling events that may reference them.
+	private let retireStream:FIFO<RegisterRecord, Never>
+	/// the records of the file handles that are currently registered with the event trigger. the system primitive only holds unretained pointers to these records, so they are kept alive here until they are deregistered.
+	private let records:Mutex<[Int32:RegisterRecord]> = .init([:])
 
-	/// the primitive that is used to handle the event trigger.
-	private let prim:PlatformSpecificETImplementation.EventTriggerHandlePrimitive
-	/// the running pthread that is handling the event trigger.
-	private let launchedThread:Running<PlatformSpecificETImplementation>
-	/// the stream of registrations that are being made to the event trigger. the system kernel allows for the file handle to be registered on any thread, but the corresponding FIFO must be passed to the pthread that is triggering the events
-	private let regStream:FIFO<(Int32, Register?), Never>
-	/// the type of registration that is being made to the event trigger.
-	private let cancelPipe:PosixPipe
+	/// the number of file handles that are currently registered with this event trigger. this is the load that the event trigger pthread is responsible for.
+	public var load:Int {
+		return records.withLock { $0.count }
+	}
 
 	/// initialize a new event trigger. will immediately open a new system primitive for polling, launch a pthread to handle the polling.
-	@SwiftSlashGlobalSerialization public init() throws {
-		cancelPipe = try PosixPipe()
-		regStream = FIFO()
-		let p = try PlatformSpecificETImplementation.newHandlePrimitive()
-		prim = p
-		let lt:Running<PlatformSpecificETImplementation>
+	/// - parameters:
+	///		- backend: the engine to run the event trigger on.
+	@SwiftSlashGlobalSerialization public init(backend requested:Backend = .poll) throws {
+		retireStream = FIFO()
+		#if os(Linux)
+		if requested == .ioUring, let uringDriver = try? EngineDriver<LinuxURingEventTrigger>(retiresIn:retireStream) {
+			driver = uringDriver
+			backend = .ioUring
+			return
+		}
+		#endif
+		driver = try EngineDriver<PlatformSpecificETImplementation>(retiresIn:retireStream)
+		backend = .poll
+	}
+
+	/// registers a file handle (that is intended to be read from) with the event trigger for active monitoring. the doorbell is rung each time the handle becomes readable. where the platform reports the number of readable bytes along with the event (kqueue), the ring is hinted with that number. otherwise the hint is zero.
+	@SwiftSlashGlobalSerialization public borrowing func register(reader:Int32, _ doorbell:consuming Doorbell, finishFuture:consuming Future<Void, Never>) throws(EventTriggerErrors) {
+		let record = RegisterRecord(handle:reader, register:.reader(doorbell, finishFuture))
+		records.withLock { $0[reader] = record }
 		do {
-			lt = try PlatformSpecificETImplementation.launch(EventTriggerSetup(handle:p, registersIn:regStream, cancelPipe:cancelPipe))
+			try driver.register(reader:reader, record:record.eventPointer)
 		} catch let error {
-			try PlatformSpecificETImplementation.closePrimitive(p)
+			records.withLock { _ = $0.removeValue(forKey:reader) }
 			throw error
 		}
-		launchedThread = lt
-		try PlatformSpecificETImplementation.register(p, reader:cancelPipe.reading)
 	}
 
-	/// registers a file handle (that is intended to be read from) with the event trigger for active monitoring.
-	@SwiftSlashGlobalSerialization public borrowing func register(reader:Int32, _ fifo:consuming ReaderFIFO, finishFuture:consuming Future<Void, Never>) throws(EventTriggerErrors) {
-		regStream.yield((reader, .reader(fifo, finishFuture)))
-		try PlatformSpecificETImplementation.register(prim, reader:reader)
+	/// registers a file handle (that is intended to be written to) with the event trigger for active monitoring. the doorbell is rung each time the handle becomes writable.
+	@SwiftSlashGlobalSerialization public func register(writer:Int32, _ doorbell:consuming Doorbell, finishFuture:consuming Future<Void, Never>) throws(EventTriggerErrors) {
+		let record = RegisterRecord(handle:writer, register:.writer(doorbell, finishFuture))
+		records.withLock { $0[writer] = record }
+		do {
+			try driver.register(writer:writer, record:record.eventPointer)
+		} catch let error {
+			records.withLock { _ = $0.removeValue(forKey:writer) }
+			throw error
+		}
 	}
 
-	/// registers a file handle (that is intended to be written to) with the event trigger for active monitoring.
-	@SwiftSlashGlobalSerialization public func register(writer:Int32, _ fifo:consuming WriterFIFO, finishFuture:consuming Future<Void, Never>) throws(EventTriggerErrors) {
-		regStream.yield((writer, .writer(fifo, finishFuture)))
-		try PlatformSpecificETImplementation.register(prim, writer:writer)
+	/// registers a child process with the event trigger. once the child process exits, the event trigger pthread reaps it and completes the future with the outcome, so no thread is spent waiting on the child process. the registration ends by itself once the child process is reaped.
+	/// - NOTE: the event trigger must be kept alive until the future is completed. a child process that is still registered when the event trigger deinitializes is never reaped.
+	/// - throws: ``EventTriggerErrors/processRegistrationFailure(_:_:)`` when the system cannot watch the child process (such as a linux kernel without pidfds, or a child process that has already exited on macos). the child process is left unreaped in this case.
+	@SwiftSlashGlobalSerialization public func register(process pid:pid_t, _ reapFuture:consuming Future<ProcessReapResult, Never>) throws(EventTriggerErrors) {
+		let handle = try driver.openProcess(pid)
+		let record = RegisterRecord(handle:handle, register:.process(pid, reapFuture))
+		// the registration ends without a deregistration, so the pointer holds its own reference to the record. the event trigger pthread releases it after reaping the child process.
+		let recordPointer = Unmanaged.passRetained(record).toOpaque()
+		do {
+			try driver.register(process:handle, record:recordPointer)
+		} catch let error {
+			Unmanaged<RegisterRecord>.fromOpaque(recordPointer).release()
+			driver.closeProcess(handle)
+			throw error
+		}
+	}
+
+	/// schedules a timer with the event trigger. the future is completed on the event trigger pthread once the deadline passes, and cancelling the future cancels the timer. every timer of an event trigger shares a single system timer, so timers are cheap to schedule in large numbers.
+	/// - NOTE: callbacks that are attached to the future run on the event trigger pthread. they should be brief, and must not release the last reference to this event trigger.
+	public func register(timer deadline:ContinuousClock.Instant, _ timerFuture:consuming Future<Void, Never>) {
+		driver.timers.schedule(EventTriggerTimers.monotonicDeadline(deadline), timerFuture)
 	}
 
 	/// deregisters a file handle. the reader must be of reader variant. if the handle is not of reader variant, behavior is undefined.
 	public borrowing func deregister(reader:Int32) throws {
-		try PlatformSpecificETImplementation.deregister(prim, reader:reader)
-		regStream.yield((reader, nil))
+		try driver.deregister(reader:reader)
+		retire(reader)
 	}
 
 	/// deregisters a file handle. the handle must be of writer variant. if the handle is not of writer variant, behavior is undefined.
 	public borrowing func deregister(writer:Int32) throws {
-		try PlatformSpecificETImplementation.deregister(prim, writer:writer)
-		regStream.yield((writer, nil))
+		try driver.deregister(writer:writer)
+		retire(writer)
+	}
+
+	/// hands the record of a deregistered file handle to the event trigger pthread. events for the handle may still be in flight on the pthread, so the record cannot be released here.
+	private borrowing func retire(_ handle:Int32) {
+		guard let record = records.withLock({ $0.removeValue(forKey:handle) }) else {
+			fatalError("SwiftSlashEventTrigger: attempted to deregister a file handle that is not registered. \(#file):\(#line)")
+		}
+		retireStream.yield(record)
+		// wake the pthread so that the record is released without waiting on unrelated events.
+		driver.wake()
 	}
 
 	deinit {
-		// cancel the thread since it will still be running at this point
-		try! launchedThread.cancel()
-		// signal to the polling infrastructure to unblock
-		_ = try! cancelPipe.writing.writeFH(singleByte:0x0)
-		// join the pthread
-		try! launchedThread.joinSync()
-		// deregister the cancel pipe from the event trigger
-		try! PlatformSpecificETImplementation.deregister(prim, reader:cancelPipe.reading)
-		// close the polling primitive
-		try! PlatformSpecificETImplementation.closePrimitive(prim)
-		// cancel pipe has served its purpose so we can close it
-		try! cancelPipe.writing.closeFileHandle()
-		// close the writing end of the close pipe
-		try! cancelPipe.reading.closeFileHandle()
+		driver.shutdown()
 	}
-}
+}
\ No newline at end of file
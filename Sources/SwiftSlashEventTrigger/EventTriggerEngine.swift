@@ -9,18 +9,20 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 */
 
+import __cswiftslash_eventtrigger
 import SwiftSlashPThread
+import SwiftSlashFIFO
 import SwiftSlashFHHelpers
 import SwiftSlashGlobalSerialization
 
 /// event trigger is an abstract term for a given platforms low-level event handling mechanism. this protocol is used to define the interface for the event trigger of each platform.
-internal protocol EventTriggerEngine:PThreadWork where ArgumentType == EventTriggerSetup<EventTriggerHandlePrimitive>, ReturnType == Void, EventTriggerHandlePrimitive == Int32 {
+internal protocol EventTriggerEngine:PThreadWork where ArgumentType == EventTriggerSetup<EventTriggerHandlePrimitive>, ReturnType == Void {
 	
-	/// registers a file handle (that is intended to be read from) with the event trigger for active monitoring.
-	@SwiftSlashGlobalSerialization static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors)
+	/// registers a file handle (that is intended to be read from) with the event trigger for active monitoring. the record pointer is delivered with each event for the handle.
+	@SwiftSlashGlobalSerialization static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
 
-	/// registers a file handle (that is intended to be written to) with the event trigger for active monitoring.
-	@SwiftSlashGlobalSerialization static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32) throws(EventTriggerErrors)
+	/// registers a file handle (that is intended to be written to) with the event trigger for active monitoring. the record pointer is delivered with each event for the handle.
+	@SwiftSlashGlobalSerialization static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
 
 	/// deregisters a file handle. the reader must be of reader variant. if the handle is not of reader variant, behavior is undefined.
 	static func deregister(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors)
@@ -28,8 +30,38 @@ internal protocol EventTriggerEngine:PThreadWork where ArgumentType == EventTrig
 	/// deregisters a file handle. the handle must be of writer variant. if the handle is not of writer variant, behavior is undefined.
 	static func deregister(_ ev:EventTriggerHandlePrimitive, writer:Int32) throws(EventTriggerErrors)
 	
+	/// opens the handle that a child process is registered under. on linux this is a pidfd, on macos the pid itself.
+	static func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32
+
+	/// registers a child process with the event trigger. the record pointer is delivered with a single event once the child process exits, after which the registration is over.
+	@SwiftSlashGlobalSerialization static func register(_ ev:EventTriggerHandlePrimitive, process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
+
+	/// releases the handle that a child process was registered under. the handle must no longer be registered with the primitive.
+	static func closeProcess(_ process:Int32)
+
+	/// creates the system timer of the event trigger. the system timer is not armed.
+	static func openTimer() throws(EventTriggerErrors) -> Int32
+
+	/// registers the system timer with the event trigger. the record pointer is delivered with each expiration of the system timer.
+	static func register(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
+
+	/// arms the system timer to expire once at the given deadline (on the monotonic clock, in nanoseconds), replacing any deadline it was armed for. may be called from any thread.
+	static func armTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer, deadline:UInt64)
+
+	/// deregisters the system timer and releases any resources that it holds.
+	static func closeTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32)
+
+	/// creates the wakeup handle of the event trigger and registers it with the primitive. signaling the wakeup handle unblocks the pthread that is waiting on the primitive. wakeup events are delivered without a record pointer.
+	static func registerWakeup(_ ev:EventTriggerHandlePrimitive) throws(EventTriggerErrors) -> Int32
+
+	/// signals the wakeup handle of the event trigger.
+	static func wake(_ ev:EventTriggerHandlePrimitive, wakeup:Int32)
+
+	/// deregisters the wakeup handle of the event trigger and releases any resources that it holds.
+	static func deregisterWakeup(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) throws(EventTriggerErrors)
+
 	/// the type of primitive that this particular event trigger uses.
-	associatedtype EventTriggerHandlePrimitive
+	associatedtype EventTriggerHandlePrimitive:Sendable
 
 	/// the primitive that is used to handle the event trigger.
 	var prim:EventTriggerHandlePrimitive { get }
@@ -39,4 +71,148 @@ internal protocol EventTriggerEngine:PThreadWork where ArgumentType == EventTrig
 
 	/// closes the primitive for the event trigger.
 	static func closePrimitive(_ prim:consuming EventTriggerHandlePrimitive) throws(FileHandleError)
+}
+
+/// a running event trigger engine, with the type of the engine erased. this allows an event trigger to run whichever of the platform engines was selected at initialization.
+internal protocol EventTriggerDriver:Sendable {
+	/// registers a file handle (that is intended to be read from) with the running engine.
+	@SwiftSlashGlobalSerialization func register(reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
+
+	/// registers a file handle (that is intended to be written to) with the running engine.
+	@SwiftSlashGlobalSerialization func register(writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
+
+	/// opens the handle that a child process is registered under.
+	func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32
+
+	/// registers a child process with the running engine.
+	@SwiftSlashGlobalSerialization func register(process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors)
+
+	/// releases the handle that a child process was registered under.
+	func closeProcess(_ process:Int32)
+
+	/// deregisters a file handle of the reader variant from the running engine.
+	func deregister(reader:Int32) throws(EventTriggerErrors)
+
+	/// deregisters a file handle of the writer variant from the running engine.
+	func deregister(writer:Int32) throws(EventTriggerErrors)
+
+	/// the timers of the running engine.
+	var timers:EventTriggerTimers { get }
+
+	/// wakes the pthread of the running engine.
+	func wake()
+
+	/// cancels and joins the pthread of the running engine, then releases the primitive.
+	func shutdown()
+}
+
+/// runs a given engine on a dedicated pthread.
+internal final class EngineDriver<E:EventTriggerEngine>:EventTriggerDriver {
+	/// the primitive of the engine.
+	private let prim:E.EventTriggerHandlePrimitive
+	/// the wakeup handle that is registered with the primitive.
+	private let wakeup:Int32
+	/// the system timer that is registered with the primitive, and the record that it is registered with.
+	private let timer:Int32
+	private let timerRecord:RegisterRecord
+	/// the timers that share the system timer.
+	internal let timers:EventTriggerTimers
+	/// the pthread that is running the engine.
+	private let launchedThread:Running<E>
+
+	/// opens a new primitive for the engine and launches the engine on a new pthread.
+	/// - parameters:
+	///		- retireStream: the stream that deregistered records are passed through to reach the engine.
+	@SwiftSlashGlobalSerialization internal init(retiresIn retireStream:FIFO<RegisterRecord, Never>) throws {
+		let p = try E.newHandlePrimitive()
+		let w:Int32
+		do {
+			w = try E.registerWakeup(p)
+		} catch let error {
+			try E.closePrimitive(p)
+			throw error
+		}
+		let t:Int32
+		let tq = EventTriggerTimers()
+		let tr:RegisterRecord
+		do {
+			t = try E.openTimer()
+			tr = RegisterRecord(handle:t, register:.timer(tq))
+			do {
+				try E.register(p, timer:t, record:tr.eventPointer)
+			} catch let error {
+				E.closeTimer(p, timer:t)
+				throw error
+			}
+		} catch let error {
+			try E.deregisterWakeup(p, wakeup:w)
+			try E.closePrimitive(p)
+			throw error
+		}
+		// the timer record is held by this driver for as long as the primitive is open, so the arming function refers to it by address rather than retaining it (which would also make a cycle through the timers).
+		tq.attach(arm:{ [p, t, timerAddress = UInt(bitPattern:tr.eventPointer)] deadline in
+			E.armTimer(p, timer:t, record:UnsafeMutableRawPointer(bitPattern:timerAddress)!, deadline:deadline)
+		})
+		let lt:Running<E>
+		do {
+			lt = try E.launchDedicated(EventTriggerSetup(handle:p, retiresIn:retireStream, wakeup:w), options:PThreadLaunchOptions(name:"swiftslash-et"))
+		} catch let error {
+			E.closeTimer(p, timer:t)
+			try E.deregisterWakeup(p, wakeup:w)
+			try E.closePrimitive(p)
+			throw error
+		}
+		prim = p
+		wakeup = w
+		timer = t
+		timerRecord = tr
+		timers = tq
+		launchedThread = lt
+	}
+
+	@SwiftSlashGlobalSerialization internal func register(reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		try E.register(prim, reader:reader, record:record)
+	}
+
+	@SwiftSlashGlobalSerialization internal func register(writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		try E.register(prim, writer:writer, record:record)
+	}
+
+	internal func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32 {
+		return try E.openProcess(pid)
+	}
+
+	@SwiftSlashGlobalSerialization internal func register(process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		try E.register(prim, process:process, record:record)
+	}
+
+	internal func closeProcess(_ process:Int32) {
+		E.closeProcess(process)
+	}
+
+	internal func deregister(reader:Int32) throws(EventTriggerErrors) {
+		try E.deregister(prim, reader:reader)
+	}
+
+	internal func deregister(writer:Int32) throws(EventTriggerErrors) {
+		try E.deregister(prim, writer:writer)
+	}
+
+	internal func wake() {
+		E.wake(prim, wakeup:wakeup)
+	}
+
+	internal func shutdown() {
+		// cancel the thread since it will still be running at this point
+		try! launchedThread.cancel()
+		// signal to the polling infrastructure to unblock
+		E.wake(prim, wakeup:wakeup)
+		// join the pthread
+		try! launchedThread.joinSync()
+		// deregister the system timer and the wakeup handle from the event trigger
+		E.closeTimer(prim, timer:timer)
+		try! E.deregisterWakeup(prim, wakeup:wakeup)
+		// close the polling primitive
+		try! E.closePrimitive(prim)
+	}
 }
\ No newline at end of file
@@ -23,4 +23,13 @@ public enum EventTriggerErrors:Swift.Error {
 
 	/// thrown when a given file handle (for writing) is not able to deregister with an event trigger. this is considered an internal error that should never be thrown under any circumstances
 	case writerDeregistrationFailure(Int32, Int32)
+
+	/// thrown when the wakeup handle of an event trigger cannot be created or registered. the associated value is the system error number.
+	case wakeupRegistrationFailure(Int32)
+
+	/// thrown when a child process cannot be registered with an event trigger. the associated values are the pid (or the pidfd on linux) of the child process and the system error number. callers may fall back to reaping the child process with a blocking wait.
+	case processRegistrationFailure(Int32, Int32)
+
+	/// thrown when the system timer of an event trigger cannot be created or registered. the associated value is the system error number.
+	case timerRegistrationFailure(Int32)
 }
\ No newline at end of file
@@ -10,15 +10,90 @@ copyright (c) tanner silva 2025. all rights reserved.
 */
 
 import __cswiftslash_eventtrigger
+import __cswiftslash_posix_helpers
 import SwiftSlashFIFO
 import SwiftSlashFuture
 
+/// the outcome of reaping a child process.
+public enum ProcessReapResult:Sendable {
+	/// the child process was ended by the given signal.
+	case signaled(Int32)
+	/// the child process exited with the given exit code.
+	case exited(Int32)
+	/// the child process could not be waited on. the associated value is the system error number.
+	case failed(errno:Int32)
+}
+
 internal enum Register {
 
 	/// register a parent process reader.
-	case reader(FIFO<Int, Never>, Future<Void, Never>)
+	case reader(Doorbell, Future<Void, Never>)
 
 
 	/// register a parent process writer.
-	case writer(FIFO<Void, Never>, Future<Void, Never>)
+	case writer(Doorbell, Future<Void, Never>)
+
+	/// register a child process. the future is completed once the child process has exited and been reaped.
+	case process(pid_t, Future<ProcessReapResult, Never>)
+
+	/// register the system timer of the event trigger. every timer of the event trigger fires from this single registration.
+	case timer(EventTriggerTimers)
+}
+
+/// a registration that is referenced directly by the system polling primitive. the event trigger pthread receives a pointer to this record with each event, so no lookup is needed to find the registration for an event.
+/// 	- NOTE: the record must outlive every event that may still reference it. after a file handle is removed from the polling primitive, its record is handed to the event trigger pthread, which releases it after finishing the batch of events it is working on.
+internal final class RegisterRecord:@unchecked Sendable {
+	/// the file handle that this record was registered for.
+	internal let handle:Int32
+	/// the registration for the file handle.
+	internal let register:Register
+
+	internal init(handle:Int32, register:Register) {
+		self.handle = handle
+		self.register = register
+	}
+
+	/// the pointer that is stored alongside the file handle in the system polling primitive. this pointer does not retain the record.
+	internal var eventPointer:UnsafeMutableRawPointer {
+		return Unmanaged.passUnretained(self).toOpaque()
+	}
+
+	/// recover the record from a pointer that was stored in the system polling primitive.
+	internal static func fromEventPointer(_ pointer:UnsafeMutableRawPointer) -> RegisterRecord {
+		return Unmanaged<RegisterRecord>.fromOpaque(pointer).takeUnretainedValue()
+	}
+}
+
+extension RegisterRecord {
+	/// reaps the child process of a process registration and completes its future with the outcome. the record handle is passed as the pidfd on linux. the event trigger pthread calls this once the system reports that the child process has exited.
+	/// - parameters:
+	/// 	- blocking: when true, waits for the child process to become waitable. when false, the reap does not block.
+	/// - returns: true if the future was completed. false if the child process was not yet waitable, in which case the registration must be armed again so that the event trigger pthread is not held in a wait.
+	internal func reapProcess(blocking:Bool) -> Bool {
+		guard case .process(let pid, let future) = register else {
+			fatalError("eventtrigger error - attempted to reap a registration that is not a child process. \(#file):\(#line)")
+		}
+		#if os(Linux)
+		let pidfd = handle
+		#else
+		let pidfd:Int32 = -1
+		#endif
+		var code:Int32 = 0
+		var signaled = false
+		let reapResult = __cswiftslash_eventtrigger_reap(pid, pidfd, blocking, &code, &signaled)
+		if reapResult == 0 {
+			// the exit was reported before the child process became waitable.
+			return false
+		}
+		guard reapResult == 1 else {
+			try? future.setSuccess(.failed(errno:__cswiftslash_get_errno()))
+			return true
+		}
+		if signaled == true {
+			try? future.setSuccess(.signaled(code))
+		} else {
+			try? future.setSuccess(.exited(code))
+		}
+		return true
+	}
 }
\ No newline at end of file
@@ -16,8 +16,8 @@ import SwiftSlashFHHelpers
 public struct EventTriggerSetup<HP>:Sendable where HP:Sendable {
 	// the primitive handle type that is used to handle the event trigger.
 	internal let handle:HP
-	// the FIFO that is used to pass registrations to the event trigger to the pthread that is handling the event trigger.
-	internal let registersIn:FIFO<(Int32, Register?), Never>
-	// the cancellation pipe that is registered with the event trigger to assist in shutting down the event trigger when it needs to be cancelled.
-	internal let cancelPipe:PosixPipe
+	// the FIFO that is used to pass deregistered records to the pthread that is handling the event trigger, so that they may be released once no pending event can reference them.
+	internal let retiresIn:FIFO<RegisterRecord, Never>
+	// the wakeup handle that is registered with the event trigger. it is signaled to unblock the pthread that is handling the event trigger, both when records are retired and when the event trigger needs to be cancelled.
+	internal let wakeup:Int32
 }
@@ -0,0 +1,84 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import __cswiftslash_posix_helpers
+import Synchronization
+import SwiftSlashGlobalSerialization
+
+/// a fixed set of independent event triggers, each with its own system polling primitive and pthread. file handles are not spread across the shards individually - a caller is assigned a single shard and registers all of its related handles there, so that a shard can be torn down in isolation.
+public final class EventTriggerShards:Sendable {
+
+	/// the policy used to pick a shard for a new assignment.
+	public enum AssignmentPolicy:Sendable {
+		/// each assignment takes the next shard in turn.
+		case roundRobin
+		/// each assignment takes the shard with the fewest registered file handles. ties are broken in turn.
+		case leastLoaded
+	}
+
+	/// the default number of shards. one shard per online cpu, with no more than four shards in total.
+	public static var defaultShardCount:Int {
+		let onlineCPUs = sysconf(Int32(_SC_NPROCESSORS_ONLN))
+		guard onlineCPUs > 0 else {
+			return 1
+		}
+		return min(Int(onlineCPUs), 4)
+	}
+
+	/// the event triggers that make up this shard set.
+	public let shards:[EventTrigger]
+	/// the policy that is used to assign shards.
+	public let policy:AssignmentPolicy
+	/// the position of the next shard to consider.
+	private let nextShard:Atomic<Int> = .init(0)
+
+	/// initialize a new set of event trigger shards. each shard immediately opens its own system primitive for polling and launches its own pthread.
+	/// - parameters:
+	///		- count: the number of shards to launch. values less than one are treated as one.
+	///		- policy: the policy used to assign shards.
+	///		- backend: the engine that each shard runs on.
+	@SwiftSlashGlobalSerialization public init(count:Int = EventTriggerShards.defaultShardCount, policy:AssignmentPolicy = .leastLoaded, backend:EventTrigger.Backend = .poll) throws {
+		var buildShards = [EventTrigger]()
+		buildShards.reserveCapacity(max(count, 1))
+		for _ in 0..<max(count, 1) {
+			buildShards.append(try EventTrigger(backend:backend))
+		}
+		shards = buildShards
+		self.policy = policy
+	}
+
+	/// assigns a shard according to the assignment policy. the caller should register all of its related file handles with the returned event trigger.
+	public func assign() -> EventTrigger {
+		let start = nextShard.wrappingAdd(1, ordering:.relaxed).oldValue
+		switch policy {
+			case .roundRobin:
+				return shards[Int(UInt(bitPattern:start) % UInt(shards.count))]
+			case .leastLoaded:
+				let first = Int(UInt(bitPattern:start) % UInt(shards.count))
+				var best = first
+				var bestLoad = shards[best].load
+				for i in 1..<shards.count {
+					let candidate = (first + i) % shards.count
+					let candidateLoad = shards[candidate].load
+					if candidateLoad < bestLoad {
+						best = candidate
+						bestLoad = candidateLoad
+					}
+				}
+				return shards[best]
+		}
+	}
+
+	/// the number of file handles currently registered with each shard, in shard order.
+	public var load:[Int] {
+		return shards.map { $0.load }
+	}
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import __cswiftslash_timer
+import Synchronization
+import SwiftSlashFuture
+
+/// the timers of an event trigger. every timer of an event trigger shares a single system timer, which is kept armed for the earliest pending deadline. timers are held in a binary min-heap ordered by deadline.
+internal final class EventTriggerTimers:Sendable {
+	/// a single pending timer.
+	private struct Entry {
+		/// the deadline of the timer on the monotonic clock, in nanoseconds.
+		internal let deadline:UInt64
+		/// the future that is completed once the deadline passes. a cancelled future cancels the timer.
+		internal let future:Future<Void, Never>
+	}
+
+	private struct State {
+		/// the pending timers, ordered as a binary min-heap by deadline.
+		internal var heap:[Entry] = []
+		/// the heap size at which cancelled timers are compacted out of the heap on the next schedule.
+		internal var compactAt:Int = EventTriggerTimers.compactMinimum
+		/// arms the system timer for a given deadline. attached by the engine driver once the system timer is registered.
+		internal var arm:(@Sendable (UInt64) -> Void)? = nil
+	}
+	private let state:Mutex<State> = .init(State())
+
+	/// the smallest heap size that is compacted. below this, cancelled timers are left for fire to drop.
+	private static let compactMinimum = 64
+
+	internal init() {}
+
+	/// attaches the function that arms the system timer. must be called before any timer is scheduled.
+	internal func attach(arm:@escaping @Sendable (UInt64) -> Void) {
+		state.withLock { $0.arm = arm }
+	}
+
+	/// the current time of the monotonic clock that deadlines are measured against, in nanoseconds.
+	internal static func now() -> UInt64 {
+		return __cswiftslash_timer_now()
+	}
+
+	/// converts a deadline of the continuous clock to a deadline of the monotonic clock. deadlines in the past convert to the current time, and deadlines that are centuries away never pass.
+	internal static func monotonicDeadline(_ deadline:ContinuousClock.Instant) -> UInt64 {
+		let (seconds, attoseconds) = ContinuousClock.now.duration(to:deadline).components
+		return __cswiftslash_timer_deadline(seconds, attoseconds)
+	}
+
+	/// schedules a timer. the system timer is armed again if this is the earliest pending deadline.
+	internal func schedule(_ deadline:UInt64, _ future:Future<Void, Never>) {
+		state.withLock { currentState in
+			if currentState.heap.count >= currentState.compactAt {
+				EventTriggerTimers.compact(&currentState.heap)
+				currentState.compactAt = max(EventTriggerTimers.compactMinimum, currentState.heap.count * 2)
+			}
+			currentState.heap.append(Entry(deadline:deadline, future:future))
+			// sift the new entry up to its place in the heap.
+			var i = currentState.heap.count - 1
+			while i > 0 {
+				let parent = (i - 1) / 2
+				guard currentState.heap[i].deadline < currentState.heap[parent].deadline else {
+					break
+				}
+				currentState.heap.swapAt(i, parent)
+				i = parent
+			}
+			if i == 0 {
+				// arming is done under the lock so that a concurrent fire cannot arm the system timer for a later deadline over this one.
+				guard let arm = currentState.arm else {
+					fatalError("eventtrigger error - a timer was scheduled before the system timer was attached. \(#file):\(#line)")
+				}
+				arm(deadline)
+			}
+		}
+	}
+
+	/// the number of timers in the heap, including cancelled timers that have not been dropped yet.
+	internal var count:Int {
+		return state.withLock { $0.heap.count }
+	}
+
+	/// drops the cancelled timers out of the heap and restores the heap order of the remaining timers. the cost of this pass is spread across the schedules that grew the heap to twice its size after the previous pass.
+	private static func compact(_ heap:inout [Entry]) {
+		heap.removeAll(where:{ $0.future.hasResult() == true })
+		var i = (heap.count / 2) - 1
+		while i >= 0 {
+			siftDown(&heap, from:i)
+			i -= 1
+		}
+	}
+
+	/// takes the earliest entry out of the heap.
+	private static func popFirst(_ heap:inout [Entry]) -> Entry {
+		let first = heap[0]
+		let last = heap.removeLast()
+		guard heap.isEmpty == false else {
+			return first
+		}
+		heap[0] = last
+		siftDown(&heap, from:0)
+		return first
+	}
+
+	/// sifts the entry at a given index down to its place in the heap.
+	private static func siftDown(_ heap:inout [Entry], from start:Int) {
+		var i = start
+		repeat {
+			let left = (i * 2) + 1
+			let right = left + 1
+			var smallest = i
+			if left < heap.count && heap[left].deadline < heap[smallest].deadline {
+				smallest = left
+			}
+			if right < heap.count && heap[right].deadline < heap[smallest].deadline {
+				smallest = right
+			}
+			guard smallest != i else {
+				return
+			}
+			heap.swapAt(i, smallest)
+			i = smallest
+		} while true
+	}
+
+	/// completes the future of every timer whose deadline has passed, then arms the system timer for the next pending deadline. called by the event trigger pthread when the system timer expires. the futures are completed on the calling pthread, so anything that waits on them directly should be brief.
+	internal func fire() {
+		let dueNow = EventTriggerTimers.now()
+		let expired = state.withLock { currentState -> [Future<Void, Never>] in
+			var expired = [Future<Void, Never>]()
+			while let first = currentState.heap.first, first.deadline <= dueNow {
+				let entry = EventTriggerTimers.popFirst(&currentState.heap)
+				// cancelled timers are dropped here, or compacted out of the heap once enough of them build up.
+				if entry.future.hasResult() == false {
+					expired.append(entry.future)
+				}
+			}
+			if let next = currentState.heap.first {
+				currentState.arm!(next.deadline)
+			}
+			return expired
+		}
+		for future in expired {
+			try? future.setSuccess(())
+		}
+	}
+}
\ No newline at end of file
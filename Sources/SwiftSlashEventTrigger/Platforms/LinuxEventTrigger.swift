@@ -20,7 +20,7 @@ import SwiftSlashFuture
 import SwiftSlashGlobalSerialization
 
 /// the primary event trigger implementation for linux.
-/// 	- NOTE: this class is marked with `unchecked Sendable` because it has mutable storage for `activeTriggers`. As required by the Swift runtime, the access to this mutable storage is perfectly isolated and managed to only a single thread.
+/// 	- NOTE: this class is marked with `unchecked Sendable` because it has mutable storage for its event buffer. As required by the Swift runtime, the access to this mutable storage is perfectly isolated and managed to only a single thread.
 internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 	internal typealias ArgumentType = EventTriggerSetup<EventTriggerHandle>
 	internal typealias ReturnType = Void
@@ -30,30 +30,20 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 	/// the event trigger primitive
 	internal let prim:EventTriggerHandlePrimitive
 
-	// the pipe that is used to cancel the event trigger.
-	internal let cancelPipe:PosixPipe
+	/// the eventfd that is signaled to wake this pthread.
+	internal let wakeup:Int32
 
-	/// the file handle registrations that are currently active.
-	private var activeTriggers:[Int32:Register] = [:]
-	
-	/// the registrations that are pending.
-	private let registrations:FIFO<(Int32, Register?), Never>
-	private borrowing func extractPendingRegistrations() {
-		let getIterator = registrations.makeSyncConsumerNonBlocking()
-		infiniteLoop: repeat {
-			switch getIterator.next() {
-				case .some(let (handle, register)):
-					activeTriggers[handle] = register
-				case .none:
-					break infiniteLoop
-			}
-		} while true
+	/// the records that have been deregistered and are waiting to be released.
+	private let retirements:FIFO<RegisterRecord, Never>
+	private borrowing func releaseRetiredRecords() {
+		// the records are released as the drained batch goes out of scope.
+		_ = retirements.makeSyncConsumerNonBlocking().drain()
 	}
 	
 	internal init(_ ptSetup:consuming ArgumentType) {
-		registrations = ptSetup.registersIn
+		retirements = ptSetup.retiresIn
 		prim = ptSetup.handle
-		cancelPipe = ptSetup.cancelPipe
+		wakeup = ptSetup.wakeup
 	}
 
 	/// event buffer that allows us to process events. this buffer is passed directly to the system call and is the first place returned events are stored.
@@ -87,24 +77,51 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 				
 				// any zero or positive value is considered a normal condition.
 				case 0..<Int32.max:
-				
-					// acquire any w/r fifo's that were passed into the registration queue while this thread was blocked.
-					extractPendingRegistrations()
 					
-					// process the events against the stored fifo's.
+					// process the events against the records they carry.
 					resultLoop: for i in 0..<Int(epollResult) {
 
-						// capture the relevant two points for this iteration: file handle and the flags triggered for said handle.
+						// capture the relevant two points for this iteration: the registration record and the flags triggered for its handle.
 						let currentEvent = eventBuffer[i]
 						let eventFlags = currentEvent.events
-						guard currentEvent.data.fd != cancelPipe.reading else {
-							// cancel pipe was triggered, we need to exit the loop.
+						guard let eventPointer = currentEvent.data.ptr else {
+							// the wakeup eventfd was signaled (it is the only handle registered without a record). reset its counter. retired records are released and cancellation is checked after this batch.
+							var wakeCount:eventfd_t = 0
+							_ = eventfd_read(wakeup, &wakeCount)
+							continue resultLoop
+						}
+						let record = RegisterRecord.fromEventPointer(eventPointer)
+						if case .process(_, _) = record.register {
+							// the child process exited.
+							guard record.reapProcess(blocking:false) == true else {
+								// the child process is not waitable yet. the pidfd is armed again rather than waiting on it here.
+								var buildEvent = epoll_event()
+								buildEvent.data.ptr = eventPointer
+								buildEvent.events = UInt32(EPOLLIN.rawValue) | UInt32(EPOLLONESHOT.rawValue)
+								guard epoll_ctl(prim, EPOLL_CTL_MOD, record.handle, &buildEvent) == 0 else {
+									fatalError("epoll error - unable to rearm a pidfd. this should never happen. \(#file):\(#line)")
+								}
+								continue resultLoop
+							}
+							// the registration ends here, so the pidfd is removed from the primitive before it is closed.
+							var buildEvent = epoll_event()
+							guard epoll_ctl(prim, EPOLL_CTL_DEL, record.handle, &buildEvent) == 0 else {
+								fatalError("epoll error - unable to remove a pidfd. this should never happen. \(#file):\(#line)")
+							}
+							LinuxEventTrigger.closeProcess(record.handle)
+							// release the reference that the registration held.
+							Unmanaged<RegisterRecord>.fromOpaque(eventPointer).release()
+							continue resultLoop
+						}
+						if case .timer(let timers) = record.register {
+							// the timerfd expired. it is cleared before the timers fire, since firing arms it again for the next deadline.
+							__cswiftslash_eventtrigger_timerfd_clear(record.handle)
+							timers.fire()
 							continue resultLoop
 						}
 						if eventFlags & UInt32(EPOLLHUP.rawValue) != 0 {
 							// reading handle closed
-							// let removedValue = activeTriggers.removeValue(forKey:currentEvent.data.fd)!
-							switch activeTriggers[currentEvent.data.fd]! {
+							switch record.register {
 								case .reader(_, let future):
 									try? future.setSuccess(())
 								default:
@@ -114,8 +131,7 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 						} else if eventFlags & UInt32(EPOLLERR.rawValue) != 0 {
 
 							// writing handle closed
-							// let removedValue = activeTriggers.removeValue(forKey:currentEvent.data.fd)!
-							switch activeTriggers[currentEvent.data.fd]! {
+							switch record.register {
 								case .writer(_, let future):
 									try? future.setSuccess(())
 								default:
@@ -124,14 +140,10 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 
 						} else if eventFlags & UInt32(EPOLLIN.rawValue) != 0 {
 							
-							// read data available
-							var byteCount:Int32 = 0
-							guard __cswiftslash_fcntl_fionread(currentEvent.data.fd, &byteCount) == 0 else {
-								fatalError("fcntl error - this should never happen :: \(#file):\(#line)")
-							}
-							switch activeTriggers[currentEvent.data.fd]! {
-								case .reader(let fifo, _):
-									fifo.yield(Int(byteCount))
+							// read data available. the reader drains the handle itself, so no size hint is gathered here.
+							switch record.register {
+								case .reader(let doorbell, _):
+									doorbell.ring()
 								default:
 									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 							}
@@ -139,9 +151,9 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 						} else if eventFlags & UInt32(EPOLLOUT.rawValue) != 0 {
 							
 							// write data available
-							switch activeTriggers[currentEvent.data.fd]! {
-								case .writer(let fifo, _):
-									fifo.yield(())
+							switch record.register {
+								case .writer(let doorbell, _):
+									doorbell.ring()
 								default:
 									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 							}
@@ -149,6 +161,9 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 						}
 					}
 
+					// none of the events in the buffer are referenced past this point, so records that were deregistered up to now can be released.
+					releaseRetiredRecords()
+
 					// reallocate the event buffer if the event is getting too large.
 					if epollResult*2 > eventBufferSize {
 						reallocate(size:eventBufferSize*2)
@@ -178,24 +193,109 @@ internal final class LinuxEventTrigger:EventTriggerEngine, @unchecked Sendable {
 }
 
 extension LinuxEventTrigger {
-	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors) {
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
 		var newEvent = epoll_event()
-		newEvent.data.fd = reader
+		newEvent.data.ptr = record
 		newEvent.events = UInt32(EPOLLIN.rawValue) | UInt32(EPOLLERR.rawValue) | UInt32(EPOLLHUP.rawValue) | UInt32(EPOLLET.rawValue)
 		guard epoll_ctl(ev, EPOLL_CTL_ADD, reader, &newEvent) == 0 else {
 			throw EventTriggerErrors.readerRegistrationFailure(reader, __cswiftslash_get_errno())
 		}
 	}
 
-	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32) throws(EventTriggerErrors) {
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
 		var newEvent = epoll_event()
-		newEvent.data.fd = writer
+		newEvent.data.ptr = record
 		newEvent.events = UInt32(EPOLLOUT.rawValue) | UInt32(EPOLLERR.rawValue) | UInt32(EPOLLHUP.rawValue) | UInt32(EPOLLET.rawValue)
 		guard epoll_ctl(ev, EPOLL_CTL_ADD, writer, &newEvent) == 0 else {
 			throw EventTriggerErrors.writerRegistrationFailure(writer, __cswiftslash_get_errno())
 		}
 	}
 
+	internal static func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32 {
+		let pidfd = __cswiftslash_eventtrigger_pidfd_open(pid)
+		guard pidfd != -1 else {
+			throw EventTriggerErrors.processRegistrationFailure(pid, __cswiftslash_get_errno())
+		}
+		return pidfd
+	}
+
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		// a pidfd becomes readable when its child process exits, and stays readable until the pidfd is closed. the event is taken once.
+		var newEvent = epoll_event()
+		newEvent.data.ptr = record
+		newEvent.events = UInt32(EPOLLIN.rawValue) | UInt32(EPOLLONESHOT.rawValue)
+		guard epoll_ctl(ev, EPOLL_CTL_ADD, process, &newEvent) == 0 else {
+			throw EventTriggerErrors.processRegistrationFailure(process, __cswiftslash_get_errno())
+		}
+	}
+
+	internal static func closeProcess(_ process:Int32) {
+		try? process.closeFileHandle()
+	}
+
+	internal static func openTimer() throws(EventTriggerErrors) -> Int32 {
+		let timer = __cswiftslash_eventtrigger_timerfd_open()
+		guard timer != -1 else {
+			throw EventTriggerErrors.timerRegistrationFailure(__cswiftslash_get_errno())
+		}
+		return timer
+	}
+
+	internal static func register(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		var newEvent = epoll_event()
+		newEvent.data.ptr = record
+		newEvent.events = UInt32(EPOLLIN.rawValue)
+		guard epoll_ctl(ev, EPOLL_CTL_ADD, timer, &newEvent) == 0 else {
+			throw EventTriggerErrors.timerRegistrationFailure(__cswiftslash_get_errno())
+		}
+	}
+
+	internal static func armTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer, deadline:UInt64) {
+		guard __cswiftslash_eventtrigger_timerfd_arm(timer, deadline) == 0 else {
+			fatalError("eventtrigger error - unable to arm the timerfd. this should never happen. \(#file):\(#line)")
+		}
+	}
+
+	internal static func closeTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32) {
+		var buildEvent = epoll_event()
+		_ = epoll_ctl(ev, EPOLL_CTL_DEL, timer, &buildEvent)
+		try? timer.closeFileHandle()
+	}
+
+	internal static func registerWakeup(_ ev:EventTriggerHandlePrimitive) throws(EventTriggerErrors) -> Int32 {
+		let wakeup = eventfd(0, Int32(EFD_NONBLOCK) | Int32(EFD_CLOEXEC))
+		guard wakeup != -1 else {
+			throw EventTriggerErrors.wakeupRegistrationFailure(__cswiftslash_get_errno())
+		}
+		var newEvent = epoll_event()
+		newEvent.data.ptr = nil
+		newEvent.events = UInt32(EPOLLIN.rawValue)
+		guard epoll_ctl(ev, EPOLL_CTL_ADD, wakeup, &newEvent) == 0 else {
+			let errNo = __cswiftslash_get_errno()
+			try? wakeup.closeFileHandle()
+			throw EventTriggerErrors.wakeupRegistrationFailure(errNo)
+		}
+		return wakeup
+	}
+
+	internal static func wake(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) {
+		// the only failure mode for a nonblocking eventfd write is a saturated counter, in which case the pthread is already due to wake.
+		_ = eventfd_write(wakeup, 1)
+	}
+
+	internal static func deregisterWakeup(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) throws(EventTriggerErrors) {
+		var buildEvent = epoll_event()
+		buildEvent.events = UInt32(EPOLLIN.rawValue)
+		guard epoll_ctl(ev, EPOLL_CTL_DEL, wakeup, &buildEvent) == 0 else {
+			throw EventTriggerErrors.readerDeregistrationFailure(wakeup, __cswiftslash_get_errno())
+		}
+		do {
+			try wakeup.closeFileHandle()
+		} catch {
+			throw EventTriggerErrors.readerDeregistrationFailure(wakeup, __cswiftslash_get_errno())
+		}
+	}
+
 	internal static func deregister(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors) {
 		var buildEvent = epoll_event()
 		buildEvent.data.fd = reader
@@ -0,0 +1,329 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#if os(Linux)
+import __cswiftslash_threads
+import __cswiftslash_posix_helpers
+import __cswiftslash_eventtrigger
+import SwiftSlashFIFO
+import SwiftSlashPThread
+import SwiftSlashFHHelpers
+import SwiftSlashFuture
+import SwiftSlashGlobalSerialization
+
+/// the primitive of the io_uring event trigger.
+internal struct URingHandle:@unchecked Sendable {
+	/// the io_uring instance. submissions are serialized by the instance itself, so the handle may be used from any thread.
+	internal let ring:OpaquePointer
+}
+
+/// an event trigger implementation for linux that waits on multishot polls of an io_uring instance. each armed poll posts a completion every time its handle signals readiness, and every completion that is pending when the pthread wakes is taken in a single batch.
+/// 	- NOTE: this class is marked with `unchecked Sendable` because it has mutable storage for its event buffer and its retiring records. As required by the Swift runtime, the access to this mutable storage is perfectly isolated and managed to only a single thread.
+internal final class LinuxURingEventTrigger:EventTriggerEngine, @unchecked Sendable {
+	internal typealias ArgumentType = EventTriggerSetup<EventTriggerHandle>
+	internal typealias ReturnType = Void
+	internal typealias EventTriggerHandle = URingHandle
+	internal typealias EventType = __cswiftslash_eventtrigger_uring_event_t
+
+	/// the poll events that reader and writer handles are armed with. hang up and error conditions are always reported.
+	private static let readerMask = UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLIN)
+	private static let writerMask = UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLOUT)
+
+	/// the event trigger primitive
+	internal let prim:EventTriggerHandlePrimitive
+
+	/// the eventfd that is signaled to wake this pthread.
+	internal let wakeup:Int32
+
+	/// the records that have been deregistered and are waiting to be released.
+	private let retirements:FIFO<RegisterRecord, Never>
+	/// the records whose polls are being removed. a removed poll may still post completions until its final completion arrives, so these records are kept alive until then.
+	private var retiring:[UnsafeMutableRawPointer:RegisterRecord] = [:]
+	private func removeRetiredRecords() {
+		// take the entire backlog of retired records in a single pass.
+		guard let retiredRecords = retirements.makeSyncConsumerNonBlocking().drain() else {
+			return
+		}
+		for record in retiredRecords {
+			let eventPointer = record.eventPointer
+			retiring[eventPointer] = record
+			guard __cswiftslash_eventtrigger_uring_poll_remove(prim.ring, UInt64(UInt(bitPattern:eventPointer))) == 0 else {
+				fatalError("io_uring error - unable to submit a poll removal. this should never happen. \(#file):\(#line)")
+			}
+		}
+	}
+
+	internal init(_ ptSetup:consuming ArgumentType) {
+		retirements = ptSetup.retiresIn
+		prim = ptSetup.handle
+		wakeup = ptSetup.wakeup
+	}
+
+	/// event buffer that allows us to process events. completions are copied out of the completion queue into this buffer.
+	private var eventBufferSize:Int32 = 32
+	private var eventBuffer:UnsafeMutablePointer<EventType> = UnsafeMutablePointer<EventType>.allocate(capacity:32)
+	private func reallocate(size:Int32) {
+		eventBuffer.deallocate()
+		eventBufferSize = size
+		eventBuffer = UnsafeMutablePointer<EventType>.allocate(capacity:Int(size))
+	}
+
+	deinit {
+		eventBuffer.deallocate()
+	}
+
+	/// arms the poll of a handle again after the kernel ended it without it being removed.
+	private func rearm(_ handle:Int32, mask:UInt32, userData:UInt64, multishot:Bool = true) {
+		guard __cswiftslash_eventtrigger_uring_poll_add(prim.ring, handle, mask, userData, multishot) == 0 else {
+			fatalError("io_uring error - unable to rearm a poll. this should never happen. \(#file):\(#line)")
+		}
+	}
+
+	internal func pthreadWork() throws -> Void {
+		// break by pthread cancel
+		repeat {
+
+			// wait for completions. this might block.
+			let waitResult = __cswiftslash_eventtrigger_uring_wait(prim.ring, eventBuffer, eventBufferSize)
+			switch waitResult {
+				// abnormal error conditions.
+				case Int32.min..<0:
+					switch -waitResult {
+						case EINTR:
+							pthread_testcancel()
+						default:
+							fatalError("io_uring error - this should never happen")
+					}
+
+				// any zero or positive value is considered a normal condition.
+				case 0..<Int32.max:
+
+					// process the completions against the records they carry.
+					resultLoop: for i in 0..<Int(waitResult) {
+						let currentEvent = eventBuffer[i]
+						guard let eventPointer = UnsafeMutableRawPointer(bitPattern:UInt(currentEvent.____ud)) else {
+							// the wakeup eventfd was signaled (it is the only poll armed without a record). reset its counter. retired records are removed and cancellation is checked after this batch.
+							var wakeCount:eventfd_t = 0
+							_ = eventfd_read(wakeup, &wakeCount)
+							if currentEvent.____mr == false {
+								rearm(wakeup, mask:LinuxURingEventTrigger.readerMask, userData:0)
+							}
+							continue resultLoop
+						}
+						let record = RegisterRecord.fromEventPointer(eventPointer)
+						if case .process(_, _) = record.register {
+							// the child process exited. the poll of a pidfd is armed for a single completion.
+							guard record.reapProcess(blocking:false) == true else {
+								// the child process is not waitable yet. a new poll is armed rather than waiting on it here.
+								rearm(record.handle, mask:LinuxURingEventTrigger.readerMask, userData:currentEvent.____ud, multishot:false)
+								continue resultLoop
+							}
+							// the registration ends here.
+							LinuxURingEventTrigger.closeProcess(record.handle)
+							// release the reference that the registration held.
+							Unmanaged<RegisterRecord>.fromOpaque(eventPointer).release()
+							continue resultLoop
+						}
+						if currentEvent.____mr == false {
+							// this is the final completion of the poll.
+							guard retiring.removeValue(forKey:eventPointer) == nil else {
+								// the poll was removed. nothing will reference the record past this point.
+								continue resultLoop
+							}
+							// the kernel ended the poll on its own. the handle is still registered, so the poll is armed again.
+							switch record.register {
+								case .reader(_, _):
+									rearm(record.handle, mask:LinuxURingEventTrigger.readerMask, userData:currentEvent.____ud)
+								case .writer(_, _):
+									rearm(record.handle, mask:LinuxURingEventTrigger.writerMask, userData:currentEvent.____ud)
+								case .timer(_):
+									rearm(record.handle, mask:LinuxURingEventTrigger.readerMask, userData:currentEvent.____ud)
+								case .process(_, _):
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
+							guard currentEvent.____rs >= 0 else {
+								continue resultLoop
+							}
+						}
+						if case .timer(let timers) = record.register {
+							// the timerfd expired. it is cleared before the timers fire, since firing arms it again for the next deadline.
+							__cswiftslash_eventtrigger_timerfd_clear(record.handle)
+							timers.fire()
+							continue resultLoop
+						}
+						let eventFlags = UInt32(bitPattern:currentEvent.____rs)
+						if eventFlags & UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLHUP) != 0 {
+							// reading handle closed
+							switch record.register {
+								case .reader(_, let future):
+									try? future.setSuccess(())
+								default:
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
+
+						} else if eventFlags & UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLERR) != 0 {
+
+							// writing handle closed
+							switch record.register {
+								case .writer(_, let future):
+									try? future.setSuccess(())
+								default:
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
+
+						} else if eventFlags & UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLIN) != 0 {
+
+							// read data available. the reader drains the handle itself, so no size hint is gathered here.
+							switch record.register {
+								case .reader(let doorbell, _):
+									doorbell.ring()
+								default:
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
+
+						} else if eventFlags & UInt32(__CSWIFTSLASH_EVENTTRIGGER_URING_POLLOUT) != 0 {
+
+							// write data available
+							switch record.register {
+								case .writer(let doorbell, _):
+									doorbell.ring()
+								default:
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
+
+						}
+					}
+
+					// submit the removal of any polls whose handles were deregistered since the last batch.
+					removeRetiredRecords()
+
+					// reallocate the event buffer if the batch is getting too large.
+					if waitResult*2 > eventBufferSize {
+						reallocate(size:eventBufferSize*2)
+					}
+
+					// check if the pthread is cancelled.
+					pthread_testcancel()
+
+				default:
+					fatalError("eventtrigger error - this should never happen")
+			}
+		} while true
+	}
+
+	internal static func newHandlePrimitive() throws(FileHandleError) -> EventTriggerHandle {
+		var errNo:Int32 = 0
+		guard let ring = __cswiftslash_eventtrigger_uring_init(256, &errNo) else {
+			throw FileHandleError.error_unknown(errNo)
+		}
+		return URingHandle(ring:ring)
+	}
+
+	internal static func closePrimitive(_ prim:consuming EventTriggerHandle) throws(FileHandleError) {
+		__cswiftslash_eventtrigger_uring_close(prim.ring)
+	}
+}
+
+extension LinuxURingEventTrigger {
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		let result = __cswiftslash_eventtrigger_uring_poll_add(ev.ring, reader, readerMask, UInt64(UInt(bitPattern:record)), true)
+		guard result == 0 else {
+			throw EventTriggerErrors.readerRegistrationFailure(reader, result)
+		}
+	}
+
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		let result = __cswiftslash_eventtrigger_uring_poll_add(ev.ring, writer, writerMask, UInt64(UInt(bitPattern:record)), true)
+		guard result == 0 else {
+			throw EventTriggerErrors.writerRegistrationFailure(writer, result)
+		}
+	}
+
+	internal static func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32 {
+		let pidfd = __cswiftslash_eventtrigger_pidfd_open(pid)
+		guard pidfd != -1 else {
+			throw EventTriggerErrors.processRegistrationFailure(pid, __cswiftslash_get_errno())
+		}
+		return pidfd
+	}
+
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		// a pidfd signals readiness once, when its child process exits. the poll is not multishot, so it ends with that completion.
+		let result = __cswiftslash_eventtrigger_uring_poll_add(ev.ring, process, readerMask, UInt64(UInt(bitPattern:record)), false)
+		guard result == 0 else {
+			throw EventTriggerErrors.processRegistrationFailure(process, result)
+		}
+	}
+
+	internal static func closeProcess(_ process:Int32) {
+		try? process.closeFileHandle()
+	}
+
+	/// the poll of a deregistered handle is removed by the event trigger pthread when it takes in the retired record, since only that pthread knows whether the poll needs to be armed again.
+	internal static func deregister(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors) {}
+
+	/// the poll of a deregistered handle is removed by the event trigger pthread when it takes in the retired record, since only that pthread knows whether the poll needs to be armed again.
+	internal static func deregister(_ ev:EventTriggerHandlePrimitive, writer:Int32) throws(EventTriggerErrors) {}
+
+	internal static func openTimer() throws(EventTriggerErrors) -> Int32 {
+		let timer = __cswiftslash_eventtrigger_timerfd_open()
+		guard timer != -1 else {
+			throw EventTriggerErrors.timerRegistrationFailure(__cswiftslash_get_errno())
+		}
+		return timer
+	}
+
+	internal static func register(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		let result = __cswiftslash_eventtrigger_uring_poll_add(ev.ring, timer, readerMask, UInt64(UInt(bitPattern:record)), true)
+		guard result == 0 else {
+			throw EventTriggerErrors.timerRegistrationFailure(result)
+		}
+	}
+
+	internal static func armTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer, deadline:UInt64) {
+		guard __cswiftslash_eventtrigger_timerfd_arm(timer, deadline) == 0 else {
+			fatalError("eventtrigger error - unable to arm the timerfd. this should never happen. \(#file):\(#line)")
+		}
+	}
+
+	internal static func closeTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32) {
+		// the poll itself is cancelled when the io_uring instance is closed.
+		try? timer.closeFileHandle()
+	}
+
+	internal static func registerWakeup(_ ev:EventTriggerHandlePrimitive) throws(EventTriggerErrors) -> Int32 {
+		let wakeup = eventfd(0, Int32(EFD_NONBLOCK) | Int32(EFD_CLOEXEC))
+		guard wakeup != -1 else {
+			throw EventTriggerErrors.wakeupRegistrationFailure(__cswiftslash_get_errno())
+		}
+		let result = __cswiftslash_eventtrigger_uring_poll_add(ev.ring, wakeup, readerMask, 0, true)
+		guard result == 0 else {
+			try? wakeup.closeFileHandle()
+			throw EventTriggerErrors.wakeupRegistrationFailure(result)
+		}
+		return wakeup
+	}
+
+	internal static func wake(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) {
+		// the only failure mode for a nonblocking eventfd write is a saturated counter, in which case the pthread is already due to wake.
+		_ = eventfd_write(wakeup, 1)
+	}
+
+	internal static func deregisterWakeup(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) throws(EventTriggerErrors) {
+		// the poll itself is cancelled when the io_uring instance is closed.
+		do {
+			try wakeup.closeFileHandle()
+		} catch {
+			throw EventTriggerErrors.readerDeregistrationFailure(wakeup, __cswiftslash_get_errno())
+		}
+	}
+}
+#endif
\ No newline at end of file
@@ -20,7 +20,7 @@ import SwiftSlashGlobalSerialization
 
 
 /// the primary event trigger implementation for MacOS.
-/// 	- NOTE: this class is marked with `unchecked Sendable` because it has mutable storage for `activeTriggers`. As required by the Swift runtime, the access to this mutable storage is perfectly isolated and managed to only a single thread. 
+/// 	- NOTE: this class is marked with `unchecked Sendable` because it has mutable storage for its event buffer. As required by the Swift runtime, the access to this mutable storage is perfectly isolated and managed to only a single thread. 
 internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 	internal typealias ArgumentType = EventTriggerSetup<EventTriggerHandle>
 	internal typealias ReturnType = Void
@@ -30,45 +30,32 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 	/// the event trigger primitive
 	internal let prim:EventTriggerHandlePrimitive
 
-	// the pipe that is used to cancel the event trigger.
-	internal let cancelPipe:PosixPipe
+	/// the identifier of the user event that is triggered to wake this pthread.
+	internal let wakeup:Int32
 
-	/// the file handle registrations that are currently active.
-	private var activeTriggers:[Int32:Register] = [:]
-	
-	/// the registrations that are pending.
-	private let registrations:FIFO<(Int32, Register?), Never>
-	private borrowing func extractPendingRegistrations() {
-		let getIterator = registrations.makeSyncConsumerNonBlocking()
-		infiniteLoop: repeat {
-			switch getIterator.next() {
-				case .some(let (handle, register)):
-					switch register {
-						case .some(let r):
-							activeTriggers[handle] = r
-						case .none:
-							switch activeTriggers.removeValue(forKey:handle) {
-								case .some(let r):
-									switch r {
-										case .reader(_, let future):
-											try? future.setSuccess(())
-										case .writer(_, let future):
-											try? future.setSuccess(())
-									}
-								case .none:
-									break
-							}
-					}
-				case nil:
-					break infiniteLoop
+	/// the records that have been deregistered and are waiting to be released.
+	private let retirements:FIFO<RegisterRecord, Never>
+	private borrowing func releaseRetiredRecords() {
+		// take the entire backlog of retired records in a single pass.
+		guard let retiredRecords = retirements.makeSyncConsumerNonBlocking().drain() else {
+			return
+		}
+		for record in retiredRecords {
+			switch record.register {
+				case .reader(_, let future):
+					try? future.setSuccess(())
+				case .writer(_, let future):
+					try? future.setSuccess(())
+				case .process(_, _), .timer(_):
+					fatalError("eventtrigger error - child processes and timers are never deregistered. \(#file):\(#line)")
 			}
-		} while true
+		}
 	}
 	
 	internal init(_ ptSetup:consuming ArgumentType) {
-		registrations = ptSetup.registersIn
+		retirements = ptSetup.retiresIn
 		prim = ptSetup.handle
-		cancelPipe = ptSetup.cancelPipe
+		wakeup = ptSetup.wakeup
 	}
 
 	/// event buffer that allows us to process events. this buffer is passed directly to the system call and is the first place returned events are stored.
@@ -103,19 +90,49 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 				
 				// any zero or positive value is considered a normal condition.
 				case 0..<Int32.max:
-				
-					// acquire any w/r fifo's that were passed into the registration queue while this thread was blocked.
-					extractPendingRegistrations()
 					
-					// process the events against the stored fifo's.
+					// process the events against the records they carry.
 					resultLoop: for i in 0..<Int(kqueueResult) {
 						// capture the current event for this iteration
 						let currentEvent = eventBuffer[i]
-						// capture the file handle that associates with the event.
-						let curIdent = Int32(currentEvent.ident)
-						// verify that this identifier is not the reading end of the cancel pipe.
-						guard curIdent != cancelPipe.reading else {
-							// skip the cancel identifier because it does not register with the event trigger so there is nothing to pass on.
+						// the wakeup user event is the only event registered without a record.
+						guard let eventPointer = currentEvent.udata else {
+							// skip the wakeup event. it clears itself, and retired records are released and cancellation is checked after this batch.
+							continue resultLoop
+						}
+						// capture the registration record that associates with the event.
+						let record = RegisterRecord.fromEventPointer(eventPointer)
+
+						// a child process exited. its registration is one-shot, so the kernel has already removed it.
+						if currentEvent.filter == Int16(EVFILT_PROC) {
+							if record.reapProcess(blocking:false) == false {
+								// the child process is not waitable yet. the registration is added again rather than waiting on it here.
+								var newEvent = kevent()
+								newEvent.ident = UInt(record.handle)
+								newEvent.flags = UInt16(EV_ADD | EV_ONESHOT)
+								newEvent.filter = Int16(EVFILT_PROC)
+								newEvent.fflags = UInt32(NOTE_EXIT)
+								newEvent.data = 0
+								newEvent.udata = eventPointer
+								if kevent(prim, &newEvent, 1, nil, 0, nil) == 0 {
+									continue resultLoop
+								}
+								// the kernel no longer accepts a watch on the child process, so it has finished exiting. it is waited on directly.
+								_ = record.reapProcess(blocking:true)
+							}
+							// release the reference that the registration held.
+							Unmanaged<RegisterRecord>.fromOpaque(eventPointer).release()
+							continue resultLoop
+						}
+
+						// the system timer expired. it is armed one-shot, so firing arms it again for the next deadline.
+						if currentEvent.filter == Int16(EVFILT_TIMER) {
+							switch record.register {
+								case .timer(let timers):
+									timers.fire()
+								default:
+									fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
+							}
 							continue resultLoop
 						}
 
@@ -124,9 +141,9 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 							if currentEvent.filter == Int16(EVFILT_READ) {
 							
 								// readable data.
-								switch activeTriggers[curIdent]! {
-									case .reader(let fifo, _):
-										fifo.yield(currentEvent.data)
+								switch record.register {
+									case .reader(let doorbell, _):
+										doorbell.ring(hint:currentEvent.data)
 									default:
 										fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 								}
@@ -134,9 +151,9 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 							} else if currentEvent.filter == Int16(EVFILT_WRITE) {
 
 								// writable data.
-								switch activeTriggers[curIdent] {
-									case .writer(let fifo, _):
-										fifo.yield(())
+								switch record.register {
+									case .writer(let doorbell, _):
+										doorbell.ring()
 									default:
 										fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 								}
@@ -146,11 +163,9 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 							if currentEvent.filter == Int16(EVFILT_READ) {
 
 								// reader close.
-								switch activeTriggers[curIdent] {
-									case .some(.reader(_, let future)):
+								switch record.register {
+									case .reader(_, let future):
 										try? future.setSuccess(())
-									case .none:
-										break;
 									default:
 										fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 								}
@@ -158,11 +173,9 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 							} else if currentEvent.filter == Int16(EVFILT_WRITE) {
 
 								// writer close.
-								switch activeTriggers[curIdent] {
-									case .some(.writer(_, let future)):
+								switch record.register {
+									case .writer(_, let future):
 										try? future.setSuccess(())
-									case .none:
-										break;
 									default:
 										fatalError("eventtrigger error - this should never happen. \(#file):\(#line)")
 								}
@@ -170,6 +183,9 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 						}
 					}
 
+					// none of the events in the buffer are referenced past this point, so records that were deregistered up to now can be released.
+					releaseRetiredRecords()
+
 					// reallocate the event buffer if the number of events returned in the latest iteration is encroaching on the buffer size.
 					if (kqueueResult*2) > eventBufferSize {
 						reallocate(size:eventBufferSize*2)
@@ -198,32 +214,129 @@ internal final class MacOSEventTrigger:EventTriggerEngine, @unchecked Sendable {
 }
 
 extension MacOSEventTrigger {
-	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors) {
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, reader:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
 		var newEvent = kevent()
 		newEvent.ident = UInt(reader)
 		newEvent.flags = UInt16(EV_ADD | EV_CLEAR | EV_EOF)
 		newEvent.filter = Int16(EVFILT_READ)
 		newEvent.fflags = 0
 		newEvent.data = 0
-		newEvent.udata = nil
+		newEvent.udata = record
 		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
 			throw EventTriggerErrors.readerRegistrationFailure(reader, __cswiftslash_get_errno())
 		}
 	}
 
-	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32) throws(EventTriggerErrors) {
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, writer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
 		var newEvent = kevent()
 		newEvent.ident = UInt(writer)
 		newEvent.flags = UInt16(EV_ADD | EV_CLEAR | EV_EOF)
 		newEvent.filter = Int16(EVFILT_WRITE)
 		newEvent.fflags = 0
 		newEvent.data = 0
-		newEvent.udata = nil
+		newEvent.udata = record
 		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
 			throw EventTriggerErrors.writerRegistrationFailure(writer, __cswiftslash_get_errno())
 		}
 	}
 
+	internal static func openProcess(_ pid:pid_t) throws(EventTriggerErrors) -> Int32 {
+		// kqueue watches child processes by pid directly.
+		return pid
+	}
+
+	@SwiftSlashGlobalSerialization internal static func register(_ ev:EventTriggerHandlePrimitive, process:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {
+		var newEvent = kevent()
+		newEvent.ident = UInt(process)
+		newEvent.flags = UInt16(EV_ADD | EV_ONESHOT)
+		newEvent.filter = Int16(EVFILT_PROC)
+		newEvent.fflags = UInt32(NOTE_EXIT)
+		newEvent.data = 0
+		newEvent.udata = record
+		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
+			throw EventTriggerErrors.processRegistrationFailure(process, __cswiftslash_get_errno())
+		}
+	}
+
+	internal static func closeProcess(_ process:Int32) {}
+
+	internal static func openTimer() throws(EventTriggerErrors) -> Int32 {
+		// timers live in their own identifier space, so a fixed identifier does not collide with any file handle. each event trigger has its own kqueue.
+		return 0
+	}
+
+	/// kqueue timers are added when they are armed, so there is nothing to register ahead of time.
+	internal static func register(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer) throws(EventTriggerErrors) {}
+
+	internal static func armTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32, record:UnsafeMutableRawPointer, deadline:UInt64) {
+		// kqueue timers are relative, so the deadline is measured from now. a deadline that has already passed expires as soon as possible.
+		let now = EventTriggerTimers.now()
+		var newEvent = kevent()
+		newEvent.ident = UInt(timer)
+		newEvent.flags = UInt16(EV_ADD | EV_ONESHOT)
+		newEvent.filter = Int16(EVFILT_TIMER)
+		newEvent.fflags = UInt32(NOTE_NSECONDS)
+		newEvent.data = (deadline > now) ? Int(deadline - now) : 1
+		newEvent.udata = record
+		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
+			fatalError("eventtrigger error - unable to arm the timer. this should never happen. \(#file):\(#line)")
+		}
+	}
+
+	internal static func closeTimer(_ ev:EventTriggerHandlePrimitive, timer:Int32) {
+		var newEvent = kevent()
+		newEvent.ident = UInt(timer)
+		newEvent.flags = UInt16(EV_DELETE)
+		newEvent.filter = Int16(EVFILT_TIMER)
+		newEvent.fflags = 0
+		newEvent.data = 0
+		newEvent.udata = nil
+		// the timer is already gone if it expired and was never armed again.
+		_ = kevent(ev, &newEvent, 1, nil, 0, nil)
+	}
+
+	internal static func registerWakeup(_ ev:EventTriggerHandlePrimitive) throws(EventTriggerErrors) -> Int32 {
+		// user events live in their own identifier space, so a fixed identifier does not collide with any file handle. each event trigger has its own kqueue.
+		let wakeup:Int32 = 0
+		var newEvent = kevent()
+		newEvent.ident = UInt(wakeup)
+		newEvent.flags = UInt16(EV_ADD | EV_CLEAR)
+		newEvent.filter = Int16(EVFILT_USER)
+		newEvent.fflags = 0
+		newEvent.data = 0
+		newEvent.udata = nil
+		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
+			throw EventTriggerErrors.wakeupRegistrationFailure(__cswiftslash_get_errno())
+		}
+		return wakeup
+	}
+
+	internal static func wake(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) {
+		var newEvent = kevent()
+		newEvent.ident = UInt(wakeup)
+		newEvent.flags = 0
+		newEvent.filter = Int16(EVFILT_USER)
+		newEvent.fflags = UInt32(NOTE_TRIGGER)
+		newEvent.data = 0
+		newEvent.udata = nil
+		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
+			fatalError("eventtrigger error - unable to trigger the wakeup event. this should never happen. \(#file):\(#line)")
+		}
+	}
+
+	internal static func deregisterWakeup(_ ev:EventTriggerHandlePrimitive, wakeup:Int32) throws(EventTriggerErrors) {
+		var newEvent = kevent()
+		newEvent.ident = UInt(wakeup)
+		newEvent.flags = UInt16(EV_DELETE)
+		newEvent.filter = Int16(EVFILT_USER)
+		newEvent.fflags = 0
+		newEvent.data = 0
+		newEvent.udata = nil
+		guard kevent(ev, &newEvent, 1, nil, 0, nil) == 0 else {
+			throw EventTriggerErrors.readerDeregistrationFailure(wakeup, __cswiftslash_get_errno())
+		}
+	}
+
 	internal static func deregister(_ ev:EventTriggerHandlePrimitive, reader:Int32) throws(EventTriggerErrors) {
 		var newEvent = kevent()
 		newEvent.ident = UInt(reader)
@@ -46,6 +46,7 @@ extension Int32 {
 	/// - parameter dataBuffer: the buffer to read the data into.
 	/// - parameter readSize: the size of data to read.
 	/// - returns: the number of bytes read.
+	/// - throws: FileHandleError.error_wouldblock when a non-blocking file handle has no data available.
 	public func readFH(into dataBuffer:UnsafeMutablePointer<UInt8>, size readSize:Int) throws(FileHandleError) -> Int {
 		infiniteLoop: repeat {
 			// read the data from the file handle.
@@ -53,9 +54,8 @@ extension Int32 {
 			guard amountRead > -1 else {
 				let errNo = __cswiftslash_get_errno()
 				switch errNo {
-					case EAGAIN:
-						continue infiniteLoop
-					case EWOULDBLOCK:
+					case EAGAIN, EWOULDBLOCK:
+						// a drained non-blocking handle. retrying here would spin until more data arrives.
 						throw FileHandleError.error_wouldblock;
 					case EBADF:
 						throw FileHandleError.error_bad_fh;
@@ -0,0 +1,244 @@
+/* LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import __cswiftslash_broadcast
+import SwiftSlashContained
+
+/// broadcast fifo is a single producer fifo that fans each element out to any number of subscribers. every subscriber has its own cursor into a shared, reference counted list of elements, so each element is stored once regardless of how many subscribers consume it, and is released as soon as the slowest subscriber has consumed it. a subscriber only receives the elements that are yielded after it subscribes.
+public final class BroadcastFIFO<Element, Failure>:@unchecked Sendable where Failure:Swift.Error {
+
+	/// used to convey one of the possible outcomes of consuming the next element from a subscriber.
+	public typealias ConsumeResult = FIFO<Element, Failure>.ConsumeResult
+
+	/// used to convey the various types of results that may occur when yielding an element into the broadcast fifo.
+	public enum YieldResult {
+		/// the yield value was successfully passed to every subscriber.
+		case success
+		/// the broadcast fifo has no subscribers, and the yield value was discarded.
+		case noSubscribers
+		/// the broadcast fifo was closed, and the yield value was discarded.
+		case fifoClosed
+	}
+
+	/// a snapshot of the counters of a broadcast fifo.
+	public struct Statistics:Sendable {
+		/// the number of elements currently held because at least one subscriber has yet to consume them.
+		public let depth:Int
+		/// the highest number of elements that have been held at once.
+		public let highWaterMark:Int
+		/// the total number of elements that have been passed to at least one subscriber.
+		public let totalPassed:UInt64
+	}
+
+	// underlying c implementation
+	fileprivate let broadcast_primitive_ptr:UnsafeMutablePointer<__cswiftslash_broadcast_t>
+
+	/// initialize a new broadcast fifo with no subscribers.
+	public init() {
+		broadcast_primitive_ptr = __cswiftslash_broadcast_init()
+	}
+
+	/// the number of elements that are currently held because at least one subscriber has yet to consume them.
+	public var heldElementCount:Int {
+		return __cswiftslash_broadcast_held_count(broadcast_primitive_ptr)
+	}
+
+	/// a snapshot of the counters of the broadcast fifo.
+	public var statistics:Statistics {
+		var depth:Int = 0
+		var highWaterMark:Int = 0
+		var totalPassed:UInt64 = 0
+		__cswiftslash_broadcast_statistics(broadcast_primitive_ptr, &depth, &highWaterMark, &totalPassed)
+		return Statistics(depth:depth, highWaterMark:highWaterMark, totalPassed:totalPassed)
+	}
+
+	/// pass an element to every current subscriber. the element is held until every one of those subscribers has consumed it. if there are no subscribers, or the broadcast fifo is closed, the element is immediately discarded.
+	@discardableResult public borrowing func yield(_ element:consuming Element) -> YieldResult {
+		let um = FIFO<Element, Failure>._encode(element)
+		switch __cswiftslash_broadcast_pass(broadcast_primitive_ptr, um) {
+			case 0:
+				return .success
+			case 1:
+				FIFO<Element, Failure>._release(um)
+				return .noSubscribers
+			case -1:
+				FIFO<Element, Failure>._release(um)
+				return .fifoClosed
+			default:
+				fatalError("swiftslash - unexpected return value from __cswiftslash_broadcast_pass - \(#file):\(#line)")
+		}
+	}
+
+	/// finish the broadcast fifo. after calling this function, the broadcast fifo will not accept any more data. each subscriber will see the end of the broadcast once it has consumed the elements it is holding.
+	public borrowing func finish() {
+		let resultElement = Unmanaged.passRetained(Contained<Result<Void, Failure>>(.success(())))
+		guard __cswiftslash_broadcast_pass_cap(broadcast_primitive_ptr, resultElement.toOpaque()) == true else {
+			_ = resultElement.takeRetainedValue()
+			return
+		}
+	}
+
+	/// finish the broadcast fifo with an error. after calling this function, the broadcast fifo will not accept any more data. each subscriber will see the error once it has consumed the elements it is holding.
+	public borrowing func finish(throwing finishingError:consuming Failure) {
+		let resultElement = Unmanaged.passRetained(Contained<Result<Void, Failure>>(.failure(finishingError)))
+		guard __cswiftslash_broadcast_pass_cap(broadcast_primitive_ptr, resultElement.toOpaque()) == true else {
+			_ = resultElement.takeRetainedValue()
+			return
+		}
+	}
+
+	/// create a new subscriber that consumes every element yielded after this call. elements are held for the subscriber until it consumes them or is deinitialized.
+	public func subscribe() -> Subscriber {
+		return Subscriber(self)
+	}
+
+	deinit {
+		// subscribers retain the broadcast fifo, so there are no subscribers (and no held elements) by the time it is deinitialized.
+		var capPtr:UnsafeMutableRawPointer? = nil
+		if __cswiftslash_broadcast_destroy(broadcast_primitive_ptr, &capPtr) == true && capPtr != nil {
+			_ = Unmanaged<Contained<Result<Void, Failure>>>.fromOpaque(capPtr!).takeRetainedValue()
+		}
+	}
+}
+
+extension BroadcastFIFO {
+	/// a single consumer of a broadcast fifo. a subscriber is intended for use by a single consuming task at a time.
+	public final class Subscriber:@unchecked Sendable {
+		/// specifies the action to take when a task is cancelled while consuming from the subscriber.
+		public enum WhenConsumingTaskCancelled {
+			/// when the current task is cancelled, the broadcast fifo will not be affected. no actions will be taken.
+			case noAction
+			/// when the current task is cancelled, the broadcast fifo will be finished for every subscriber.
+			case finish
+		}
+
+		/// the broadcast fifo being consumed.
+		fileprivate let broadcast:BroadcastFIFO<Element, Failure>
+		// underlying c implementation
+		fileprivate let subscriber_primitive_ptr:UnsafeMutablePointer<__cswiftslash_broadcast_subscriber_t>
+
+		internal init(_ broadcastIn:consuming BroadcastFIFO<Element, Failure>) {
+			subscriber_primitive_ptr = __cswiftslash_broadcast_subscribe(broadcastIn.broadcast_primitive_ptr)
+			broadcast = broadcastIn
+		}
+
+		/// consume the next element without waiting.
+		/// - returns: `.wouldBlock` if this subscriber has consumed every element that has been yielded so far.
+		public func nextNonBlocking() -> ConsumeResult {
+			var pointer:__cswiftslash_optr_t = nil
+			var hold:__cswiftslash_broadcast_node_ptr_t = nil
+			let result = __cswiftslash_broadcast_consume_nonblocking(subscriber_primitive_ptr, &pointer, &hold)
+			return broadcast._handleConsume(result, pointer, hold)
+		}
+
+		/// wait asyncronously for the next element to consume.
+		public func next(whenTaskCancelled cancelAction:consuming WhenConsumingTaskCancelled = .noAction) async -> ConsumeResult {
+			switch cancelAction {
+				case .noAction:
+					return await _next()
+				case .finish:
+					return await withTaskCancellationHandler(operation: {
+						await _next()
+					}, onCancel: { [b = broadcast] in
+						b.finish()
+					})
+			}
+		}
+
+		fileprivate func _next() async -> ConsumeResult {
+			let handoff = await _consumeAsync()
+			switch broadcast._handleConsume(handoff.result, handoff.pointer, handoff.hold) {
+				case .wouldBlock:
+					fatalError("swiftslash - unexpected wouldBlock condition from an async broadcast subscriber - \(#file):\(#line)")
+				case let consumed:
+					return consumed
+			}
+		}
+
+		deinit {
+			// release the hold this subscriber has on the elements it did not consume, and release the elements that are no longer held by any subscriber.
+			var items = [UnsafeMutableRawPointer?]()
+			withUnsafeMutablePointer(to:&items) { itemsPointer in
+				__cswiftslash_broadcast_unsubscribe(subscriber_primitive_ptr, { pointer, ctx in
+					ctx!.assumingMemoryBound(to:[UnsafeMutableRawPointer?].self).pointee.append(pointer)
+				}, itemsPointer)
+			}
+			for item in items {
+				FIFO<Element, Failure>._release(item)
+			}
+		}
+	}
+}
+
+/// the outcome of a consumption that is handed to a suspended subscriber.
+fileprivate struct BroadcastHandoff:@unchecked Sendable {
+	fileprivate let result:__cswiftslash_broadcast_consume_result_t
+	fileprivate let pointer:__cswiftslash_optr_t
+	fileprivate let hold:__cswiftslash_broadcast_node_ptr_t
+}
+
+/// the context that is stored in the underlying subscriber while an async consumer is suspended. the subscriber is retained by this context so that it cannot be removed out from under the suspended consumer.
+fileprivate final class BroadcastAsyncWaiter {
+	fileprivate let continuation:UnsafeContinuation<BroadcastHandoff, Never>
+	private let subscriber:AnyObject
+	fileprivate init(_ continuation:UnsafeContinuation<BroadcastHandoff, Never>, retaining subscriber:AnyObject) {
+		self.continuation = continuation
+		self.subscriber = subscriber
+	}
+}
+
+/// fires a suspended subscriber with the element or cap that was handed to it by the producer.
+fileprivate let broadcastAsyncWaiterHandler:__cswiftslash_broadcast_waiter_f = { result, pointer, hold, ctxPtr in
+	Unmanaged<BroadcastAsyncWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().continuation.resume(returning:BroadcastHandoff(result:result, pointer:pointer, hold:hold))
+}
+
+extension BroadcastFIFO.Subscriber {
+	/// suspends the calling task until the next element (or cap) can be handed to it. no thread is blocked while waiting - when the subscriber has consumed every element, the continuation is stored in the underlying subscriber and resumed directly by the producer that passes the next element.
+	fileprivate func _consumeAsync() async -> BroadcastHandoff {
+		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<BroadcastHandoff, Never>) in
+			let waiter = Unmanaged.passRetained(BroadcastAsyncWaiter(continuation, retaining:self)).toOpaque()
+			var pointer:__cswiftslash_optr_t = nil
+			var hold:__cswiftslash_broadcast_node_ptr_t = nil
+			let result = __cswiftslash_broadcast_consume_async(subscriber_primitive_ptr, &pointer, &hold, broadcastAsyncWaiterHandler, waiter)
+			guard result != __CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK else {
+				// the waiter was stored and will be resumed by the producer.
+				return
+			}
+			// the waiter was not stored, so the result can be handed to the continuation immediately.
+			_ = Unmanaged<BroadcastAsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+			continuation.resume(returning:BroadcastHandoff(result:result, pointer:pointer, hold:hold))
+		})
+	}
+}
+
+extension BroadcastFIFO {
+	/// copies a consumed element out of the shared list, then releases the subscriber's hold on it. the element is released when the subscriber held the last hold on it.
+	fileprivate borrowing func _handleConsume(_ ret:__cswiftslash_broadcast_consume_result_t, _ pointer:__cswiftslash_optr_t, _ hold:__cswiftslash_broadcast_node_ptr_t) -> ConsumeResult {
+		switch ret {
+			case __CSWIFTSLASH_BROADCAST_CONSUME_RESULT:
+				let element = FIFO<Element, Failure>._peek(pointer)
+				if __cswiftslash_broadcast_release(broadcast_primitive_ptr, hold!) == true {
+					FIFO<Element, Failure>._release(pointer)
+				}
+				return .element(element)
+			case __CSWIFTSLASH_BROADCAST_CONSUME_CAP:
+				switch Unmanaged<Contained<Result<Void, Failure>>>.fromOpaque(pointer!).takeUnretainedValue().value() {
+					case .success:
+						return .capped(.success(()))
+					case .failure(let err):
+						return .capped(.failure(err))
+				}
+			case __CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK:
+				return .wouldBlock
+			default:
+				fatalError("swiftslash - unexpected return value from __cswiftslash_broadcast_consume - \(#file):\(#line)")
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+/* LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+
+import __cswiftslash_doorbell
+
+/// doorbell is a level-style signal that is designed for a single ringing thread and a single consumer. any number of rings that occur between two consumptions are coalesced into a single pending ring, and the largest hint that accompanied those rings is retained. unlike a FIFO, a doorbell never buffers more than one signal, so a chatty producer costs the consumer at most one pending wakeup.
+public final class Doorbell:@unchecked Sendable {
+
+	/// used to convey one of the possible outcomes of consuming the pending ring from the doorbell.
+	public enum ConsumeResult {
+		/// the doorbell was rung since the last consumption. the largest hint of the coalesced rings is returned with this case.
+		case rung(Int)
+		/// the doorbell was finished, and no more rings may be consumed.
+		case finished
+		/// the doorbell has not been rung since the last consumption.
+		case wouldBlock
+	}
+
+	/// used to convey the various types of results that may occur when ringing the doorbell.
+	public enum RingResult {
+		/// the doorbell was rung.
+		case rung
+		/// a ring was already pending, and this ring was coalesced into it.
+		case coalesced
+		/// the doorbell was finished, and the ring was discarded.
+		case doorbellFinished
+	}
+
+	// underlying c implementation
+	private let doorbell_primitive_ptr:UnsafeMutablePointer<__cswiftslash_doorbell_t>
+
+	/// initialize a new doorbell that is not rung.
+	public init() {
+		doorbell_primitive_ptr = __cswiftslash_doorbell_init()
+	}
+
+	/// ring the doorbell. if a consumer is waiting, it is resumed directly. otherwise the ring is held (or coalesced with the ring that is already held) until the consumer takes it.
+	/// - parameters:
+	///		- hint: a non-negative value to accompany the ring. when rings are coalesced, the largest hint is retained.
+	@discardableResult public borrowing func ring(hint:Int = 0) -> RingResult {
+		switch __cswiftslash_doorbell_ring(doorbell_primitive_ptr, hint) {
+			case 0:
+				return .rung
+			case 1:
+				return .coalesced
+			case -1:
+				return .doorbellFinished
+			default:
+				fatalError("swiftslash - unexpected return value from __cswiftslash_doorbell_ring - \(#file):\(#line)")
+		}
+	}
+
+	/// finish the doorbell. after calling this function, the doorbell will not accept any more rings. a ring that is pending at the time of finishing may still be consumed.
+	public borrowing func finish() {
+		__cswiftslash_doorbell_close(doorbell_primitive_ptr)
+	}
+
+	deinit {
+		__cswiftslash_doorbell_destroy(doorbell_primitive_ptr)
+	}
+}
+
+extension Doorbell {
+	public func makeSyncConsumerNonBlocking() -> SyncConsumerNonBlocking {
+		return SyncConsumerNonBlocking(self)
+	}
+
+	public struct SyncConsumerNonBlocking {
+		private let doorbell:Doorbell
+		internal init(_ doorbellIn:consuming Doorbell) {
+			doorbell = doorbellIn
+		}
+
+		/// take the pending ring from the doorbell without waiting.
+		public borrowing func next() -> ConsumeResult {
+			var hint:Int = 0
+			return Doorbell._handleTake(__cswiftslash_doorbell_take(doorbell.doorbell_primitive_ptr, &hint), hint)
+		}
+	}
+}
+
+extension Doorbell {
+	/// create a new consumer for the doorbell. this should be the only consumer for the doorbell, as the doorbell is not intended for use with multiple consumers.
+	public func makeAsyncConsumer() -> AsyncConsumer {
+		return AsyncConsumer(self)
+	}
+
+	/// the primary structure for consuming rings from the doorbell.
+	public struct AsyncConsumer {
+		/// specifies the action to take when a task is cancelled while consuming the doorbell.
+		public enum WhenConsumingTaskCancelled {
+			/// when the current task is cancelled, the doorbell will not be affected. no actions will be taken.
+			case noAction
+			/// when the current task is cancelled, the doorbell will be finished.
+			case finish
+		}
+
+		/// the doorbell being consumed
+		private let doorbell:Doorbell
+
+		/// initialize a new consumer for the specified doorbell.
+		internal init(_ doorbellIn:consuming Doorbell) {
+			doorbell = doorbellIn
+		}
+
+		/// wait asyncronously for the doorbell to be rung.
+		/// - returns: the largest hint of the rings that were coalesced since the last consumption, or `nil` if the doorbell was finished.
+		public borrowing func next(whenTaskCancelled cancelAction:consuming WhenConsumingTaskCancelled = .noAction) async -> Int? {
+			switch cancelAction {
+				case .noAction:
+					return await _next()
+				case .finish:
+					return await withTaskCancellationHandler(operation: {
+						await _next()
+					}, onCancel: { [d = doorbell] in
+						d.finish()
+					})
+			}
+		}
+
+		fileprivate borrowing func _next() async -> Int? {
+			let handoff = await doorbell._takeAsync()
+			switch Doorbell._handleTake(handoff.result, handoff.hint) {
+				case .rung(let hint):
+					return hint
+				case .finished:
+					return nil
+				case .wouldBlock:
+					fatalError("swiftslash - unexpected wouldBlock condition from an async doorbell consumer - \(#file):\(#line)")
+			}
+		}
+	}
+}
+
+/// the outcome of a take that is handed to a suspended async consumer.
+fileprivate struct DoorbellHandoff:@unchecked Sendable {
+	fileprivate let result:__cswiftslash_doorbell_take_result_t
+	fileprivate let hint:Int
+}
+
+/// the context that is stored in the underlying doorbell while an async consumer is suspended. the doorbell is retained by this context so that it cannot be destroyed out from under the suspended consumer.
+fileprivate final class DoorbellAsyncWaiter {
+	fileprivate let continuation:UnsafeContinuation<DoorbellHandoff, Never>
+	private let doorbell:Doorbell
+	fileprivate init(_ continuation:UnsafeContinuation<DoorbellHandoff, Never>, retaining doorbell:Doorbell) {
+		self.continuation = continuation
+		self.doorbell = doorbell
+	}
+}
+
+/// fires a suspended async consumer with the ring or finish that was handed to it.
+fileprivate let doorbellAsyncWaiterHandler:__cswiftslash_doorbell_waiter_f = { result, hint, ctxPtr in
+	Unmanaged<DoorbellAsyncWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().continuation.resume(returning:DoorbellHandoff(result:result, hint:hint))
+}
+
+extension Doorbell {
+	/// suspends the calling task until the doorbell is rung or finished. no thread is blocked while waiting - the continuation is stored in the underlying doorbell and resumed directly by the ringing thread.
+	fileprivate borrowing func _takeAsync() async -> DoorbellHandoff {
+		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<DoorbellHandoff, Never>) in
+			let waiter = Unmanaged.passRetained(DoorbellAsyncWaiter(continuation, retaining:self)).toOpaque()
+			var hint:Int = 0
+			let result = __cswiftslash_doorbell_take_async(doorbell_primitive_ptr, &hint, doorbellAsyncWaiterHandler, waiter)
+			guard result != __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK else {
+				// the waiter was stored and will be resumed by the ringing thread.
+				return
+			}
+			// the waiter was not stored, so the result can be handed to the continuation immediately.
+			_ = Unmanaged<DoorbellAsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+			continuation.resume(returning:DoorbellHandoff(result:result, hint:hint))
+		})
+	}
+
+	fileprivate static func _handleTake(_ ret:__cswiftslash_doorbell_take_result_t, _ hint:Int) -> ConsumeResult {
+		switch ret {
+			case __CSWIFTSLASH_DOORBELL_TAKE_RUNG:
+				return .rung(hint)
+			case __CSWIFTSLASH_DOORBELL_TAKE_CLOSED:
+				return .finished
+			case __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK:
+				return .wouldBlock
+			default:
+				fatalError("swiftslash - unexpected return value from __cswiftslash_doorbell_take - \(#file):\(#line)")
+		}
+	}
+}
\ No newline at end of file
@@ -9,8 +9,15 @@ copyright (c) tanner silva 2025. all rights reserved.
 */
 
 import __cswiftslash_fifo
+import __cswiftslash_timer
 import SwiftSlashContained
 
+/// thrown when waiting on a FIFO ends before an element (or the end of the FIFO) is available.
+public enum FIFOWaitError:Swift.Error {
+	/// the deadline of the wait passed before an element was available.
+	case timedOut
+}
+
 /// fifo is a mechanism that operates very similarly to a native Swift AsyncStream. the tool is designed for use with a single producer and a single consumer. the tool is thread-safe and reentrancy-safe, but is not intended for use with multiple producers or multiple consumers.
 public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swift.Error {
 	
@@ -33,6 +40,20 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 		/// the FIFO was full, and the yield value was not passed into the FIFO
 		case fifoFull
 	}
+
+	/// a snapshot of the introspection counters of a FIFO. each counter is read atomically, but the counters are not read together, so a snapshot taken while the FIFO is in use may straddle a yield or a consumption.
+	public struct Statistics:Sendable {
+		/// the number of elements currently buffered in the FIFO.
+		public let depth:Int
+		/// the highest number of elements the FIFO has buffered at once.
+		public let highWaterMark:Int
+		/// the total number of elements that have been passed into the FIFO.
+		public let totalPassed:UInt64
+		/// the total number of elements that have been consumed from the FIFO.
+		public let totalConsumed:UInt64
+		/// the cumulative time that consumers have spent waiting for an element.
+		public let consumerWaitTime:Duration
+	}
 	
 	// underlying c implementation
 	private let datachain_primitive_ptr:UnsafeMutablePointer<__cswiftslash_fifo_linkpair_t>
@@ -40,7 +61,8 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 	/// initialize a new FIFO with a specified maximum element count.
 	/// - parameters:
 	///		- maximumElementCount: the maximum number of elements that may be held in the FIFO at any given time.
-	public init(maximumElementCount:Int) {
+	///		- collectStatistics: when `true`, the FIFO maintains the counters that are reported by ``statistics``.
+	public init(maximumElementCount:Int, collectStatistics:Bool = false) {
 		// memory setup
 		let newPointer = __cswiftslash_fifo_init(true)
 
@@ -48,17 +70,54 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 		guard __cswiftslash_fifo_set_max_elements(newPointer, maximumElementCount) == true else {
 			fatalError("swiftslash - failed to set maximum element count - \(#file):\(#line)")
 		}
+		if collectStatistics == true {
+			__cswiftslash_fifo_enable_statistics(newPointer)
+		}
+		datachain_primitive_ptr = newPointer
+	}
+
+	/// initialize a new FIFO that buffers elements in a fixed-capacity ring rather than a linked chain. the producer and consumer exchange elements through the ring without taking a lock, making this variant well suited to hot paths where the number of buffered elements is naturally bounded. yields into a full ring return `fifoFull`.
+	/// - parameters:
+	///		- ringCapacity: the number of elements the ring can hold. this value is rounded up to the next power of two.
+	///		- collectStatistics: when `true`, the FIFO maintains the counters that are reported by ``statistics``.
+	public init(ringCapacity:Int, collectStatistics:Bool = false) {
+		guard ringCapacity > 0 else {
+			fatalError("swiftslash - ring capacity must be greater than zero - \(#file):\(#line)")
+		}
+		let newPointer = __cswiftslash_fifo_init_ring(ringCapacity)
+		if collectStatistics == true {
+			__cswiftslash_fifo_enable_statistics(newPointer)
+		}
 		datachain_primitive_ptr = newPointer
 	}
 
 	/// initialize a new FIFO with no maximum element count. yielded elements will be retained indefinitely until they are consumed or the FIFO is deinitialized.
-	public init() {
-		datachain_primitive_ptr = __cswiftslash_fifo_init(true)
+	/// - parameters:
+	///		- collectStatistics: when `true`, the FIFO maintains the counters that are reported by ``statistics``.
+	public init(collectStatistics:Bool = false) {
+		let newPointer = __cswiftslash_fifo_init(true)
+		if collectStatistics == true {
+			__cswiftslash_fifo_enable_statistics(newPointer)
+		}
+		datachain_primitive_ptr = newPointer
+	}
+
+	/// a snapshot of the introspection counters of the FIFO, or `nil` if the FIFO was not initialized to collect statistics.
+	public var statistics:Statistics? {
+		var depth:Int = 0
+		var highWaterMark:Int = 0
+		var totalPassed:UInt64 = 0
+		var totalConsumed:UInt64 = 0
+		var waitNanoseconds:UInt64 = 0
+		guard __cswiftslash_fifo_statistics(datachain_primitive_ptr, &depth, &highWaterMark, &totalPassed, &totalConsumed, &waitNanoseconds) == true else {
+			return nil
+		}
+		return Statistics(depth:depth, highWaterMark:highWaterMark, totalPassed:totalPassed, totalConsumed:totalConsumed, consumerWaitTime:.nanoseconds(waitNanoseconds))
 	}
 
 	/// pass an element into the FIFO for consumption. the element will be held until it is consumed by the consumer. if the FIFO is closed, the element will be held until the FIFO is deinitialized. if a maximum element count was set, the element will be immediately discarded if the FIFO is full.
 	@discardableResult public borrowing func yield(_ element:consuming Element) -> YieldResult {
-		let um = Unmanaged.passRetained(Contained(element)).toOpaque()
+		let um = FIFO._encode(element)
 		passLoop: repeat {
 			logicSwitch: switch __cswiftslash_fifo_pass(datachain_primitive_ptr, um) {
 				// try again
@@ -71,12 +130,12 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 
 				// the FIFO is closed
 				case -1:
-					_ = Unmanaged<Contained<Element>>.fromOpaque(um).takeRetainedValue()
+					FIFO._release(um)
 					return .fifoClosed
 
 				// the FIFO is full
 				case -2:
-					_ = Unmanaged<Contained<Element>>.fromOpaque(um).takeRetainedValue()
+					FIFO._release(um)
 					return .fifoFull
 				default:
 					fatalError("swiftslash - unexpected return value from __cswiftslash_fifo_pass - \(#file):\(#line)")
@@ -84,6 +143,36 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 		} while true
 	}
 
+	/// pass a sequence of elements into the FIFO for consumption. the elements are passed in order under a single acquisition of the underlying lock, and a waiting consumer is woken once for the entire batch. if the FIFO is closed, none of the elements are passed. if a maximum element count was set and the FIFO fills before every element is passed, the remaining elements are immediately discarded.
+	@discardableResult public borrowing func yield<S:Sequence>(contentsOf elements:consuming S) -> YieldResult where S.Element == Element {
+		var pointers = [UnsafeMutableRawPointer?]()
+		pointers.reserveCapacity(elements.underestimatedCount)
+		for element in elements {
+			pointers.append(FIFO._encode(element))
+		}
+		guard pointers.count > 0 else {
+			return .success
+		}
+		var passedCount = 0
+		let passResult = pointers.withUnsafeBufferPointer { pointersBuffer in
+			return __cswiftslash_fifo_pass_many(datachain_primitive_ptr, pointersBuffer.baseAddress!, pointersBuffer.count, &passedCount)
+		}
+		// release the elements that were not passed into the FIFO
+		for pointer in pointers[passedCount...] {
+			FIFO._release(pointer)
+		}
+		switch passResult {
+			case 0:
+				return .success
+			case -1:
+				return .fifoClosed
+			case -2:
+				return .fifoFull
+			default:
+				fatalError("swiftslash - unexpected return value from __cswiftslash_fifo_pass_many - \(#file):\(#line)")
+		}
+	}
+
 	/// finish the FIFO. after calling this function, the FIFO will not accept any more data. additional objects may be passed into the FIFO, and they will be held and eventually dereferenced when the FIFO is deinitialized.
 	public borrowing func finish() {
 		let resultElement = Unmanaged.passRetained(Contained<Result<Void, Failure>>(.success(())))
@@ -104,16 +193,16 @@ public final class FIFO<Element, Failure>:@unchecked Sendable where Failure:Swif
 
 	deinit {
 		// close the fifo and capture the various pointers that are being held and returned by this function.
-		var items = [UnsafeMutableRawPointer]()
+		var items = [UnsafeMutableRawPointer?]()
 		let capPointer:(Bool, UnsafeMutableRawPointer?) = withUnsafeMutablePointer(to:&items) { itemsPointer in
 			var capPtr:UnsafeMutableRawPointer? = nil
 			return (__cswiftslash_fifo_close(datachain_primitive_ptr, { pointer, ctx in
-				ctx!.assumingMemoryBound(to:[UnsafeMutableRawPointer].self).pointee.append(pointer)
+				ctx!.assumingMemoryBound(to:[UnsafeMutableRawPointer?].self).pointee.append(pointer)
 			}, itemsPointer, &capPtr), capPtr)
 		}
 		// consume a reference to each of the items that were being held by the FIFO
 		for item in items {
-			_ = Unmanaged<Contained<Element>>.fromOpaque(item).takeRetainedValue()
+			FIFO._release(item)
 		}
 		// consume the cap pointer if it was returned
 		if capPointer.0 == true && capPointer.1 != nil {
@@ -157,6 +246,13 @@ extension FIFO {
 		public borrowing func next() throws(Failure) -> Element? {
 			return try _next()?.get()
 		}
+
+		/// consume every element that is currently buffered in the FIFO under a single acquisition of the underlying lock.
+		/// - returns: the buffered elements, in the order they were yielded. an empty array is returned when no elements are buffered. `nil` is returned when the FIFO has been finished and every element has been consumed.
+		/// - throws: the error that the FIFO was finished with, once every element has been consumed.
+		public borrowing func drain() throws(Failure) -> [Element]? {
+			return try _drain().get()
+		}
 	}
 }
 
@@ -178,6 +274,14 @@ extension FIFO {
 		public borrowing func next() -> ConsumeResult {
 			return _nextExplicit()
 		}
+
+		/// wait for the next element to consume from the FIFO, blocking the calling thread until an element is available or the deadline passes.
+		/// - parameters:
+		///		- deadline: the instant at which the consumer stops waiting.
+		/// - returns: `.wouldBlock` if the deadline passed before an element (or the end of the FIFO) was available.
+		public borrowing func next(deadline:ContinuousClock.Instant) -> ConsumeResult {
+			return _nextExplicit(deadline:deadline)
+		}
 	}
 }
 
@@ -195,6 +299,18 @@ extension FIFO {
 		public borrowing func next() throws(Failure) -> Element? {
 			return try _next().get()
 		}
+
+		/// wait for the next element to consume from the FIFO, blocking the calling thread until an element is available or the deadline passes.
+		/// - parameters:
+		///		- deadline: the instant at which the consumer stops waiting.
+		/// - returns: the next element, or `nil` once the FIFO has been finished and every element has been consumed. the error that the FIFO was finished with is returned as a failure.
+		/// - throws: `FIFOWaitError.timedOut` if the deadline passed before an element (or the end of the FIFO) was available.
+		public borrowing func next(deadline:ContinuousClock.Instant) throws(FIFOWaitError) -> Result<Element?, Failure> {
+			guard let result = _next(deadline:deadline) else {
+				throw FIFOWaitError.timedOut
+			}
+			return result
+		}
 	}
 }
 
@@ -226,6 +342,23 @@ extension FIFO {
 					})
 			}
 		}
+
+		/// wait asyncronously for the next element to consume from the FIFO, giving up when the deadline passes. no thread is blocked while waiting.
+		/// - parameters:
+		///		- deadline: the instant at which the consumer stops waiting.
+		/// - returns: `.wouldBlock` if the deadline passed before an element (or the end of the FIFO) was available.
+		public borrowing func next(deadline:ContinuousClock.Instant, whenTaskCancelled cancelAction:consuming WhenConsumingTaskCancelled = .noAction) async -> ConsumeResult {
+			switch cancelAction {
+				case .noAction:
+					return await _nextExplicit(deadline:deadline)
+				case .finish:
+					return await withTaskCancellationHandler(operation: {
+						await _nextExplicit(deadline:deadline)
+					}, onCancel: { [f = fifo] in
+						f.finish()
+					})
+			}
+		}
 	}
 }
 
@@ -266,57 +399,242 @@ extension FIFO {
 					}).get()
 			}
 		}
+
+		/// wait asyncronously for the next element to consume from the FIFO, giving up when the deadline passes. no thread is blocked while waiting.
+		/// - parameters:
+		///		- deadline: the instant at which the consumer stops waiting.
+		/// - returns: the next element, or `nil` once the FIFO has been finished and every element has been consumed. the error that the FIFO was finished with is returned as a failure.
+		/// - throws: `FIFOWaitError.timedOut` if the deadline passed before an element (or the end of the FIFO) was available.
+		public borrowing func next(deadline:ContinuousClock.Instant, whenTaskCancelled cancelAction:consuming WhenConsumingTaskCancelled = .noAction) async throws(FIFOWaitError) -> Result<Element?, Failure> {
+			let result:Result<Element?, Failure>?
+			switch cancelAction {
+				case .noAction:
+					result = await _next(deadline:deadline)
+				case .finish:
+					result = await withTaskCancellationHandler(operation: {
+						await _next(deadline:deadline)
+					}, onCancel: { [f = fifo] in
+						f.finish()
+					})
+			}
+			guard let result else {
+				throw FIFOWaitError.timedOut
+			}
+			return result
+		}
 	}
 }
 
 extension FIFO.SyncConsumerNonBlockingExplicit {
 	fileprivate borrowing func _nextExplicit() -> FIFO.ConsumeResult {
-		var pointer:__cswiftslash_ptr_t? = nil
+		var pointer:__cswiftslash_optr_t = nil
 		return FIFO._handleFIFOConsumeExplicit(__cswiftslash_fifo_consume_nonblocking(fifo.datachain_primitive_ptr, &pointer), pointer)
 	}
 }
 extension FIFO.SyncConsumerNonBlocking {
 	fileprivate borrowing func _next() -> Result<Element?, Failure>? {
-		var pointer:__cswiftslash_ptr_t? = nil
+		var pointer:__cswiftslash_optr_t = nil
 		return FIFO._handleFIFOConsume(__cswiftslash_fifo_consume_nonblocking(fifo.datachain_primitive_ptr, &pointer), pointer)
 	}
 }
 
+extension FIFO.SyncConsumerNonBlocking {
+	fileprivate borrowing func _drain() -> Result<[Element]?, Failure> {
+		var pointers = [UnsafeMutableRawPointer?]()
+		var capPointer:__cswiftslash_optr_t = nil
+		let consumeResult = withUnsafeMutablePointer(to:&pointers) { pointersPointer in
+			return __cswiftslash_fifo_consume_all(fifo.datachain_primitive_ptr, { pointer, ctx in
+				ctx!.assumingMemoryBound(to:[UnsafeMutableRawPointer?].self).pointee.append(pointer)
+			}, pointersPointer, &capPointer)
+		}
+		switch consumeResult {
+			case __CSWIFTSLASH_FIFO_CONSUME_RESULT:
+				return .success(pointers.map { FIFO._decode($0) })
+			case __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK:
+				return .success([])
+			default:
+				return FIFO._handleFIFOConsume(consumeResult, capPointer)!.map { _ -> [Element]? in nil }
+		}
+	}
+}
+
 extension FIFO.SyncConsumerBlockingExplicit {
 	fileprivate borrowing func _nextExplicit() -> FIFO.ConsumeResult {
-		var pointer:__cswiftslash_ptr_t? = nil
+		var pointer:__cswiftslash_optr_t = nil
 		return FIFO._handleFIFOConsumeExplicit(__cswiftslash_fifo_consume_blocking(fifo.datachain_primitive_ptr, &pointer), pointer)
 	}
+	fileprivate borrowing func _nextExplicit(deadline:ContinuousClock.Instant) -> FIFO.ConsumeResult {
+		var pointer:__cswiftslash_optr_t = nil
+		return FIFO._handleFIFOConsumeExplicit(__cswiftslash_fifo_consume_blocking_until(fifo.datachain_primitive_ptr, &pointer, FIFO._monotonicDeadline(deadline)), pointer)
+	}
 }
 extension FIFO.SyncConsumerBlocking {
 	fileprivate borrowing func _next() -> Result<Element?, Failure> {
-		var pointer:__cswiftslash_ptr_t? = nil
+		var pointer:__cswiftslash_optr_t = nil
 		return FIFO._handleFIFOConsume(__cswiftslash_fifo_consume_blocking(fifo.datachain_primitive_ptr, &pointer), pointer)!
 	}
+	fileprivate borrowing func _next(deadline:ContinuousClock.Instant) -> Result<Element?, Failure>? {
+		var pointer:__cswiftslash_optr_t = nil
+		return FIFO._handleFIFOConsume(__cswiftslash_fifo_consume_blocking_until(fifo.datachain_primitive_ptr, &pointer, FIFO._monotonicDeadline(deadline)), pointer)
+	}
 }
 extension FIFO.AsyncConsumerExplicit {
 	fileprivate borrowing func _nextExplicit() async -> FIFO.ConsumeResult {
-		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<FIFO.ConsumeResult, Never>) in
-			var pointer:__cswiftslash_ptr_t? = nil
-			let result = FIFO._handleFIFOConsumeExplicit(__cswiftslash_fifo_consume_blocking(fifo.datachain_primitive_ptr, &pointer), pointer)
-			continuation.resume(returning:result)
-		})
+		let handoff = await fifo._consumeAsync()
+		return FIFO._handleFIFOConsumeExplicit(handoff.result, handoff.pointer)
+	}
+	fileprivate borrowing func _nextExplicit(deadline:ContinuousClock.Instant) async -> FIFO.ConsumeResult {
+		let handoff = await fifo._consumeAsync(deadline:deadline)
+		return FIFO._handleFIFOConsumeExplicit(handoff.result, handoff.pointer)
 	}
 }
 extension FIFO.AsyncConsumer {
 	fileprivate borrowing func _next() async -> Result<Element?, Failure> {
-		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<Result<Element?, Failure>, Never>) in
-			var pointer:__cswiftslash_ptr_t? = nil
-			continuation.resume(returning:FIFO._handleFIFOConsume(__cswiftslash_fifo_consume_blocking(fifo.datachain_primitive_ptr, &pointer), pointer)!)
+		let handoff = await fifo._consumeAsync()
+		return FIFO._handleFIFOConsume(handoff.result, handoff.pointer)!
+	}
+	fileprivate borrowing func _next(deadline:ContinuousClock.Instant) async -> Result<Element?, Failure>? {
+		let handoff = await fifo._consumeAsync(deadline:deadline)
+		return FIFO._handleFIFOConsume(handoff.result, handoff.pointer)
+	}
+}
+
+/// the outcome of a consumption that is handed to a suspended async consumer.
+fileprivate struct FIFOHandoff:@unchecked Sendable {
+	fileprivate let result:__cswiftslash_fifo_consume_result_t
+	fileprivate let pointer:__cswiftslash_optr_t
+}
+
+/// the context that is stored in the underlying fifo while an async consumer is suspended. the FIFO is retained by this context so that it cannot be closed out from under the suspended consumer.
+/// 	- NOTE: this class is marked with `unchecked Sendable` so that it may be referenced by the shared timer that revokes it at a deadline. the continuation is resumed exactly once, by whichever of the producer or the timer removes the waiter from the underlying fifo.
+fileprivate final class FIFOAsyncWaiter:@unchecked Sendable {
+	fileprivate let continuation:UnsafeContinuation<FIFOHandoff, Never>
+	private let fifo:AnyObject
+	/// the underlying fifo that the waiter is stored in. valid for the lifetime of the waiter, since the FIFO that owns it is retained.
+	fileprivate let storedIn:UnsafeMutablePointer<__cswiftslash_fifo_linkpair_t>?
+	fileprivate init(_ continuation:UnsafeContinuation<FIFOHandoff, Never>, retaining fifo:AnyObject, storedIn:UnsafeMutablePointer<__cswiftslash_fifo_linkpair_t>? = nil) {
+		self.continuation = continuation
+		self.fifo = fifo
+		self.storedIn = storedIn
+	}
+}
+
+/// fires a suspended async consumer with the element or cap that was handed to it by the producer.
+fileprivate let fifoAsyncWaiterHandler:__cswiftslash_fifo_waiter_f = { result, pointer, ctxPtr in
+	Unmanaged<FIFOAsyncWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().continuation.resume(returning:FIFOHandoff(result:result, pointer:pointer))
+}
+
+/// revokes a suspended async consumer whose deadline has passed, resuming it with `.wouldBlock`. fired from the shared timer thread with the reference to the waiter that is held by the scheduled deadline.
+fileprivate let fifoAsyncWaiterDeadlineHandler:__cswiftslash_timer_f = { ctxPtr in
+	let asyncWaiter = Unmanaged<FIFOAsyncWaiter>.fromOpaque(ctxPtr!).takeRetainedValue()
+	guard __cswiftslash_fifo_revoke_waiter(asyncWaiter.storedIn!, ctxPtr) == true else {
+		// the waiter was resumed by the producer before the deadline.
+		return
+	}
+	// balance the retain that was held by the underlying fifo.
+	Unmanaged.passUnretained(asyncWaiter).release()
+	asyncWaiter.continuation.resume(returning:FIFOHandoff(result:__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK, pointer:nil))
+}
+
+extension FIFO {
+	/// suspends the calling task until the next element (or cap) can be handed to it. no thread is blocked while waiting - when the FIFO is empty, the continuation is stored in the underlying fifo and resumed directly by the producer that passes the next element.
+	fileprivate borrowing func _consumeAsync() async -> FIFOHandoff {
+		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<FIFOHandoff, Never>) in
+			let waiter = Unmanaged.passRetained(FIFOAsyncWaiter(continuation, retaining:self)).toOpaque()
+			var pointer:__cswiftslash_optr_t = nil
+			let result = __cswiftslash_fifo_consume_async(datachain_primitive_ptr, &pointer, fifoAsyncWaiterHandler, waiter)
+			guard result != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK else {
+				// the waiter was stored and will be resumed by the producer.
+				return
+			}
+			// the waiter was not stored, so the result can be handed to the continuation immediately.
+			_ = Unmanaged<FIFOAsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+			continuation.resume(returning:FIFOHandoff(result:result, pointer:pointer))
 		})
 	}
+
+	/// suspends the calling task until the next element (or cap) can be handed to it, or until the deadline passes. when the waiter is stored, its revocation is scheduled on the shared timer - no task or thread is dedicated to the wait. the scheduled deadline holds its own reference to the waiter, so the waiter's address cannot be reused while the revocation is pending.
+	fileprivate borrowing func _consumeAsync(deadline:ContinuousClock.Instant) async -> FIFOHandoff {
+		var scheduled:(timer:UnsafeMutablePointer<__cswiftslash_timer_entry_t>, waiter:FIFOAsyncWaiter)? = nil
+		let handoff = await withUnsafeContinuation({ (continuation:UnsafeContinuation<FIFOHandoff, Never>) in
+			let asyncWaiter = FIFOAsyncWaiter(continuation, retaining:self, storedIn:datachain_primitive_ptr)
+			let waiter = Unmanaged.passRetained(asyncWaiter).toOpaque()
+			var pointer:__cswiftslash_optr_t = nil
+			let result = __cswiftslash_fifo_consume_async(datachain_primitive_ptr, &pointer, fifoAsyncWaiterHandler, waiter)
+			guard result != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK else {
+				// the waiter was stored and will be resumed by the producer, unless it is revoked at the deadline first.
+				scheduled = (timer:__cswiftslash_timer_schedule(FIFO._monotonicDeadline(deadline), fifoAsyncWaiterDeadlineHandler, Unmanaged.passRetained(asyncWaiter).toOpaque()), waiter:asyncWaiter)
+				return
+			}
+			// the waiter was not stored, so the result can be handed to the continuation immediately.
+			_ = Unmanaged<FIFOAsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+			continuation.resume(returning:FIFOHandoff(result:result, pointer:pointer))
+		})
+		if let scheduled = scheduled, __cswiftslash_timer_cancel(scheduled.timer) == true {
+			// the deadline was cancelled before it fired, so its reference to the waiter is released here.
+			Unmanaged.passUnretained(scheduled.waiter).release()
+		}
+		return handoff
+	}
+
+	/// converts a deadline into an absolute number of nanoseconds on the clock of the shared timer, which the underlying fifo also waits against.
+	fileprivate static func _monotonicDeadline(_ deadline:ContinuousClock.Instant) -> UInt64 {
+		let (seconds, attoseconds) = ContinuousClock.now.duration(to:deadline).components
+		return __cswiftslash_timer_deadline(seconds, attoseconds)
+	}
 }
 
 extension FIFO {
-	fileprivate static func _handleFIFOConsumeExplicit(_ ret:__cswiftslash_fifo_consume_result_t, _ pointer:__cswiftslash_ptr_t?) -> ConsumeResult {
+	/// elements of a bitwise-copyable type that fit within a pointer are stored directly in the bits of the pointer that is passed into the underlying fifo, so that yielding them requires no allocation or reference counting. all other elements are stored in a retained `Contained` box.
+	internal static var _storesUnboxed:Bool {
+		return _isPOD(Element.self) && MemoryLayout<Element>.size <= MemoryLayout<UnsafeMutableRawPointer>.size
+	}
+
+	/// encodes an element into a pointer that can be passed into the underlying fifo. ownership of the element is transferred to the returned pointer.
+	internal static func _encode(_ element:consuming Element) -> __cswiftslash_optr_t {
+		guard _storesUnboxed == true else {
+			return Unmanaged.passRetained(Contained(element)).toOpaque()
+		}
+		var bits:UInt = 0
+		withUnsafeMutableBytes(of:&bits) { bitsBuffer in
+			withUnsafeBytes(of:element) { elementBuffer in
+				bitsBuffer.copyMemory(from:elementBuffer)
+			}
+		}
+		return UnsafeMutableRawPointer(bitPattern:bits)
+	}
+
+	/// decodes an element from a pointer that was consumed from the underlying fifo. ownership of the element is transferred to the caller.
+	internal static func _decode(_ pointer:__cswiftslash_optr_t) -> Element {
+		guard _storesUnboxed == true else {
+			return Unmanaged<Contained<Element>>.fromOpaque(pointer!).takeRetainedValue().value()
+		}
+		var bits = UInt(bitPattern:pointer)
+		return withUnsafeBytes(of:&bits) { bitsBuffer in
+			return bitsBuffer.load(as:Element.self)
+		}
+	}
+
+	/// decodes a copy of an element from a pointer without taking ownership of the element. the pointer remains valid after this call.
+	internal static func _peek(_ pointer:__cswiftslash_optr_t) -> Element {
+		guard _storesUnboxed == true else {
+			return Unmanaged<Contained<Element>>.fromOpaque(pointer!).takeUnretainedValue().value()
+		}
+		return _decode(pointer)
+	}
+
+	/// releases an encoded element that will never be consumed.
+	internal static func _release(_ pointer:__cswiftslash_optr_t) {
+		guard _storesUnboxed == false else {
+			return
+		}
+		_ = Unmanaged<Contained<Element>>.fromOpaque(pointer!).takeRetainedValue()
+	}
+
+	fileprivate static func _handleFIFOConsumeExplicit(_ ret:__cswiftslash_fifo_consume_result_t, _ pointer:__cswiftslash_optr_t) -> ConsumeResult {
 		switch ret {
 			case  __CSWIFTSLASH_FIFO_CONSUME_RESULT:
-				return .element(Unmanaged<Contained<Element>>.fromOpaque(pointer!).takeRetainedValue().value())
+				return .element(_decode(pointer))
 			case  __CSWIFTSLASH_FIFO_CONSUME_CAP:
 				switch Unmanaged<Contained<Result<Void, Failure>>>.fromOpaque(pointer!).takeUnretainedValue().value() {
 					case .success:
@@ -332,10 +650,10 @@ extension FIFO {
 				fatalError("SwiftSlashFIFO :: unexpected return value from _cswiftslash_fifo_consume_blocking - \(#file):\(#line)")
 		}
 	}
-	fileprivate static func _handleFIFOConsume(_ ret:__cswiftslash_fifo_consume_result_t, _ pointer:__cswiftslash_ptr_t?) -> Result<Element?, Failure>? {
+	fileprivate static func _handleFIFOConsume(_ ret:__cswiftslash_fifo_consume_result_t, _ pointer:__cswiftslash_optr_t) -> Result<Element?, Failure>? {
 		switch ret {
 			case  __CSWIFTSLASH_FIFO_CONSUME_RESULT:
-				return .success(Unmanaged<Contained<Element>>.fromOpaque(pointer!).takeRetainedValue().value())
+				return .success(_decode(pointer))
 			case  __CSWIFTSLASH_FIFO_CONSUME_CAP:
 				switch Unmanaged<Contained<Result<Void, Failure>>>.fromOpaque(pointer!).takeUnretainedValue().value() {
 					case .success:
@@ -125,18 +125,14 @@ extension Future {
 	/// - returns: a result structure representing the result of the future. `nil` is returned if the future was canceled.
 	/// - throws: this function will run the @autoclosure argument from `taskCancellationError` and throw the corresponding result if the current task was canceled while waiting for the result.
 	public func result<ErrorOnTaskCancel>(throwingOnCurrentTaskCancellation taskThrowType:ErrorOnTaskCancel.Type, taskCancellationError:@autoclosure () -> ErrorOnTaskCancel) async throws(ErrorOnTaskCancel) -> Result<Produced, Failure>? where ErrorOnTaskCancel:Swift.Error {
-		var syncResult = SyncResult()
-		var memory = __cswiftslash_future_wait_t_init_struct()
-		return try await _result_main(throwing:taskThrowType, onCurrentTaskCancellation:taskCancellationError(), memory:&memory, syncResult:&syncResult)
+		return try await _result_main(throwing:taskThrowType, onCurrentTaskCancellation:taskCancellationError())
 	}
 
 	/// wait for the result of the future. this function will not throw if the current task is canceled.
 	/// - throws: this function does NOT throw.
 	/// - returns: a result structure representing the result of the future. `nil` is returned if the future was canceled.
 	public func result(throwingOnCurrentTaskCancellation taskThrowType:Never.Type = Never.self) async -> Result<Produced, Failure>? {
-		var syncResult = SyncResult()
-		var memory = __cswiftslash_future_wait_t_init_struct()
-		return await _result_main(throwing:Never.self, onCurrentTaskCancellation:fatalError("SwiftSlashFuture :: caught trying to create an error to throw within Never type. this is an internal error. \(#file):\(#line)"), memory:&memory, syncResult:&syncResult)
+		return await _result_main(throwing:Never.self, onCurrentTaskCancellation:fatalError("SwiftSlashFuture :: caught trying to create an error to throw within Never type. this is an internal error. \(#file):\(#line)"))
 	}
 
 	/// assign a function to be called when the result of the future is known. this function may be fired immediately on the current thread or on a different thread at a later time. 
@@ -156,12 +152,8 @@ extension Future {
 			}
 		})
 
-		// copy a reference of the async result handler to new heap space so that the c code can interact with it and dereference it as needed.
-		let arPtr = UnsafeMutablePointer<AsyncResult>.allocate(capacity:1)
-		arPtr.initialize(to:asr)
-
-		// register the async handlers for the waiter of this future.
-		let waitID = __cswiftslash_future_t_wait_async(prim, arPtr, futureAsyncResultHandler, futureAsyncErrorHandler, futureAsyncCancelHandler)
+		// register the async handlers for the waiter of this future. the retained reference is released by whichever handler fires.
+		let waitID = __cswiftslash_future_t_wait_async(prim, Unmanaged.passRetained(asr).toOpaque(), futureAsyncResultHandler, futureAsyncErrorHandler, futureAsyncCancelHandler)
 		if waitID == 0 {
 			return nil
 		} else {
@@ -203,70 +195,78 @@ extension Future {
 }
 
 extension Future {
-	fileprivate borrowing func _result_main<E>(throwing _:E.Type, onCurrentTaskCancellation throwOnTaskCancellation:@autoclosure () -> E, memory:UnsafeMutablePointer<__cswiftslash_future_wait_t>, syncResult sPtr:UnsafeMutablePointer<SyncResult>) async throws(E) -> Result<Produced, Failure>? where E:Swift.Error {
-		return try await sPtr.pointee.withWaiterPrimitiveAccess { wptr throws(E) -> Result<Produced, Failure>? in
-			let waiterPtr = __cswiftslash_future_t_wait_sync_register(prim, sPtr, futureSyncResultHandler, futureSyncErrorHandler, futureSyncCancelHandler, memory)
-			if waiterPtr == nil {
-				switch sPtr.pointee.consumeResult() {
-					case .success(_, let ptr):
-						return .success(Unmanaged<Contained<Produced>>.fromOpaque(ptr!).takeUnretainedValue().value())
-					case .failure(_, let ptr):
-						return .failure(Unmanaged<Contained<Failure>>.fromOpaque(ptr!).takeUnretainedValue().value())
-					case .cancel:
-						return nil
-					case .none:
-						fatalError("invalid future status. this is an internal error. \(#file):\(#line)")
-				}
-			} else {
-				if E.self == Never.self {
-					// task cancellation is set to never, so we can just wait for the result directly from the AsyncResult without any cancellation complications.
-					await withUnsafeContinuation({ (cont:UnsafeContinuation<Void, Never>) in
-						__cswiftslash_future_t_wait_sync_block(prim, waiterPtr!)
-						cont.resume()
-					})
-
-					switch sPtr.pointee.consumeResult() {
-						case .success(_, let ptr):
-							return .success(Unmanaged<Contained<Produced>>.fromOpaque(ptr!).takeUnretainedValue().value())
-						case .failure(_, let ptr):
-							return .failure(Unmanaged<Contained<Failure>>.fromOpaque(ptr!).takeUnretainedValue().value())
-						case .cancel:
-							return nil
-						case .none:
-							fatalError("invalid future status. this is an internal error. \(#file):\(#line)")
-					}
-				} else {
-					let cancelID = __cswiftslash_future_wait_id_get(waiterPtr!)
-
-					let didCallCancellationHandler:Atomic<Bool> = .init(false)
+	/// suspends the calling task until the future is resolved or the waiter is invalidated. no thread is blocked while waiting - the continuation is stored in the underlying future and resumed directly by the thread that resolves it.
+	fileprivate borrowing func _awaitResolution(_ waiter:AsyncResultWaiter) async -> SuccessFailureCancel {
+		return await withUnsafeContinuation({ (continuation:UnsafeContinuation<SuccessFailureCancel, Never>) in
+			waiter.continuation = continuation
+			// the retained reference is released by whichever handler fires. if the future is already resolved, a handler fires before this call returns.
+			let waitID = __cswiftslash_future_t_wait_async(prim, Unmanaged.passRetained(waiter).toOpaque(), futureWaiterResultHandler, futureWaiterErrorHandler, futureWaiterCancelHandler)
+			guard waitID != 0 else {
+				return
+			}
+			waiter.waiterID.store(waitID, ordering:.sequentiallyConsistent)
+			// the cancellation handler may have run before the waiter identifier was known.
+			if waiter.cancelRequested.load(ordering:.sequentiallyConsistent) == true {
+				__cswiftslash_future_t_wait_async_invalidate(prim, waitID)
+			}
+		})
+	}
 
-					// task cancellation is set to throw, so we need to wait for the result within a cancellation handler.
-					await withTaskCancellationHandler {
-						await withUnsafeContinuation({ (cont:UnsafeContinuation<Void, Never>) in
-							__cswiftslash_future_t_wait_sync_block(prim, waiterPtr!)
-							cont.resume()
-						})
-					} onCancel: {
-						didCallCancellationHandler.store(true, ordering:.releasing)
-						__cswiftslash_future_wait_sync_invalidate(prim, cancelID)
-					}
+	/// reads the result of a future that is already resolved without suspending.
+	/// - returns: the resolution of the future, or nil if the future is still pending.
+	internal borrowing func _resolvedResult() -> SuccessFailureCancel? {
+		guard __cswiftslash_future_t_has_result(prim) == true else {
+			return nil
+		}
+		var getResult = SyncResult()
+		withUnsafeMutablePointer(to:&getResult) { rptr in
+			var memory = __cswiftslash_future_wait_t_init_struct()
+			// a resolved future fires the handlers from the calling thread and never stores the waiter.
+			guard __cswiftslash_future_t_wait_sync_register(prim, rptr, futureSyncResultHandler, futureSyncErrorHandler, futureSyncCancelHandler, &memory) == nil else {
+				fatalError("swiftslash - resolved future stored a waiter - \(#file):\(#line)")
+			}
+		}
+		return getResult.consumeResult()
+	}
 
-					switch sPtr.pointee.consumeResult() {
-						case .success(_, let ptr):
-							return .success(Unmanaged<Contained<Produced>>.fromOpaque(ptr!).takeUnretainedValue().value())
-						case .failure(_, let ptr):
-							return .failure(Unmanaged<Contained<Failure>>.fromOpaque(ptr!).takeUnretainedValue().value())
-						case .cancel:
-							if didCallCancellationHandler.load(ordering:.acquiring) {
-								throw throwOnTaskCancellation()
-							} else {
-								return nil
-							}
-						case .none:
-							fatalError("invalid future status. this is an internal error. \(#file):\(#line)")
-					}
+	fileprivate borrowing func _result_main<E>(throwing _:E.Type, onCurrentTaskCancellation throwOnTaskCancellation:@autoclosure () -> E) async throws(E) -> Result<Produced, Failure>? where E:Swift.Error {
+		let resolution:SuccessFailureCancel
+		var cancelRequested = false
+		if let resolved = _resolvedResult() {
+			resolution = resolved
+		} else if E.self == Never.self {
+			// task cancellation is set to never, so the result can be awaited directly without any cancellation complications.
+			resolution = await _awaitResolution(AsyncResultWaiter())
+		} else {
+			// task cancellation is set to throw, so the waiter is invalidated when the current task is cancelled.
+			let waiter = AsyncResultWaiter()
+			resolution = await withTaskCancellationHandler {
+				await _awaitResolution(waiter)
+			} onCancel: {
+				waiter.cancelRequested.store(true, ordering:.sequentiallyConsistent)
+				let waitID = waiter.waiterID.load(ordering:.sequentiallyConsistent)
+				if waitID != 0 {
+					__cswiftslash_future_t_wait_async_invalidate(prim, waitID)
 				}
 			}
+			cancelRequested = waiter.cancelRequested.load(ordering:.acquiring)
 		}
-	}		
-}
+		if case .cancel = resolution, cancelRequested == true {
+			throw throwOnTaskCancellation()
+		}
+		return Self._decode(resolution)
+	}
+
+	/// converts the resolution of a future into its swift result.
+	/// - returns: the result of the future, or nil if the future was canceled.
+	internal static func _decode(_ resolution:consuming SuccessFailureCancel) -> Result<Produced, Failure>? {
+		switch resolution {
+			case .success(_, let ptr):
+				return .success(Unmanaged<Contained<Produced>>.fromOpaque(ptr!).takeUnretainedValue().value())
+			case .failure(_, let ptr):
+				return .failure(Unmanaged<Contained<Failure>>.fromOpaque(ptr!).takeUnretainedValue().value())
+			case .cancel:
+				return nil
+		}
+	}
+}
\ No newline at end of file
@@ -17,89 +17,56 @@ import SwiftSlashContained
 /// - NOTE: this type is designed with the HARD REQUIREMENT that with each initialization, a corresponding result must be set into each instance before complete dereferencing.
 internal final class AsyncResult:@unchecked Sendable {
 	internal typealias UniHandler = @Sendable (SuccessFailureCancel) -> Void
-	private struct Memory:~Copyable {
-		// used as a guard to ensure that the result is only set once.
-		internal let hasResult:Atomic<Bool> = .init(false)
-		// this lock is used to block a single waiter until the intevitable result is set.
-		internal var resultWaiterLock:pthread_mutex_t = pthread_mutex_t()
 
-		internal var unihandler:UniHandler?
+	// used as a guard to ensure that the result is only set once.
+	private let hasResult:Atomic<Bool> = .init(false)
 
-		internal init(handler:@escaping UniHandler) {
-			pthread_mutex_init(&resultWaiterLock, nil)
-			// there is no result yet so anyone coming in looking for a result needs to block immediately.
-			// this AsyncResult is designed with the HARD REQUIREMENT that with each initialization, a corresponding result must be set into each instance before complete dereferencing. as such, we can trust that this lock will be balanced at result time.
-			pthread_mutex_lock(&resultWaiterLock)
-			unihandler = handler
-		}
-		internal init() {
-			pthread_mutex_init(&resultWaiterLock, nil)
-			// there is no result yet so anyone coming in looking for a result needs to block immediately.
-			// this AsyncResult is designed with the HARD REQUIREMENT that with each initialization, a corresponding result must be set into each instance before complete dereferencing. as such, we can trust that this lock will be balanced at result time.
-			pthread_mutex_lock(&resultWaiterLock)
-			unihandler = nil
-		}
-		internal mutating func fireUniHandler(_ result:SuccessFailureCancel) {
-			if unihandler != nil {
-				unihandler!(result)
-				unihandler = nil
-			}
-			pthread_mutex_unlock(&resultWaiterLock)
-		}
-		internal func tryAssignResult() -> Bool {
-			return hasResult.compareExchange(expected:false, desired:true, successOrdering:.acquiringAndReleasing, failureOrdering:.relaxed).exchanged
-		}
-		internal mutating func exclusiveWait() {
-			pthread_mutex_lock(&resultWaiterLock)
-		}
-		deinit {
-			guard hasResult.load(ordering:.acquiring) == true else {
-				fatalError("invalid state for future result setting. \(#file):\(#line)")
-			}
-			var mutex = resultWaiterLock
-			pthread_mutex_unlock(&mutex)
-			pthread_mutex_destroy(&mutex)
-		}
-	}
-
-	private let workingMemory:UnsafeMutablePointer<Memory> = .allocate(capacity:1)
+	// the handler that is fired with the result. this is released as soon as it is fired.
+	private var unihandler:UniHandler?
 
 	internal init(handle:consuming @escaping UniHandler) {
-		workingMemory.initialize(to:.init(handler:handle))
+		unihandler = handle
 	}
 
-	internal init() {
-		workingMemory.initialize(to:.init())
+	private borrowing func fire(_ result:consuming SuccessFailureCancel) {
+		guard hasResult.compareExchange(expected:false, desired:true, successOrdering:.acquiringAndReleasing, failureOrdering:.relaxed).exchanged == true else {
+			fatalError("invalid state for future result setting. \(#file):\(#line)")
+		}
+		let handler = unihandler!
+		unihandler = nil
+		handler(result)
 	}
 
 	internal borrowing func setResult(type:consuming UInt8, pointer:consuming UnsafeMutableRawPointer?) {
-		guard workingMemory.pointee.tryAssignResult() == true else {
-			fatalError("invalid state for future result setting. \(#file):\(#line)")
-		}
-		workingMemory.pointee.fireUniHandler(.success(type, pointer))
+		fire(.success(type, pointer))
 	}
 	internal borrowing func setError(type:consuming UInt8, pointer:consuming UnsafeMutableRawPointer?) {
-		guard workingMemory.pointee.tryAssignResult() == true else {
-			fatalError("invalid state for future result setting. \(#file):\(#line)")
-		}
-		workingMemory.pointee.fireUniHandler(.failure(type, pointer))
+		fire(.failure(type, pointer))
 	}
 	internal borrowing func setCancel() {
-		guard workingMemory.pointee.tryAssignResult() == true else {
-			fatalError("invalid state for future result setting. \(#file):\(#line)")
-		}
-		workingMemory.pointee.fireUniHandler(.cancel)
-	}
-	internal borrowing func exclusiveWait() {
-		return workingMemory.pointee.exclusiveWait()
+		fire(.cancel)
 	}
 
 	deinit {
-		guard workingMemory.pointee.hasResult.load(ordering:.acquiring) == true else {
+		guard hasResult.load(ordering:.acquiring) == true else {
 			fatalError("invalid state for future result setting. \(#file):\(#line)")
 		}
+	}
+}
+
+/// the context that is stored in the underlying future while an async task is suspended waiting for its result. the continuation is resumed directly by the thread that resolves the future (or invalidates the waiter), so no thread is blocked while waiting.
+internal final class AsyncResultWaiter:@unchecked Sendable {
+	/// the continuation of the suspended task. this is assigned before the waiter is registered with the future.
+	internal var continuation:UnsafeContinuation<SuccessFailureCancel, Never>? = nil
+	/// the unique identifier of the waiter within the future. zero until the waiter is registered.
+	internal let waiterID:Atomic<UInt64> = .init(0)
+	/// set when the waiting task is cancelled, so that a registration that completes after the cancellation handler runs can invalidate itself.
+	internal let cancelRequested:Atomic<Bool> = .init(false)
+
+	internal init() {}
 
-		workingMemory.deinitialize(count:1)
-		workingMemory.deallocate()
+	/// resumes the suspended task with the result that was handed to the waiter.
+	internal borrowing func resume(_ result:consuming SuccessFailureCancel) {
+		continuation!.resume(returning:result)
 	}
 }
\ No newline at end of file
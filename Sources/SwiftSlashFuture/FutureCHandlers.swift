@@ -32,22 +32,26 @@ internal let futureSyncCancelHandler:__cswiftslash_future_result_cncl_handler_f
 
 /// the async handler for results
 internal let futureAsyncResultHandler:__cswiftslash_future_result_val_handler_f = { resType, resPtr, ctxPtr in
-	let boundPtr = ctxPtr!.assumingMemoryBound(to:AsyncResult.self)
-	boundPtr.pointee.setResult(type:resType, pointer:resPtr)
-	boundPtr.deinitialize(count:1)
-	boundPtr.deallocate()
+	Unmanaged<AsyncResult>.fromOpaque(ctxPtr!).takeRetainedValue().setResult(type:resType, pointer:resPtr)
 }
 /// the async handler for errors
 internal let futureAsyncErrorHandler:__cswiftslash_future_result_err_handler_f = { errType, errPtr, ctxPtr in
-	let boundPtr = ctxPtr!.assumingMemoryBound(to:AsyncResult.self)
-	boundPtr.pointee.setError(type:errType, pointer:errPtr)
-	boundPtr.deinitialize(count:1)
-	boundPtr.deallocate()
+	Unmanaged<AsyncResult>.fromOpaque(ctxPtr!).takeRetainedValue().setError(type:errType, pointer:errPtr)
 }
 /// the async handler for cancellations
 internal let futureAsyncCancelHandler:__cswiftslash_future_result_cncl_handler_f = { ctxPtr in
-	let boundPtr = ctxPtr?.assumingMemoryBound(to:AsyncResult.self)
-	boundPtr?.pointee.setCancel()
-	boundPtr?.deinitialize(count:1)
-	boundPtr?.deallocate()
+	Unmanaged<AsyncResult>.fromOpaque(ctxPtr!).takeRetainedValue().setCancel()
+}
+
+/// the suspended task handler for results
+internal let futureWaiterResultHandler:__cswiftslash_future_result_val_handler_f = { resType, resPtr, ctxPtr in
+	Unmanaged<AsyncResultWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().resume(.success(resType, resPtr))
+}
+/// the suspended task handler for errors
+internal let futureWaiterErrorHandler:__cswiftslash_future_result_err_handler_f = { errType, errPtr, ctxPtr in
+	Unmanaged<AsyncResultWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().resume(.failure(errType, errPtr))
+}
+/// the suspended task handler for cancellations
+internal let futureWaiterCancelHandler:__cswiftslash_future_result_cncl_handler_f = { ctxPtr in
+	Unmanaged<AsyncResultWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().resume(.cancel)
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import __cswiftslash_future
+import __cswiftslash_timer
+import Synchronization
+
+/// thrown when waiting on one or more futures ends before the futures are resolved.
+public enum FutureWaitError:Swift.Error {
+	/// the timeout of the wait elapsed before the futures were resolved.
+	case timedOut
+	/// the waiting task was cancelled before the futures were resolved.
+	case taskCancelled
+}
+
+/// the context that is stored in a countdown while a task is suspended waiting on a set of futures. the continuation is resumed directly by the thread that completes (or cancels) the countdown.
+internal final class CountdownWaiter:@unchecked Sendable {
+	/// the continuation of the suspended task. this is assigned before the countdown is created.
+	internal var continuation:UnsafeContinuation<Int, Never>? = nil
+	/// the countdown that the task is waiting on (nil until the countdown is created, and nil again once it is released), and whether the wait has been interrupted. the two are guarded together so that an interruption from the timer thread can never reach a countdown that is being released.
+	private let state:Mutex<(countdown:UnsafeMutablePointer<__cswiftslash_future_countdown_t>?, interrupted:Bool)> = .init((countdown:nil, interrupted:false))
+	/// set when the wait was interrupted by its timeout.
+	internal let timedOut:Atomic<Bool> = .init(false)
+
+	internal init() {}
+
+	/// stores the countdown that the task is waiting on. the countdown is cancelled immediately if the wait was interrupted before it existed.
+	internal borrowing func install(_ countdown:UnsafeMutablePointer<__cswiftslash_future_countdown_t>) {
+		state.withLock { state in
+			state.countdown = countdown
+			if state.interrupted == true {
+				__cswiftslash_future_countdown_cancel(countdown)
+			}
+		}
+	}
+
+	/// ends the wait before enough futures are resolved.
+	internal borrowing func interrupt() {
+		state.withLock { state in
+			state.interrupted = true
+			if let countdown = state.countdown {
+				__cswiftslash_future_countdown_cancel(countdown)
+			}
+		}
+	}
+
+	/// releases the countdown once the task has resumed. interruptions that arrive after this are ignored.
+	internal borrowing func release() {
+		state.withLock { state in
+			// the handler has already fired (the task only resumes once it does), so releasing the countdown never calls back into the waiter.
+			__cswiftslash_future_countdown_release(state.countdown!)
+			state.countdown = nil
+		}
+	}
+}
+
+/// fires a suspended task with the index of the future that completed its countdown. a cancelled countdown passes `SIZE_MAX`, which is imported as a negative index.
+internal let futureCountdownHandler:__cswiftslash_future_countdown_f = { index, ctxPtr in
+	Unmanaged<CountdownWaiter>.fromOpaque(ctxPtr!).takeRetainedValue().continuation!.resume(returning:index)
+}
+
+/// interrupts a wait whose timeout has elapsed. fired from the shared timer thread with the reference to the waiter that is held by the scheduled deadline.
+internal let futureCountdownDeadlineHandler:__cswiftslash_timer_f = { ctxPtr in
+	let waiter = Unmanaged<CountdownWaiter>.fromOpaque(ctxPtr!).takeRetainedValue()
+	waiter.timedOut.store(true, ordering:.sequentiallyConsistent)
+	waiter.interrupt()
+}
+
+extension Future {
+	/// wait for every one of the specified futures to be resolved. the futures share a single countdown waiter, so the wait costs one task suspension regardless of the number of futures.
+	/// - parameters:
+	///		- futures: the futures to wait for.
+	/// - returns: the results of the futures, in the order that the futures were passed. `nil` is returned in place of any future that was canceled.
+	/// - throws: `FutureWaitError.taskCancelled` if the current task is cancelled before every future is resolved.
+	public static func whenAll(_ futures:consuming [Future<Produced, Failure>]) async throws(FutureWaitError) -> [Result<Produced, Failure>?] {
+		if futures.isEmpty == false {
+			_ = try await _countdown(futures, threshold:futures.count, timeout:nil)
+		}
+		return futures.map { Self._decode($0._resolvedResult()!) }
+	}
+
+	/// wait for the first of the specified futures to be resolved. the futures share a single countdown waiter, so the wait costs one task suspension regardless of the number of futures.
+	/// - parameters:
+	///		- futures: the futures to wait for. this must not be empty.
+	/// - returns: the index of the first future that was resolved, along with its result. the result is `nil` if that future was canceled.
+	/// - throws: `FutureWaitError.taskCancelled` if the current task is cancelled before any future is resolved.
+	public static func whenAny(_ futures:consuming [Future<Produced, Failure>]) async throws(FutureWaitError) -> (index:Int, result:Result<Produced, Failure>?) {
+		guard futures.isEmpty == false else {
+			fatalError("swiftslash - whenAny requires at least one future - \(#file):\(#line)")
+		}
+		let index = try await _countdown(futures, threshold:1, timeout:nil)
+		return (index:index, result:Self._decode(futures[index]._resolvedResult()!))
+	}
+
+	/// wait for the result of the future, giving up after the specified timeout.
+	/// - parameters:
+	///		- timeout: the longest duration to wait for the result.
+	/// - returns: a result structure representing the result of the future. `nil` is returned if the future was canceled.
+	/// - throws: `FutureWaitError.timedOut` if the timeout elapses before the future is resolved. `FutureWaitError.taskCancelled` if the current task is cancelled before the future is resolved.
+	public func result(timeout:Duration) async throws(FutureWaitError) -> Result<Produced, Failure>? {
+		if let resolved = _resolvedResult() {
+			return Self._decode(resolved)
+		}
+		_ = try await Self._countdown([self], threshold:1, timeout:timeout)
+		return Self._decode(_resolvedResult()!)
+	}
+
+	/// suspends the calling task until the threshold number of futures are resolved, the timeout elapses, or the task is cancelled. the timeout is scheduled on the shared timer, so no task or thread is dedicated to it.
+	/// - returns: the index of the future whose resolution completed the countdown.
+	fileprivate static func _countdown(_ futures:borrowing [Future<Produced, Failure>], threshold:Int, timeout:Duration?) async throws(FutureWaitError) -> Int {
+		let waiter = CountdownWaiter()
+		let prims = futures.map { $0.prim }
+		// the scheduled deadline holds its own reference to the waiter until it is fired or cancelled.
+		let timer = timeout.map { __cswiftslash_timer_schedule(Self._timerDeadline($0), futureCountdownDeadlineHandler, Unmanaged.passRetained(waiter).toOpaque()) }
+		let index = await withTaskCancellationHandler {
+			await withUnsafeContinuation({ (continuation:UnsafeContinuation<Int, Never>) in
+				waiter.continuation = continuation
+				// the retained reference is released by the countdown handler. the handler may fire before the countdown is returned if enough futures are already resolved.
+				let countdown = prims.withUnsafeBufferPointer { buffer in
+					__cswiftslash_future_countdown_init(buffer.baseAddress!, buffer.count, threshold, futureCountdownHandler, Unmanaged.passRetained(waiter).toOpaque())
+				}
+				waiter.install(countdown)
+			})
+		} onCancel: {
+			waiter.interrupt()
+		}
+		if let timer = timer, __cswiftslash_timer_cancel(timer) == true {
+			// the deadline was cancelled before it fired, so its reference to the waiter is released here.
+			Unmanaged.passUnretained(waiter).release()
+		}
+		// a deadline that is firing concurrently is serialized against the release by the waiter.
+		waiter.release()
+		guard index >= 0 else {
+			if waiter.timedOut.load(ordering:.acquiring) == true {
+				throw FutureWaitError.timedOut
+			}
+			throw FutureWaitError.taskCancelled
+		}
+		return index
+	}
+
+	/// converts a timeout into an absolute deadline on the clock of the shared timer.
+	fileprivate static func _timerDeadline(_ timeout:Duration) -> UInt64 {
+		let (seconds, attoseconds) = timeout.components
+		return __cswiftslash_timer_deadline(seconds, attoseconds)
+	}
+}
\ No newline at end of file
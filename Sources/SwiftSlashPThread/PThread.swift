@@ -16,20 +16,61 @@ import Synchronization
 
 // this file articulates a lot of unsafe and unbalanced memory management. the scope of the unsafety is limited to this single file, therefore, any possible errors or mishandlings of the memory should be visible from this file alone. the file consists of mostly private and fileprivate functions, with only a small handful of public/internal entrypoints being provided.
 
-/// runs any given arbitrary function on a newly created pthread.
+/// the configuration that the shared worker pool starts with, and whether it has started. the configuration can only be changed before the pool starts.
+fileprivate let sharedWorkerPoolConfiguration:Mutex<(configuration:PThreadPoolConfiguration, started:Bool)> = .init((configuration:PThreadPoolConfiguration(), started:false))
+
+/// the process-wide pool of pthreads that runs work launched with `run` and `launch`. sized to the number of online processors unless configured otherwise, and grows with overflow workers whenever every worker is busy.
+fileprivate let sharedWorkerPool:UnsafeMutablePointer<__cswiftslash_threads_pool_t> = {
+	let configuration = sharedWorkerPoolConfiguration.withLock { state in
+		state.started = true
+		return state.configuration
+	}
+	guard let pool = __cswiftslash_threads_pool_init(configuration.workers ?? 0, configuration.stackSize ?? 0) else {
+		fatalError("SwiftSlashPThread: unable to start the pthread worker pool. \(#file):\(#line)")
+	}
+	return pool
+}()
+
+extension PThreadPoolConfiguration {
+	/// configures the shared worker pool. call this before any work is launched on the pool, since the pool starts its workers with the configuration it holds when it is first used.
+	/// - returns: false if the pool has already started, or if the configuration holds a value that is not positive. the configuration is not applied in either case.
+	public static func configure(_ configuration:PThreadPoolConfiguration) -> Bool {
+		guard configuration.isRepresentable == true else {
+			return false
+		}
+		return sharedWorkerPoolConfiguration.withLock { state in
+			guard state.started == false else {
+				return false
+			}
+			state.configuration = configuration
+			return true
+		}
+	}
+}
+
+/// runs any given arbitrary function on a pthread from the shared worker pool.
 public func run<R>(_ work:consuming @escaping @Sendable () throws -> R) async throws(PThreadLaunchFailure) -> Result<R, Swift.Error>? where R:Sendable {
 	let launchedThread = try GenericPThread.launch(work)
 	return await launchedThread.workResult()
 }
 
-/// launch a pthread with a given function and return the running pthread.
+/// launch a given function on a pthread from the shared worker pool and return the running pthread.
 public func launch<R>(_ work:consuming @escaping @Sendable () throws -> R) throws(PThreadLaunchFailure) -> Running<GenericPThread<R>> where R:Sendable {
 	return try GenericPThread.launch(work)
 }
 
 extension PThreadWork {
+	/// launch the work on a pthread from the shared worker pool. use this for work that finishes on its own.
 	public static func launch(_ arg:consuming ArgumentType) throws(PThreadLaunchFailure) -> Running<Self> {
-		return try launchPThread(work:Self.self, argument:arg).get()
+		return try launchPThread(work:Self.self, argument:arg, dedicated:false, options:PThreadLaunchOptions()).get()
+	}
+	/// launch the work with the given thread attributes. work with any non-default option runs on a dedicated pthread, since a pooled pthread cannot take on per-work attributes.
+	public static func launch(_ arg:consuming ArgumentType, options:PThreadLaunchOptions) throws(PThreadLaunchFailure) -> Running<Self> {
+		return try launchPThread(work:Self.self, argument:arg, dedicated:options.isDefault == false, options:options).get()
+	}
+	/// launch the work on a newly created pthread that is not part of the shared worker pool. use this for work that runs for the lifetime of its owner, so that it does not hold a pool worker.
+	public static func launchDedicated(_ arg:consuming ArgumentType, options:PThreadLaunchOptions = PThreadLaunchOptions()) throws(PThreadLaunchFailure) -> Running<Self> {
+		return try launchPThread(work:Self.self, argument:arg, dedicated:true, options:options).get()
 	}
 	public static func run(_ arg:consuming ArgumentType) async throws -> Result<ReturnType, ThrowType>? {
 		let launched = try Self.launch(arg)
@@ -69,9 +110,7 @@ fileprivate struct Workspace {
 	private var workspaceInstance:any PThreadWork
 	/// the type of workspace that is being used in the pthread.
 	private let workspaceType:any PThreadWork.Type
-	/// the future for pthread configuration. this is set to success when the pthread is configured, running its work, and ready to be canceled. after a result is passed into the return future, this future is set to nil.
-	private let configureFuture:Future<UnsafeMutableRawPointer, Never>
-	/// the future that will be set after the work result is returned.
+	/// the future that will be set after the work result is returned. it is created by the launching thread, so that the running job can be handed back before a pthread picks the work up.
 	private let returnFuture:Future<UnsafeMutableRawPointer, Never>
 
 	// call this from within the pthread. this will initialize the workspace for the work that is about to begin on the pthread.
@@ -80,29 +119,17 @@ fileprivate struct Workspace {
 	) {
 		workspaceInstance = setup.thread_worktype.init(setup.containedArg)
 		workspaceType = setup.thread_worktype
-		configureFuture = setup.configureFuture
-		returnFuture = setup.thread_worktype.buildReturnFuture()
+		returnFuture = setup.returnFuture
 	}
 
 	// assign cancellation values to the relevant futures.
 	fileprivate func setCancellation() {
 		// set the return future to a failure error that is aproprate for cancellation.
 		try? returnFuture.cancel()		// this try may fail because its theoretically possible that the work returns an instant moment before this is called.
-
-		try? configureFuture.cancel()	// this may not fail because its presumed that if configureFuture is not already nil, then it is a valid future that must be set.
-	}
-
-	// set the configuration future to success.
-	private func setSuccessfulConfiguration() {
-		// set the configure future to success.
-		try! configureFuture.setSuccess(Unmanaged.passRetained(returnFuture).toOpaque())
 	}
 
 	// run the work and have it pass the result into the return future.
 	fileprivate mutating func work() {
-		// set the configuration future to success.
-		setSuccessfulConfiguration()
-
 		// run the work and have it pass the result into the return future. in a successful case, this will pass a retained instance of Contained<ReturnType> into the return future.
 		workspaceInstance.firePThreadWork(into:returnFuture)
 	}
@@ -112,8 +139,8 @@ fileprivate struct Workspace {
 fileprivate struct Setup {
 	// a pointer to the contained argument
 	fileprivate let containedArg:UnsafeMutableRawPointer
-	// a pthread takes time to launch and configure itself before we can allow it to be canceled. this future will be set to success when the pthread is ready to be canceled.
-	fileprivate let configureFuture:Future<UnsafeMutableRawPointer, Never>
+	// the future that the work passes its result into.
+	fileprivate let returnFuture:Future<UnsafeMutableRawPointer, Never>
 	// the type of pthread work to execute. this informs the pthread launch what kind of memory and work needs to be done.
 	fileprivate let thread_worktype:any PThreadWork.Type
 
@@ -121,11 +148,11 @@ fileprivate struct Setup {
 	fileprivate init<P>(
 		_ _:P.Type,
 		containedArgument:UnsafeMutableRawPointer,
-		configureFuture:Future<UnsafeMutableRawPointer, Never>
+		returnFuture:Future<UnsafeMutableRawPointer, Never>
 	) where P:PThreadWork {
 		self.containedArg = containedArgument
 		self.thread_worktype = P.self
-		self.configureFuture = configureFuture
+		self.returnFuture = returnFuture
 	}
 }
 
@@ -143,18 +170,18 @@ fileprivate enum CloseOut:UInt8, AtomicRepresentable {
 
 /// a Sendable class that encompasses a running pthread. this structure is responsible for ensuring that the pthread is joined and that the memory is properly managed between the running memory space and the calling memory space.
 public final class Running<W>:@unchecked Sendable where W:PThreadWork {
-	// the pthread primitive
-	private let ptp:__cswiftslash_threads_t_type
+	// the job primitive. cancelling and joining go through the job rather than the pthread, since a pooled pthread goes on to run other work after this job is done.
+	private let job:UnsafeMutablePointer<__cswiftslash_threads_job_t>
 	// the future that will be set to success when the pthread is launched.
 	private let returnFuture:Future<UnsafeMutableRawPointer, Never>
 	// documents the current state of the running pthread
 	private let state:Atomic<CloseOut> = .init(CloseOut.threadRunning)
 
 	fileprivate init(
-		alreadyLaunched pthread:__cswiftslash_threads_t_type,
+		alreadyLaunched launchedJob:UnsafeMutablePointer<__cswiftslash_threads_job_t>,
 		returnFuture rf:consuming Future<UnsafeMutableRawPointer, Never>
 	) {
-		ptp = pthread
+		job = launchedJob
 		returnFuture = rf
 		returnFuture.whenResult { [weak self] resultPtr in
 			let loaded = self?.state.load(ordering:.acquiring)
@@ -199,9 +226,7 @@ public final class Running<W>:@unchecked Sendable where W:PThreadWork {
 	public borrowing func cancel() throws(PThreadCancellationFailure) {
 		switch state.compareExchange(expected:.threadRunning, desired:.threadCancelled, ordering:.acquiringAndReleasing) {
 			case (true, _):
-				guard pthread_cancel(ptp) == 0 else {
-					fatalError("SwiftSlashPThread: pthread_cancel failed. this is a critical error. \(#file):\(#line)")
-				}
+				__cswiftslash_threads_job_cancel(job)
 			case (false, .threadExited):
 				return
 			case (false, .threadCancelled):
@@ -224,9 +249,7 @@ public final class Running<W>:@unchecked Sendable where W:PThreadWork {
 			throw PThreadJoinFailure()
 		}
 		// join the pthread
-		guard pthread_join(ptp, nil) == 0 else {
-			fatalError("SwiftSlashPThread: pthread_join failed. this is a critical error. \(#file):\(#line)")
-		}
+		__cswiftslash_threads_job_join(job)
 		guard state.compareExchange(expected:.threadExited, desired:.threadJoined, ordering:.acquiringAndReleasing).0 == true else {
 			fatalError("SwiftSlashPThread: pthread_join failed. this is a critical error. \(#file):\(#line)")
 		}
@@ -239,9 +262,7 @@ public final class Running<W>:@unchecked Sendable where W:PThreadWork {
 		await withUnsafeContinuation({ (cont:UnsafeContinuation<Void, Never>) in
 			withUnsafeMutablePointer(to:&self) { (selfPtr:UnsafeMutablePointer<Running<W>>) in
 				// join the pthread
-				guard pthread_join(selfPtr.pointee.ptp, nil) == 0 else {
-					fatalError("SwiftSlashPThread: pthread_join failed. this is a critical error. \(#file):\(#line)")
-				}
+				__cswiftslash_threads_job_join(selfPtr.pointee.job)
 				guard state.compareExchange(expected:.threadExited, desired:.threadJoined, ordering:.acquiringAndReleasing).0 == true else {
 					fatalError("SwiftSlashPThread: pthread_join atomic operations tripped. this is a critical error. \(#file):\(#line)")
 				}
@@ -267,60 +288,66 @@ public final class Running<W>:@unchecked Sendable where W:PThreadWork {
 			// the thread has already been joined. we need to do nothing.
 			break
 		}
+		__cswiftslash_threads_job_destroy(job)
 	}
 }
 
 /// primary pthread wrap implementation. this is the primary way that the pthread is launched and ran in a fully memory-safe way with Swift.
 /// - parameter work: the type of work that is being done on the pthread.
 /// - parameter argument: the argument that is being passed into the work function.
-/// - returns: the running pthread that is being launched.
+/// - parameter dedicated: when true, the work runs on a newly created pthread. otherwise it runs on the shared worker pool.
+/// - parameter options: the thread attributes to create a dedicated pthread with. ignored for pooled work.
+/// - returns: the running job as soon as it is submitted. the caller does not wait for a pthread to pick the work up, so launching onto a saturated pool (including from a job that is running on the pool) never blocks. a job that is cancelled before it starts runs its cancellation and deallocation as soon as it is picked up.
 /// - throws: a LaunchFailure error if the pthread fails to launch.
-@available(*, noasync, message:"this function launches a pthread and waits for the pthread to begin working. this requires blocking, which is not allowed in swift async code.")
-fileprivate func launchPThread<W, A>(work _:W.Type, argument:A) -> Result<Running<W>, PThreadLaunchFailure> where W:PThreadWork, W.ArgumentType == A {
-	// this is the future that represents a successful launch and configuration of a pthread. pthreads must be configured for proper handling of cancellation in order to not leak memory.
-	let configureFuture = Future<UnsafeMutableRawPointer, Never>(successfulResultDeallocator: { ptr in
-		// free the retained future from memory.
-		_ = Unmanaged<Future<UnsafeMutableRawPointer, Never>>.fromOpaque(ptr).takeRetainedValue()
-	})
+fileprivate func launchPThread<W, A>(work _:W.Type, argument:A, dedicated:Bool, options:PThreadLaunchOptions) -> Result<Running<W>, PThreadLaunchFailure> where W:PThreadWork, W.ArgumentType == A {
+	// reject options that a thread configuration cannot hold before any memory is handed off.
+	guard dedicated == false || options.isRepresentable == true else {
+		return .failure(PThreadLaunchFailure())
+	}
 
-	// define the memoryspace where we will store the setup structure for the pthread.
+	// the future that the work passes its result into. the running job holds it from the moment the work is submitted.
+	let returnFuture = W.buildReturnFuture()
+
+	// define the memoryspace where we will store the setup structure for the pthread. the job owns this memory once it is launched, and the allocator function frees it when the work is picked up (which every launched job is, even one that is cancelled first).
 	let launchStructure = UnsafeMutablePointer<Setup>.allocate(capacity:1)
-	launchStructure.initialize(to:Setup(W.self, containedArgument:Unmanaged.passRetained(Contained(argument)).toOpaque(), configureFuture:configureFuture))
-	defer {
-		launchStructure.deinitialize(count:1)
-		launchStructure.deallocate()
-	}
+	launchStructure.initialize(to:Setup(W.self, containedArgument:Unmanaged.passRetained(Contained(argument)).toOpaque(), returnFuture:returnFuture))
 
 	// launch the pthread, verify the results are successful.
-	var launchResult:Int32 = -1
-	let pthr = __cswiftslash_threads_config_run(
-		__cswiftslash_threads_config_init(
-			launchStructure,
-			_run_alloc,
-			_run_main,
-			_run_cancel,
-			_run_dealloc
-		),
-		&launchResult
+	let config = __cswiftslash_threads_config_init(
+		launchStructure,
+		_run_alloc,
+		_run_main,
+		_run_cancel,
+		_run_dealloc
 	)
-	guard launchResult == 0 else {
+	var launchResult:Int32 = -1
+	let launchedJob:UnsafeMutablePointer<__cswiftslash_threads_job_t>?
+	if dedicated == true {
+		options.apply(to:config)
+		launchedJob = __cswiftslash_threads_job_launch_dedicated(config, &launchResult)
+	} else {
+		launchedJob = __cswiftslash_threads_pool_submit(sharedWorkerPool, config)
+		launchResult = 0
+	}
+	guard launchResult == 0, let launchedJob else {
 		// balance the retained value that was passed into the pthread setup but not used due to the pthread launch failure.
 		_ = Unmanaged<Contained<A>>.fromOpaque(launchStructure.pointee.containedArg).takeRetainedValue()
+		launchStructure.deinitialize(count:1)
+		launchStructure.deallocate()
 		// throw a launch failure error.
 		return .failure(PThreadLaunchFailure())
 	}
-
-	// wait for the pthread to be configured and ready to be canceled.
-	let returnFutureOpaque = configureFuture.blockingResult()!.get()
-	let returnFuture = Unmanaged<Future<UnsafeMutableRawPointer, Never>>.fromOpaque(returnFutureOpaque).takeUnretainedValue()
-	return .success(Running(alreadyLaunched:pthr, returnFuture:returnFuture))
+	return .success(Running(alreadyLaunched:launchedJob, returnFuture:returnFuture))
 }
 
 // below are the four "pillar functions" that allow for seamless and tightly integrated pthread tasks.
 /// allocator function. responsible for initializing the workspace and transferring the crucial memory from the Setup.
 fileprivate let _run_alloc:@convention(c) (__cswiftslash_ptr_t) -> __cswiftslash_ptr_t = { csPtr in
+	let setup = csPtr.assumingMemoryBound(to:Setup.self)
 	let ws = UnsafeMutablePointer<Workspace>.allocate(capacity:1)
-	ws.initialize(to:Workspace(csPtr.assumingMemoryBound(to:Setup.self).pointee))
+	ws.initialize(to:Workspace(setup.pointee))
+	// the setup structure was handed off by the launching thread, and is not referenced again after this point.
+	setup.deinitialize(count:1).deallocate()
 	return UnsafeMutableRawPointer(ws)
 }
 /// deallocator function. responsible for being as intentional as possible in capturing the current workspace and releasing the reference of it before it returns.
@@ -0,0 +1,85 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import __cswiftslash_threads
+
+/// thread attributes for work that is launched on its own pthread. pooled pthreads are shared between many pieces of work, so work that is launched with any non-default option always runs on a dedicated pthread.
+public struct PThreadLaunchOptions:Sendable {
+	/// the scheduling policies that a pthread can be launched with.
+	public enum SchedulingPolicy:Sendable {
+		/// the default time-sharing policy, at the given priority (usually 0).
+		case other(priority:Int32)
+		/// first-in first-out realtime scheduling at the given priority. usually requires elevated privileges.
+		case fifo(priority:Int32)
+		/// round-robin realtime scheduling at the given priority. usually requires elevated privileges.
+		case roundRobin(priority:Int32)
+	}
+
+	/// the stack size of the pthread in bytes. nil uses the system default. rounded up to the page size.
+	public var stackSize:Int?
+	/// the indices of the cpus that the pthread may run on. nil or empty allows any cpu. ignored on darwin, which has no cpu affinity interface.
+	public var cpus:Set<Int>?
+	/// the name of the pthread, as shown by debuggers and system tools. truncated to 15 bytes.
+	public var name:String?
+	/// the scheduling policy of the pthread. nil inherits the policy of the launching thread.
+	public var schedulingPolicy:SchedulingPolicy?
+
+	/// creates a new set of launch options. every option defaults to the behavior of a plain pthread.
+	public init(stackSize:Int? = nil, cpus:Set<Int>? = nil, name:String? = nil, schedulingPolicy:SchedulingPolicy? = nil) {
+		self.stackSize = stackSize
+		self.cpus = cpus
+		self.name = name
+		self.schedulingPolicy = schedulingPolicy
+	}
+
+	/// true when every option is left at its default.
+	internal var isDefault:Bool {
+		return stackSize == nil && (cpus == nil || cpus!.isEmpty) && name == nil && schedulingPolicy == nil
+	}
+
+	/// true when every option can be held by a thread configuration. options that the system itself rejects surface as a launch failure when the pthread is created.
+	internal var isRepresentable:Bool {
+		if let stackSize, stackSize <= 0 {
+			return false
+		}
+		if let cpus, cpus.contains(where:{ $0 < 0 || $0 >= Int(__CSWIFTSLASH_THREADS_CPU_SET_WORDS) * 64 }) {
+			return false
+		}
+		return true
+	}
+
+	/// writes the options into a thread configuration. the options must be representable.
+	internal func apply(to config:UnsafeMutablePointer<__cswiftslash_threads_config_t>) {
+		if let stackSize {
+			__cswiftslash_threads_config_set_stack_size(config, stackSize)
+		}
+		if let cpus {
+			for cpu in cpus {
+				_ = __cswiftslash_threads_config_add_cpu(config, cpu)
+			}
+		}
+		if let name {
+			name.withCString { namePtr in
+				__cswiftslash_threads_config_set_name(config, namePtr)
+			}
+		}
+		switch schedulingPolicy {
+			case .none:
+				break
+			case .other(let priority):
+				__cswiftslash_threads_config_set_sched(config, __CSWIFTSLASH_THREADS_SCHED_OTHER, priority)
+			case .fifo(let priority):
+				__cswiftslash_threads_config_set_sched(config, __CSWIFTSLASH_THREADS_SCHED_FIFO, priority)
+			case .roundRobin(let priority):
+				__cswiftslash_threads_config_set_sched(config, __CSWIFTSLASH_THREADS_SCHED_RR, priority)
+		}
+	}
+}
\ No newline at end of file
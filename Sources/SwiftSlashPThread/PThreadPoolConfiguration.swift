@@ -0,0 +1,35 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+/// the configuration of the shared pthread worker pool, which runs the work launched with `run` and `launch`. the pool reads its configuration once, when it is first used.
+public struct PThreadPoolConfiguration:Sendable {
+	/// the number of persistent workers in the pool. nil uses the number of online processors.
+	public var workers:Int?
+	/// the stack size of every worker pthread in bytes. nil uses the system default. rounded up to the page size. a smaller stack shrinks the memory footprint of every worker, including the overflow workers the pool starts when it is saturated. values below the system minimum keep the pool from starting.
+	public var stackSize:Int?
+
+	/// creates a new pool configuration. every value defaults to the behavior of the unconfigured pool.
+	public init(workers:Int? = nil, stackSize:Int? = nil) {
+		self.workers = workers
+		self.stackSize = stackSize
+	}
+
+	/// true when every value can be handed to the pool.
+	internal var isRepresentable:Bool {
+		if let workers, workers <= 0 {
+			return false
+		}
+		if let stackSize, stackSize <= 0 {
+			return false
+		}
+		return true
+	}
+}
\ No newline at end of file
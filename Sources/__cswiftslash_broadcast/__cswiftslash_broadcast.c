@@ -0,0 +1,342 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#include "__cswiftslash_broadcast.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/// structure representing a single waiter that is fired once the broadcast mutex is released.
+typedef struct ____cswiftslash_broadcast_fire {
+	__cswiftslash_broadcast_waiter_f _Nonnull ____wf;
+	__cswiftslash_optr_t ____wc;
+	__cswiftslash_broadcast_consume_result_t ____r;
+	__cswiftslash_optr_t ____d;
+	__cswiftslash_broadcast_node_ptr_t ____h;
+} ____cswiftslash_broadcast_fire_t;
+
+__cswiftslash_broadcast_ptr_t __cswiftslash_broadcast_init(void) {
+	__cswiftslash_broadcast_t __0 = {
+		.____t = NULL,
+		.____s = NULL,
+		.____sn = 0,
+		.____sk = 0,
+		.____ic = false,
+		.____cp = NULL,
+		.____nn = 0,
+		.____hw = 0,
+		.____tp = 0
+	};
+	pthread_mutex_init(&__0.____m, NULL);
+	void *__1 = malloc(sizeof(__cswiftslash_broadcast_t));
+	memcpy(__1, &__0, sizeof(__cswiftslash_broadcast_t));
+	return __1;
+}
+
+/// internal function that releases a hold on an element, freeing the element when no hold remains. NOTE: this function assumes the broadcast mutex is held.
+/// @param _ the broadcast the element belongs to.
+/// @param __ the element to release a hold on.
+/// @return `true` if this was the last hold on the element, in which case ownership of the data pointer is transferred to the caller; `false` otherwise.
+bool ____cswiftslash_broadcast_release(
+	const __cswiftslash_broadcast_ptr_t _,
+	__cswiftslash_broadcast_node_t *_Nonnull const __
+) {
+	__->____rc -= 1;
+	if (__->____rc > 0) {
+		return false;
+	}
+	// every subscriber passes the elements in order, so the element that is freed is always the oldest element in the list. the tail is only freed once every subscriber has caught up.
+	if (_->____t == __) {
+		_->____t = NULL;
+	}
+	_->____nn -= 1;
+	free(__);
+	return true;
+}
+
+/// internal function that advances a subscriber past the element under its cursor. the hold the subscriber has on the element is returned to the caller. NOTE: this function assumes the broadcast mutex is held and the subscriber cursor is not NULL.
+/// @param _ the subscriber to advance.
+/// @param __ pointer where the data pointer of the element will be written.
+/// @return the hold on the element that the subscriber was advanced past.
+__cswiftslash_broadcast_node_t *_Nonnull ____cswiftslash_broadcast_advance(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __
+) {
+	__cswiftslash_broadcast_node_t *_Nonnull __0 = _->____c;
+	*__ = __0->____d;
+	_->____c = __0->____n;
+	return __0;
+}
+
+__cswiftslash_broadcast_subscriber_ptr_t __cswiftslash_broadcast_subscribe(
+	const __cswiftslash_broadcast_ptr_t _
+) {
+	__cswiftslash_broadcast_subscriber_t *__0 = malloc(sizeof(__cswiftslash_broadcast_subscriber_t));
+	__0->____b = _;
+	__0->____c = NULL;
+	__0->____wf = NULL;
+	__0->____wc = NULL;
+	pthread_mutex_lock(&_->____m);
+	if (_->____sn == _->____sk) {
+		_->____sk = (_->____sk == 0) ? 4 : (_->____sk * 2);
+		_->____s = realloc(_->____s, sizeof(__cswiftslash_broadcast_subscriber_t *) * _->____sk);
+	}
+	__0->____i = _->____sn;
+	_->____s[_->____sn] = __0;
+	_->____sn += 1;
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+void __cswiftslash_broadcast_unsubscribe(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	const __cswiftslash_broadcast_release_f _Nonnull __,
+	const __cswiftslash_optr_t ___
+) {
+	__cswiftslash_broadcast_t *_Nonnull __0 = _->____b;
+	__cswiftslash_optr_t __1 = NULL;
+	__cswiftslash_broadcast_node_t *_Nonnull __2 = NULL;
+	pthread_mutex_lock(&__0->____m);
+	if (_->____wf != NULL) {
+		printf("swiftslash broadcast internal error: subscriber removed while a waiter is stored\n");
+		abort();
+	}
+	// release the hold this subscriber has on every element it has not consumed.
+	while (_->____c != NULL) {
+		__2 = ____cswiftslash_broadcast_advance(_, &__1);
+		if (____cswiftslash_broadcast_release(__0, __2) == true) {
+			__(__1, ___);
+		}
+	}
+	// swap the last subscriber into the vacated slot.
+	__0->____sn -= 1;
+	if (_->____i != __0->____sn) {
+		__0->____s[_->____i] = __0->____s[__0->____sn];
+		__0->____s[_->____i]->____i = _->____i;
+	}
+	pthread_mutex_unlock(&__0->____m);
+	free(_);
+}
+
+int8_t __cswiftslash_broadcast_pass(
+	const __cswiftslash_broadcast_ptr_t _,
+	const __cswiftslash_optr_t __
+) {
+	int8_t __0 = 0;
+	size_t __1 = 0;
+	____cswiftslash_broadcast_fire_t *_Nullable __2 = NULL;
+	pthread_mutex_lock(&_->____m);
+	if (_->____ic == true) {
+		__0 = -1;
+		goto returnTime;
+	}
+	if (_->____sn == 0) {
+		__0 = 1;
+		goto returnTime;
+	}
+	__cswiftslash_broadcast_node_t *__3 = malloc(sizeof(__cswiftslash_broadcast_node_t));
+	__3->____d = __;
+	__3->____rc = _->____sn;
+	__3->____n = NULL;
+	if (_->____t != NULL) {
+		_->____t->____n = __3;
+	}
+	_->____t = __3;
+	_->____nn += 1;
+	_->____tp += 1;
+	if (_->____nn > _->____hw) {
+		_->____hw = _->____nn;
+	}
+	// every subscriber that had caught up now points at the new element. subscribers with a stored waiter consume it immediately.
+	for (size_t __4 = 0; __4 < _->____sn; __4++) {
+		__cswiftslash_broadcast_subscriber_t *_Nonnull __5 = _->____s[__4];
+		if (__5->____c != NULL) {
+			continue;
+		}
+		__5->____c = __3;
+		if (__5->____wf == NULL) {
+			continue;
+		}
+		if (__2 == NULL) {
+			__2 = malloc(sizeof(____cswiftslash_broadcast_fire_t) * _->____sn);
+		}
+		__2[__1].____wf = __5->____wf;
+		__2[__1].____wc = __5->____wc;
+		__2[__1].____r = __CSWIFTSLASH_BROADCAST_CONSUME_RESULT;
+		__2[__1].____h = ____cswiftslash_broadcast_advance(__5, &__2[__1].____d);
+		__5->____wf = NULL;
+		__5->____wc = NULL;
+		__1 += 1;
+	}
+	returnTime:
+		pthread_mutex_unlock(&_->____m);
+		for (size_t __4 = 0; __4 < __1; __4++) {
+			__2[__4].____wf(__2[__4].____r, __2[__4].____d, __2[__4].____h, __2[__4].____wc);
+		}
+		if (__2 != NULL) {
+			free(__2);
+		}
+		return __0;
+}
+
+bool __cswiftslash_broadcast_pass_cap(
+	const __cswiftslash_broadcast_ptr_t _,
+	const __cswiftslash_optr_t __
+) {
+	bool __0 = false;
+	size_t __1 = 0;
+	____cswiftslash_broadcast_fire_t *_Nullable __2 = NULL;
+	pthread_mutex_lock(&_->____m);
+	if (_->____ic == true) {
+		goto returnTime;
+	}
+	_->____ic = true;
+	_->____cp = __;
+	__0 = true;
+	// subscribers that are waiting have consumed every element, so they are handed the cap directly.
+	for (size_t __3 = 0; __3 < _->____sn; __3++) {
+		__cswiftslash_broadcast_subscriber_t *_Nonnull __4 = _->____s[__3];
+		if (__4->____wf == NULL) {
+			continue;
+		}
+		if (__2 == NULL) {
+			__2 = malloc(sizeof(____cswiftslash_broadcast_fire_t) * _->____sn);
+		}
+		__2[__1].____wf = __4->____wf;
+		__2[__1].____wc = __4->____wc;
+		__2[__1].____r = __CSWIFTSLASH_BROADCAST_CONSUME_CAP;
+		__2[__1].____d = __;
+		__2[__1].____h = NULL;
+		__4->____wf = NULL;
+		__4->____wc = NULL;
+		__1 += 1;
+	}
+	returnTime:
+		pthread_mutex_unlock(&_->____m);
+		for (size_t __3 = 0; __3 < __1; __3++) {
+			__2[__3].____wf(__2[__3].____r, __2[__3].____d, __2[__3].____h, __2[__3].____wc);
+		}
+		if (__2 != NULL) {
+			free(__2);
+		}
+		return __0;
+}
+
+/// internal function that consumes the next element of a subscriber. NOTE: this function assumes the broadcast mutex is held.
+/// @param _ the subscriber to consume from.
+/// @param __ pointer where the consumed data pointer (or the cap pointer) will be written.
+/// @param ___ pointer where the hold on the consumed element will be written, or NULL when the cap pointer is returned.
+/// @return the result of the consumption operation.
+__cswiftslash_broadcast_consume_result_t ____cswiftslash_broadcast_consume(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	__cswiftslash_broadcast_node_ptr_t *_Nonnull ___
+) {
+	*___ = NULL;
+	if (_->____c != NULL) {
+		*___ = ____cswiftslash_broadcast_advance(_, __);
+		return __CSWIFTSLASH_BROADCAST_CONSUME_RESULT;
+	}
+	if (_->____b->____ic == true) {
+		*__ = _->____b->____cp;
+		return __CSWIFTSLASH_BROADCAST_CONSUME_CAP;
+	}
+	return __CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK;
+}
+
+__cswiftslash_broadcast_consume_result_t __cswiftslash_broadcast_consume_nonblocking(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	__cswiftslash_broadcast_node_ptr_t *_Nonnull ___
+) {
+	pthread_mutex_lock(&_->____b->____m);
+	const __cswiftslash_broadcast_consume_result_t __0 = ____cswiftslash_broadcast_consume(_, __, ___);
+	pthread_mutex_unlock(&_->____b->____m);
+	return __0;
+}
+
+__cswiftslash_broadcast_consume_result_t __cswiftslash_broadcast_consume_async(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	__cswiftslash_broadcast_node_ptr_t *_Nonnull ___,
+	const __cswiftslash_broadcast_waiter_f _Nonnull ____,
+	const __cswiftslash_optr_t _____
+) {
+	pthread_mutex_lock(&_->____b->____m);
+	const __cswiftslash_broadcast_consume_result_t __0 = ____cswiftslash_broadcast_consume(_, __, ___);
+	if (__0 != __CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK) {
+		goto returnTime;
+	}
+	if (_->____wf != NULL) {
+		printf("swiftslash broadcast internal error: a subscriber waiter is already stored\n");
+		abort();
+	}
+	_->____wf = ____;
+	_->____wc = _____;
+	returnTime:
+		pthread_mutex_unlock(&_->____b->____m);
+		return __0;
+}
+
+bool __cswiftslash_broadcast_release(
+	const __cswiftslash_broadcast_ptr_t _,
+	__cswiftslash_broadcast_node_t *_Nonnull const __
+) {
+	pthread_mutex_lock(&_->____m);
+	const bool __0 = ____cswiftslash_broadcast_release(_, __);
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+size_t __cswiftslash_broadcast_held_count(
+	const __cswiftslash_broadcast_ptr_t _
+) {
+	pthread_mutex_lock(&_->____m);
+	const size_t __0 = _->____nn;
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+void __cswiftslash_broadcast_statistics(
+	const __cswiftslash_broadcast_ptr_t _,
+	size_t *_Nonnull __,
+	size_t *_Nonnull ___,
+	uint64_t *_Nonnull ____
+) {
+	pthread_mutex_lock(&_->____m);
+	*__ = _->____nn;
+	*___ = _->____hw;
+	*____ = _->____tp;
+	pthread_mutex_unlock(&_->____m);
+}
+
+bool __cswiftslash_broadcast_destroy(
+	const __cswiftslash_broadcast_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __
+) {
+	if (_->____sn != 0) {
+		printf("swiftslash broadcast internal error: broadcast destroyed while subscribers remain\n");
+		abort();
+	}
+	const bool __0 = _->____ic;
+	if (__0 == true) {
+		*__ = _->____cp;
+	}
+	pthread_mutex_destroy(&_->____m);
+	if (_->____s != NULL) {
+		free(_->____s);
+	}
+	free(_);
+	return __0;
+}
\ No newline at end of file
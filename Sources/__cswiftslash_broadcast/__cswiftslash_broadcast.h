@@ -0,0 +1,196 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#ifndef __CLIBSWIFTSLASH_BROADCAST_H
+#define __CLIBSWIFTSLASH_BROADCAST_H
+
+#include "__cswiftslash_types.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/// broadcast consumption result values
+typedef enum __cswiftslash_broadcast_consume_result {
+
+	/// returned when an element is consumed and returned to the subscriber normally.
+	__CSWIFTSLASH_BROADCAST_CONSUME_RESULT = 0,
+	/// returned when the broadcast is "capped off" and the subscriber has consumed every element. cap pointer is returned with this result.
+	__CSWIFTSLASH_BROADCAST_CONSUME_CAP = 1,
+	/// returned when the subscriber has consumed every element and would block until a new element is passed.
+	__CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK = 2,
+
+} __cswiftslash_broadcast_consume_result_t;
+
+/// structure representing a single element of the shared segment list. the reference count is the number of subscribers that have yet to consume and release the element.
+typedef struct __cswiftslash_broadcast_node {
+	__cswiftslash_optr_t ____d;
+	size_t ____rc;
+	struct __cswiftslash_broadcast_node *_Nullable ____n;
+} __cswiftslash_broadcast_node_t;
+
+/// a nullable pointer to a broadcast node.
+typedef __cswiftslash_broadcast_node_t *_Nullable __cswiftslash_broadcast_node_ptr_t;
+
+/// function prototype for a subscriber waiter. a stored waiter is fired exactly once, from the thread that passes the next element (or cap) into the broadcast.
+/// @param _ the result of the consumption operation. this will be either `__CSWIFTSLASH_BROADCAST_CONSUME_RESULT` or `__CSWIFTSLASH_BROADCAST_CONSUME_CAP`.
+/// @param __ the consumed data pointer, or the cap pointer of the broadcast.
+/// @param ___ the hold on the consumed element, or NULL when the cap pointer is returned. the hold must be released with `__cswiftslash_broadcast_release` once the data pointer is no longer needed.
+/// @param ____ the context pointer that was stored with the waiter.
+typedef void (* __cswiftslash_broadcast_waiter_f)(
+	const __cswiftslash_broadcast_consume_result_t,
+	const __cswiftslash_optr_t,
+	const __cswiftslash_broadcast_node_ptr_t,
+	const __cswiftslash_optr_t
+);
+
+/// function prototype for releasing data pointers that are abandoned by a subscriber.
+typedef void (* __cswiftslash_broadcast_release_f)(
+	const __cswiftslash_optr_t,
+	const __cswiftslash_optr_t
+);
+
+/// forward declaration of the broadcast structure.
+struct __cswiftslash_broadcast;
+
+/// structure representing a single subscriber of a broadcast. the cursor points at the next element the subscriber will consume, and is `NULL` when the subscriber has consumed every element. NOTE: none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_broadcast_subscriber {
+	struct __cswiftslash_broadcast *_Nonnull ____b;
+	__cswiftslash_broadcast_node_ptr_t ____c;
+	__cswiftslash_broadcast_waiter_f _Nullable ____wf;
+	__cswiftslash_optr_t ____wc;
+	size_t ____i;
+} __cswiftslash_broadcast_subscriber_t;
+
+/// a non-null pointer to a broadcast subscriber.
+typedef __cswiftslash_broadcast_subscriber_t *_Nonnull __cswiftslash_broadcast_subscriber_ptr_t;
+
+/// structure representing a single producer, multiple subscriber fifo. every subscriber consumes every element that is passed after it subscribes. elements are stored once in a shared segment list, and each element is handed back to its owner once the slowest subscriber has consumed and released it. NOTE: none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_broadcast {
+	pthread_mutex_t ____m;
+	__cswiftslash_broadcast_node_ptr_t ____t;
+	__cswiftslash_broadcast_subscriber_t *_Nonnull *_Nullable ____s;
+	size_t ____sn;
+	size_t ____sk;
+	bool ____ic;
+	__cswiftslash_optr_t ____cp;
+	size_t ____nn;
+	size_t ____hw;
+	uint64_t ____tp;
+} __cswiftslash_broadcast_t;
+
+/// a non-null pointer to a broadcast.
+typedef __cswiftslash_broadcast_t *_Nonnull __cswiftslash_broadcast_ptr_t;
+
+/// initializes a new broadcast with no subscribers.
+/// @return a heap pointer to a newly initialized broadcast. NOTE: this pointer must be destroyed with `__cswiftslash_broadcast_destroy` to free all associated memory.
+__cswiftslash_broadcast_ptr_t __cswiftslash_broadcast_init(void);
+
+/// adds a new subscriber to the broadcast. the subscriber will consume every element that is passed after this call.
+/// @param _ pointer to the broadcast to subscribe to.
+/// @return a heap pointer to the new subscriber. NOTE: this pointer must be removed with `__cswiftslash_broadcast_unsubscribe` to free all associated memory.
+__cswiftslash_broadcast_subscriber_ptr_t __cswiftslash_broadcast_subscribe(
+	const __cswiftslash_broadcast_ptr_t _
+);
+
+/// removes a subscriber from its broadcast. the elements the subscriber had yet to consume are released from the subscriber's hold, and any element that no other subscriber holds is handed to the release function.
+/// @param _ pointer to the subscriber to remove.
+/// @param __ the function that is handed each data pointer that is no longer held by any subscriber.
+/// @param ___ the context pointer to pass to the release function.
+void __cswiftslash_broadcast_unsubscribe(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	const __cswiftslash_broadcast_release_f _Nonnull __,
+	const __cswiftslash_optr_t ___
+);
+
+/// passes a data pointer to every current subscriber of the broadcast. waiting subscribers are handed the data pointer directly.
+/// @param _ pointer to the broadcast to pass the data pointer into.
+/// @param __ the data pointer to pass. the pointer is never dereferenced by the broadcast and may be NULL.
+/// @return `0` when the data pointer was passed. `1` when the broadcast has no subscribers, in which case the data pointer was not stored and remains owned by the caller. `-1` when the broadcast is capped, in which case the data pointer remains owned by the caller.
+int8_t __cswiftslash_broadcast_pass(
+	const __cswiftslash_broadcast_ptr_t _,
+	const __cswiftslash_optr_t __
+);
+
+/// caps the broadcast with a final pointer. each subscriber is handed the cap pointer once it has consumed every element.
+/// @param _ pointer to the broadcast to cap.
+/// @param __ the cap pointer.
+/// @return `true` if the cap pointer was stored; `false` if the broadcast was already capped.
+bool __cswiftslash_broadcast_pass_cap(
+	const __cswiftslash_broadcast_ptr_t _,
+	const __cswiftslash_optr_t __
+);
+
+/// consumes the next element of a subscriber without blocking the calling thread.
+/// @param _ pointer to the subscriber to consume from.
+/// @param __ pointer where the consumed data pointer (or the cap pointer) will be written.
+/// @param ___ pointer where the hold on the consumed element will be written, or NULL when the cap pointer is returned. the hold must be released with `__cswiftslash_broadcast_release` once the data pointer is no longer needed.
+/// @return the result of the consumption operation.
+__cswiftslash_broadcast_consume_result_t __cswiftslash_broadcast_consume_nonblocking(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	__cswiftslash_broadcast_node_ptr_t *_Nonnull ___
+);
+
+/// consumes the next element of a subscriber without blocking the calling thread. if the subscriber has consumed every element, the waiter function is stored in the subscriber and fired exactly once with the next element (or cap) that is passed into the broadcast.
+/// @param _ pointer to the subscriber to consume from.
+/// @param __ pointer where the consumed data pointer (or the cap pointer) will be written.
+/// @param ___ pointer where the hold on the consumed element will be written, or NULL when the cap pointer is returned. the hold must be released with `__cswiftslash_broadcast_release` once the data pointer is no longer needed.
+/// @param ____ the waiter function to store if the subscriber has consumed every element.
+/// @param _____ the context pointer to be passed to the waiter function when it is fired.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK` indicates that the waiter was stored and will be fired at a later time.
+__cswiftslash_broadcast_consume_result_t __cswiftslash_broadcast_consume_async(
+	const __cswiftslash_broadcast_subscriber_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	__cswiftslash_broadcast_node_ptr_t *_Nonnull ___,
+	const __cswiftslash_broadcast_waiter_f _Nonnull ____,
+	const __cswiftslash_optr_t _____
+);
+
+/// releases a hold on an element that was returned by a consumption operation. the consumed data pointer must not be accessed by the subscriber after this call unless ownership is transferred.
+/// @param _ pointer to the broadcast the element was consumed from.
+/// @param __ the hold on the consumed element.
+/// @return `true` if this was the last hold on the element, in which case ownership of the data pointer is transferred to the caller; `false` otherwise.
+bool __cswiftslash_broadcast_release(
+	const __cswiftslash_broadcast_ptr_t _,
+	__cswiftslash_broadcast_node_t *_Nonnull const __
+);
+
+/// returns the number of elements that are currently held in the shared segment list of the broadcast.
+/// @param _ pointer to the broadcast to inspect.
+/// @return the number of elements that have not yet been consumed and released by every subscriber.
+size_t __cswiftslash_broadcast_held_count(
+	const __cswiftslash_broadcast_ptr_t _
+);
+
+/// reads a snapshot of the counters of a broadcast.
+/// @param _ pointer to the broadcast to inspect.
+/// @param __ pointer where the number of elements currently held in the shared segment list will be written.
+/// @param ___ pointer where the highest number of elements the shared segment list has held will be written.
+/// @param ____ pointer where the total number of elements passed to at least one subscriber will be written.
+void __cswiftslash_broadcast_statistics(
+	const __cswiftslash_broadcast_ptr_t _,
+	size_t *_Nonnull __,
+	size_t *_Nonnull ___,
+	uint64_t *_Nonnull ____
+);
+
+/// destroys a broadcast, freeing all associated memory. the broadcast must not have any subscribers.
+/// @param _ pointer to the broadcast to destroy.
+/// @param __ pointer where the cap pointer will be written if the broadcast was capped.
+/// @return `true` if the broadcast was capped and the cap pointer was written; `false` otherwise.
+bool __cswiftslash_broadcast_destroy(
+	const __cswiftslash_broadcast_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __
+);
+
+#endif // __CLIBSWIFTSLASH_BROADCAST_H
\ No newline at end of file
@@ -0,0 +1,170 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#include "__cswiftslash_doorbell.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+__cswiftslash_doorbell_ptr_t __cswiftslash_doorbell_init(void) {
+	__cswiftslash_doorbell_t __0 = {
+		.____s = 0,
+		.____h = 0,
+		.____wf = NULL,
+		.____wc = NULL
+	};
+	pthread_mutex_init(&__0.____m, NULL);
+	void *__1 = malloc(sizeof(__cswiftslash_doorbell_t));
+	memcpy(__1, &__0, sizeof(__cswiftslash_doorbell_t));
+	return __1;
+}
+
+/// internal function that takes the pending ring of a doorbell, if there is one. the pending bit is cleared before the hint is exchanged so that a ring landing between the two operations is never lost (at worst, it is observed again with a hint of zero).
+/// @param _ the doorbell to take the pending ring from.
+/// @param __ pointer where the accumulated hint will be written if a ring was pending.
+/// @return `true` if a ring was pending and was taken; `false` otherwise.
+bool ____cswiftslash_doorbell_take_pending(
+	const __cswiftslash_doorbell_ptr_t _,
+	size_t *_Nonnull __
+) {
+	if ((atomic_fetch_and_explicit(&_->____s, (uint8_t)~__CSWIFTSLASH_DOORBELL_PENDING, memory_order_acq_rel) & __CSWIFTSLASH_DOORBELL_PENDING) == 0) {
+		return false;
+	}
+	*__ = atomic_exchange_explicit(&_->____h, 0, memory_order_acq_rel);
+	return true;
+}
+
+/// internal function that hands the pending ring (or closure) of a doorbell to its stored waiter. the waiter is left in place if there is nothing to hand to it.
+/// @param _ the doorbell whose waiter should be fired.
+void ____cswiftslash_doorbell_wake(
+	const __cswiftslash_doorbell_ptr_t _
+) {
+	__cswiftslash_doorbell_waiter_f _Nullable __0 = NULL;
+	__cswiftslash_optr_t __1 = NULL;
+	__cswiftslash_doorbell_take_result_t __2 = __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK;
+	size_t __3 = 0;
+	pthread_mutex_lock(&_->____m);
+	if (_->____wf == NULL) {
+		goto returnTime;
+	}
+	if (____cswiftslash_doorbell_take_pending(_, &__3) == true) {
+		__2 = __CSWIFTSLASH_DOORBELL_TAKE_RUNG;
+	} else if ((atomic_load_explicit(&_->____s, memory_order_acquire) & __CSWIFTSLASH_DOORBELL_CLOSED) != 0) {
+		__2 = __CSWIFTSLASH_DOORBELL_TAKE_CLOSED;
+	} else {
+		goto returnTime;
+	}
+	__0 = _->____wf;
+	__1 = _->____wc;
+	_->____wf = NULL;
+	_->____wc = NULL;
+	atomic_fetch_and_explicit(&_->____s, (uint8_t)~__CSWIFTSLASH_DOORBELL_WAITING, memory_order_acq_rel);
+	returnTime:
+		pthread_mutex_unlock(&_->____m);
+		if (__0 != NULL) {
+			__0(__2, __3, __1);
+		}
+}
+
+int8_t __cswiftslash_doorbell_ring(
+	const __cswiftslash_doorbell_ptr_t _,
+	const size_t __
+) {
+	if ((atomic_load_explicit(&_->____s, memory_order_acquire) & __CSWIFTSLASH_DOORBELL_CLOSED) != 0) {
+		return -1;
+	}
+	// retain the larger of the pending hint and the new hint.
+	size_t __0 = atomic_load_explicit(&_->____h, memory_order_relaxed);
+	while (__0 < __ && atomic_compare_exchange_weak_explicit(&_->____h, &__0, __, memory_order_relaxed, memory_order_relaxed) == false) {}
+	const uint8_t __1 = atomic_fetch_or_explicit(&_->____s, __CSWIFTSLASH_DOORBELL_PENDING, memory_order_acq_rel);
+	if ((__1 & __CSWIFTSLASH_DOORBELL_CLOSED) != 0) {
+		return -1;
+	}
+	if ((__1 & __CSWIFTSLASH_DOORBELL_WAITING) != 0) {
+		____cswiftslash_doorbell_wake(_);
+	}
+	return ((__1 & __CSWIFTSLASH_DOORBELL_PENDING) != 0) ? 1 : 0;
+}
+
+bool __cswiftslash_doorbell_close(
+	const __cswiftslash_doorbell_ptr_t _
+) {
+	const uint8_t __0 = atomic_fetch_or_explicit(&_->____s, __CSWIFTSLASH_DOORBELL_CLOSED, memory_order_acq_rel);
+	if ((__0 & __CSWIFTSLASH_DOORBELL_CLOSED) != 0) {
+		return false;
+	}
+	if ((__0 & __CSWIFTSLASH_DOORBELL_WAITING) != 0) {
+		____cswiftslash_doorbell_wake(_);
+	}
+	return true;
+}
+
+__cswiftslash_doorbell_take_result_t __cswiftslash_doorbell_take(
+	const __cswiftslash_doorbell_ptr_t _,
+	size_t *_Nonnull __
+) {
+	if (____cswiftslash_doorbell_take_pending(_, __) == true) {
+		return __CSWIFTSLASH_DOORBELL_TAKE_RUNG;
+	}
+	if ((atomic_load_explicit(&_->____s, memory_order_acquire) & __CSWIFTSLASH_DOORBELL_CLOSED) == 0) {
+		return __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK;
+	}
+	// a final ring may have landed immediately before the doorbell was closed, so the pending bit is observed once more before the closure is returned.
+	if (____cswiftslash_doorbell_take_pending(_, __) == true) {
+		return __CSWIFTSLASH_DOORBELL_TAKE_RUNG;
+	}
+	return __CSWIFTSLASH_DOORBELL_TAKE_CLOSED;
+}
+
+__cswiftslash_doorbell_take_result_t __cswiftslash_doorbell_take_async(
+	const __cswiftslash_doorbell_ptr_t _,
+	size_t *_Nonnull __,
+	const __cswiftslash_doorbell_waiter_f _Nonnull ___,
+	const __cswiftslash_optr_t ____
+) {
+	pthread_mutex_lock(&_->____m);
+	__cswiftslash_doorbell_take_result_t __0 = __cswiftslash_doorbell_take(_, __);
+	if (__0 != __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK) {
+		goto returnTime;
+	}
+	if (_->____wf != NULL) {
+		printf("swiftslash doorbell internal error: a consumer waiter is already stored\n");
+		abort();
+	}
+	_->____wf = ___;
+	_->____wc = ____;
+	atomic_fetch_or_explicit(&_->____s, __CSWIFTSLASH_DOORBELL_WAITING, memory_order_acq_rel);
+	// a ring (or closure) that landed before the waiting bit was published would not have woken the waiter, so the doorbell is observed once more.
+	__0 = __cswiftslash_doorbell_take(_, __);
+	if (__0 != __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK) {
+		_->____wf = NULL;
+		_->____wc = NULL;
+		atomic_fetch_and_explicit(&_->____s, (uint8_t)~__CSWIFTSLASH_DOORBELL_WAITING, memory_order_acq_rel);
+	}
+	returnTime:
+		pthread_mutex_unlock(&_->____m);
+		return __0;
+}
+
+void __cswiftslash_doorbell_destroy(
+	const __cswiftslash_doorbell_ptr_t _
+) {
+	if (_->____wf != NULL) {
+		printf("swiftslash doorbell internal error: doorbell destroyed while a consumer waiter is stored\n");
+		abort();
+	}
+	pthread_mutex_destroy(&_->____m);
+	free(_);
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#ifndef __CLIBSWIFTSLASH_DOORBELL_H
+#define __CLIBSWIFTSLASH_DOORBELL_H
+
+#include "__cswiftslash_types.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/// state bit that is set when the doorbell has been rung and the ring has not yet been taken by the consumer.
+#define __CSWIFTSLASH_DOORBELL_PENDING 0x1
+/// state bit that is set when the doorbell has been closed and will not accept any more rings.
+#define __CSWIFTSLASH_DOORBELL_CLOSED 0x2
+/// state bit that is set when a consumer waiter is stored in the doorbell.
+#define __CSWIFTSLASH_DOORBELL_WAITING 0x4
+
+/// doorbell take result values
+typedef enum __cswiftslash_doorbell_take_result {
+
+	/// returned when the doorbell was rung since the last take. the accumulated hint is returned with this result.
+	__CSWIFTSLASH_DOORBELL_TAKE_RUNG = 0,
+	/// returned when the doorbell is closed and there are no pending rings to take.
+	__CSWIFTSLASH_DOORBELL_TAKE_CLOSED = 1,
+	/// returned when the doorbell has not been rung since the last take.
+	__CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK = 2,
+
+} __cswiftslash_doorbell_take_result_t;
+
+/// function prototype for a doorbell waiter. a stored waiter is fired exactly once, from the thread that rings (or closes) the doorbell.
+/// @param _ the result of the take operation. this will be either `__CSWIFTSLASH_DOORBELL_TAKE_RUNG` or `__CSWIFTSLASH_DOORBELL_TAKE_CLOSED`.
+/// @param __ the accumulated hint of the ring. this is zero when the doorbell is closed.
+/// @param ___ the context pointer that was stored with the waiter.
+typedef void (* __cswiftslash_doorbell_waiter_f)(
+	const __cswiftslash_doorbell_take_result_t,
+	const size_t,
+	const __cswiftslash_optr_t
+);
+
+/// structure representing a level-style doorbell. any number of rings between two takes coalesce into a single pending ring, with the largest hint of those rings retained. the doorbell is designed for a single ringing thread and a single consuming thread - the ringing side only touches the state mutex when a consumer waiter is stored. NOTE: none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_doorbell {
+	_Atomic uint8_t ____s;
+	_Atomic size_t ____h;
+	pthread_mutex_t ____m;
+	__cswiftslash_doorbell_waiter_f _Nullable ____wf;
+	__cswiftslash_optr_t ____wc;
+} __cswiftslash_doorbell_t;
+
+/// defines a non-null pointer to a doorbell structure.
+typedef __cswiftslash_doorbell_t*_Nonnull __cswiftslash_doorbell_ptr_t;
+
+/// initializes a new doorbell that is not rung.
+/// @return a heap pointer to a newly initialized doorbell. NOTE: this pointer must be destroyed with `__cswiftslash_doorbell_destroy` to free all associated memory.
+__cswiftslash_doorbell_ptr_t __cswiftslash_doorbell_init(void);
+
+/// rings the doorbell. if the doorbell is already rung, the ring is coalesced with the pending ring and the larger of the two hints is retained. if a consumer waiter is stored, the ring is handed directly to the waiter.
+/// @param _ pointer to the doorbell to ring.
+/// @param __ the hint to accompany the ring.
+/// @return `0` when the doorbell was rung. `1` when the ring was coalesced with a ring that was already pending. `-1` when the doorbell is closed.
+int8_t __cswiftslash_doorbell_ring(
+	const __cswiftslash_doorbell_ptr_t _,
+	const size_t __
+);
+
+/// closes the doorbell. a ring that is pending when the doorbell is closed can still be taken by the consumer. if a consumer waiter is stored, it is fired with the closure.
+/// @param _ pointer to the doorbell to close.
+/// @return `true` if the doorbell was closed by this call; `false` if the doorbell was already closed.
+bool __cswiftslash_doorbell_close(
+	const __cswiftslash_doorbell_ptr_t _
+);
+
+/// takes the pending ring of the doorbell without blocking the calling thread.
+/// @param _ pointer to the doorbell to take from.
+/// @param __ pointer where the accumulated hint will be written when the function returns `__CSWIFTSLASH_DOORBELL_TAKE_RUNG`.
+/// @return the result of the take operation.
+__cswiftslash_doorbell_take_result_t __cswiftslash_doorbell_take(
+	const __cswiftslash_doorbell_ptr_t _,
+	size_t *_Nonnull __
+);
+
+/// takes the pending ring of the doorbell without blocking the calling thread. if the doorbell is not rung, the waiter function is stored in the doorbell and fired exactly once with the next ring (or closure).
+/// @param _ pointer to the doorbell to take from.
+/// @param __ pointer where the accumulated hint will be written when the function returns `__CSWIFTSLASH_DOORBELL_TAKE_RUNG`.
+/// @param ___ the waiter function to store if the doorbell is not rung.
+/// @param ____ the context pointer to be passed to the waiter function when it is fired.
+/// @return the result of the take operation. `__CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK` indicates that the waiter was stored and will be fired at a later time. any other result indicates that the waiter was not stored and will never be fired.
+__cswiftslash_doorbell_take_result_t __cswiftslash_doorbell_take_async(
+	const __cswiftslash_doorbell_ptr_t _,
+	size_t *_Nonnull __,
+	const __cswiftslash_doorbell_waiter_f _Nonnull ___,
+	const __cswiftslash_optr_t ____
+);
+
+/// destroys a doorbell, freeing all associated memory. the doorbell must not have a consumer waiter stored.
+/// @param _ pointer to the doorbell to destroy.
+void __cswiftslash_doorbell_destroy(
+	const __cswiftslash_doorbell_ptr_t _
+);
+
+#endif // __CLIBSWIFTSLASH_DOORBELL_H
\ No newline at end of file
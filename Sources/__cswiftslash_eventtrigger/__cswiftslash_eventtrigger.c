@@ -9,14 +9,331 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 */
 
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
 #include "__cswiftslash_eventtrigger.h"
 
+#include <errno.h>
+#include <time.h>
+
 #ifdef __linux__
-int __cswiftslash_fcntl_fionread(int fd, int *_Nonnull sizeptr) {
-	return ioctl(fd, FIONREAD, sizeptr);
+#include <linux/io_uring.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// the pidfd system calls and wait type are spelled out for c libraries that predate them.
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#define PIDFD_IDTYPE ((idtype_t)3)
+
+/// the user data given to submissions whose completions are not reported to the caller.
+#define URING_IGNORED_USER_DATA UINT64_MAX
+/// the user data of the poll that is used to probe for multishot poll support.
+#define URING_PROBE_USER_DATA 0
+
+struct __cswiftslash_eventtrigger_uring {
+	/// the io_uring file handle.
+	int ____fd;
+	/// serializes access to the submission queue.
+	pthread_mutex_t ____sm;
+	/// the submission ring mapping and its size.
+	void *_Nonnull ____sr;
+	size_t ____srs;
+	/// the completion ring mapping and its size. this is the submission ring mapping when the kernel maps both rings together.
+	void *_Nonnull ____cr;
+	size_t ____crs;
+	/// the submission queue entries and the size of their mapping.
+	struct io_uring_sqe *_Nonnull ____se;
+	size_t ____ses;
+	/// submission queue head, tail, mask, entry count and index array.
+	_Atomic uint32_t *_Nonnull ____sh;
+	_Atomic uint32_t *_Nonnull ____st;
+	uint32_t ____sk;
+	uint32_t ____sn;
+	uint32_t *_Nonnull ____sa;
+	/// completion queue head, tail, mask and entries.
+	_Atomic uint32_t *_Nonnull ____ch;
+	_Atomic uint32_t *_Nonnull ____ct;
+	uint32_t ____ck;
+	struct io_uring_cqe *_Nonnull ____ce;
+};
+
+/// enters the io_uring instance, submitting and or waiting for completions.
+/// @return the number of submissions consumed, or -1 with errno set.
+static int ____cswiftslash_eventtrigger_uring_enter(int fd, uint32_t submit, uint32_t wait, uint32_t flags) {
+	return (int)syscall(__NR_io_uring_enter, fd, submit, wait, flags, NULL, 0);
+}
+
+/// places a single entry on the submission queue and submits it immediately.
+/// @return 0 on success, or a positive error number.
+static int ____cswiftslash_eventtrigger_uring_submit(__cswiftslash_eventtrigger_uring_t *_Nonnull _, uint8_t __, int ___, uint32_t ____, uint32_t _____, uint64_t ______, uint64_t _______) {
+	pthread_mutex_lock(&_->____sm);
+	const uint32_t __0 = atomic_load_explicit(_->____st, memory_order_relaxed);
+	if (__0 - atomic_load_explicit(_->____sh, memory_order_acquire) >= _->____sn) {
+		// every entry is submitted as soon as it is queued, so the queue only fills if the kernel stops consuming it.
+		pthread_mutex_unlock(&_->____sm);
+		return EBUSY;
+	}
+	const uint32_t __1 = __0 & _->____sk;
+	struct io_uring_sqe *__2 = &_->____se[__1];
+	memset(__2, 0, sizeof(struct io_uring_sqe));
+	__2->opcode = __;
+	__2->fd = ___;
+	__2->poll32_events = ____;
+	__2->len = _____;
+	__2->addr = ______;
+	__2->user_data = _______;
+	_->____sa[__1] = __1;
+	atomic_store_explicit(_->____st, __0 + 1, memory_order_release);
+	int __3;
+	do {
+		__3 = ____cswiftslash_eventtrigger_uring_enter(_->____fd, 1, 0, 0);
+	} while (__3 < 0 && errno == EINTR);
+	int __4 = 0;
+	if (__3 != 1) {
+		// the entry was not consumed. take it back off the queue so that it is not submitted by a later call.
+		__4 = (__3 < 0) ? errno : EAGAIN;
+		atomic_store_explicit(_->____st, __0, memory_order_release);
+	}
+	pthread_mutex_unlock(&_->____sm);
+	return __4;
+}
+
+__cswiftslash_eventtrigger_uring_t *_Nullable __cswiftslash_eventtrigger_uring_init(uint32_t _, int *_Nonnull __) {
+	struct io_uring_params __0;
+	memset(&__0, 0, sizeof(struct io_uring_params));
+	const int __1 = (int)syscall(__NR_io_uring_setup, _, &__0);
+	if (__1 < 0) {
+		*__ = errno;
+		return NULL;
+	}
+	__cswiftslash_eventtrigger_uring_t *__2 = calloc(1, sizeof(__cswiftslash_eventtrigger_uring_t));
+	if (__2 == NULL) {
+		close(__1);
+		*__ = ENOMEM;
+		return NULL;
+	}
+	__2->____fd = __1;
+	__2->____srs = __0.sq_off.array + (__0.sq_entries * sizeof(uint32_t));
+	__2->____crs = __0.cq_off.cqes + (__0.cq_entries * sizeof(struct io_uring_cqe));
+	const bool __3 = (__0.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (__3 == true) {
+		if (__2->____crs > __2->____srs) {
+			__2->____srs = __2->____crs;
+		}
+		__2->____crs = __2->____srs;
+	}
+	__2->____ses = __0.sq_entries * sizeof(struct io_uring_sqe);
+	void *__4 = mmap(NULL, __2->____srs, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, __1, IORING_OFF_SQ_RING);
+	if (__4 == MAP_FAILED) {
+		*__ = errno;
+		close(__1);
+		free(__2);
+		return NULL;
+	}
+	void *__5 = __4;
+	if (__3 == false) {
+		__5 = mmap(NULL, __2->____crs, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, __1, IORING_OFF_CQ_RING);
+		if (__5 == MAP_FAILED) {
+			*__ = errno;
+			munmap(__4, __2->____srs);
+			close(__1);
+			free(__2);
+			return NULL;
+		}
+	}
+	void *__6 = mmap(NULL, __2->____ses, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, __1, IORING_OFF_SQES);
+	if (__6 == MAP_FAILED) {
+		*__ = errno;
+		if (__3 == false) {
+			munmap(__5, __2->____crs);
+		}
+		munmap(__4, __2->____srs);
+		close(__1);
+		free(__2);
+		return NULL;
+	}
+	__2->____sr = __4;
+	__2->____cr = __5;
+	__2->____se = __6;
+	__2->____sh = (_Atomic uint32_t *)((char *)__4 + __0.sq_off.head);
+	__2->____st = (_Atomic uint32_t *)((char *)__4 + __0.sq_off.tail);
+	__2->____sk = *(uint32_t *)((char *)__4 + __0.sq_off.ring_mask);
+	__2->____sn = *(uint32_t *)((char *)__4 + __0.sq_off.ring_entries);
+	__2->____sa = (uint32_t *)((char *)__4 + __0.sq_off.array);
+	__2->____ch = (_Atomic uint32_t *)((char *)__5 + __0.cq_off.head);
+	__2->____ct = (_Atomic uint32_t *)((char *)__5 + __0.cq_off.tail);
+	__2->____ck = *(uint32_t *)((char *)__5 + __0.cq_off.ring_mask);
+	__2->____ce = (struct io_uring_cqe *)((char *)__5 + __0.cq_off.cqes);
+	if (pthread_mutex_init(&__2->____sm, NULL) != 0) {
+		*__ = ENOMEM;
+		munmap(__6, __2->____ses);
+		if (__3 == false) {
+			munmap(__5, __2->____crs);
+		}
+		munmap(__4, __2->____srs);
+		close(__1);
+		free(__2);
+		return NULL;
+	}
+
+	// probe for multishot poll support by arming one on an idle eventfd and removing it again. kernels without support fail the poll with EINVAL, supporting kernels report its removal with ECANCELED.
+	const int __7 = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (__7 < 0) {
+		*__ = errno;
+		__cswiftslash_eventtrigger_uring_close(__2);
+		return NULL;
+	}
+	int __8 = __cswiftslash_eventtrigger_uring_poll_add(__2, __7, POLLIN, URING_PROBE_USER_DATA, true);
+	if (__8 == 0) {
+		__8 = __cswiftslash_eventtrigger_uring_poll_remove(__2, URING_PROBE_USER_DATA);
+	}
+	if (__8 == 0) {
+		__cswiftslash_eventtrigger_uring_event_t __9;
+		int32_t __10;
+		do {
+			__10 = __cswiftslash_eventtrigger_uring_wait(__2, &__9, 1);
+		} while (__10 == 0 || __10 == -EINTR || (__10 == 1 && __9.____mr == true));
+		if (__10 < 0) {
+			__8 = -__10;
+		} else if (__9.____rs != -ECANCELED) {
+			__8 = (__9.____rs < 0) ? -__9.____rs : EINVAL;
+		}
+	}
+	close(__7);
+	if (__8 != 0) {
+		*__ = __8;
+		__cswiftslash_eventtrigger_uring_close(__2);
+		return NULL;
+	}
+	return __2;
+}
+
+int __cswiftslash_eventtrigger_uring_poll_add(__cswiftslash_eventtrigger_uring_t *_Nonnull _, int __, uint32_t ___, uint64_t ____, bool _____) {
+	return ____cswiftslash_eventtrigger_uring_submit(_, IORING_OP_POLL_ADD, __, ___, (_____ == true) ? IORING_POLL_ADD_MULTI : 0, 0, ____);
+}
+
+int __cswiftslash_eventtrigger_uring_poll_remove(__cswiftslash_eventtrigger_uring_t *_Nonnull _, uint64_t __) {
+	return ____cswiftslash_eventtrigger_uring_submit(_, IORING_OP_POLL_REMOVE, -1, 0, 0, __, URING_IGNORED_USER_DATA);
+}
+
+int32_t __cswiftslash_eventtrigger_uring_wait(__cswiftslash_eventtrigger_uring_t *_Nonnull _, __cswiftslash_eventtrigger_uring_event_t *_Nonnull __, int32_t ___) {
+	uint32_t __0 = atomic_load_explicit(_->____ch, memory_order_relaxed);
+	uint32_t __1 = atomic_load_explicit(_->____ct, memory_order_acquire);
+	if (__0 == __1) {
+		// nothing is pending. block until the kernel posts a completion.
+		if (____cswiftslash_eventtrigger_uring_enter(_->____fd, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+			return -errno;
+		}
+		__1 = atomic_load_explicit(_->____ct, memory_order_acquire);
+	}
+	int32_t __2 = 0;
+	while (__0 != __1 && __2 < ___) {
+		const struct io_uring_cqe *__3 = &_->____ce[__0 & _->____ck];
+		__0++;
+		if (__3->user_data == URING_IGNORED_USER_DATA) {
+			continue;
+		}
+		__[__2].____ud = __3->user_data;
+		__[__2].____rs = __3->res;
+		__[__2].____mr = (__3->flags & IORING_CQE_F_MORE) != 0;
+		__2++;
+	}
+	atomic_store_explicit(_->____ch, __0, memory_order_release);
+	return __2;
+}
+
+void __cswiftslash_eventtrigger_uring_close(__cswiftslash_eventtrigger_uring_t *_Nonnull _) {
+	pthread_mutex_destroy(&_->____sm);
+	munmap(_->____se, _->____ses);
+	if (_->____cr != _->____sr) {
+		munmap(_->____cr, _->____crs);
+	}
+	munmap(_->____sr, _->____srs);
+	close(_->____fd);
+	free(_);
+}
+
+int __cswiftslash_eventtrigger_pidfd_open(pid_t _) {
+	return (int)syscall(SYS_pidfd_open, _, 0);
+}
+
+int __cswiftslash_eventtrigger_timerfd_open(void) {
+	return timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+}
+
+int __cswiftslash_eventtrigger_timerfd_arm(int _, uint64_t __) {
+	struct itimerspec __0;
+	memset(&__0, 0, sizeof(__0));
+	// a zero expiration disarms the timerfd, so the earliest deadline that can be given is one nanosecond.
+	if (__ == 0) {
+		__ = 1;
+	}
+	__0.it_value.tv_sec = (time_t)(__ / 1000000000);
+	__0.it_value.tv_nsec = (long)(__ % 1000000000);
+	return timerfd_settime(_, TFD_TIMER_ABSTIME, &__0, NULL);
+}
+
+void __cswiftslash_eventtrigger_timerfd_clear(int _) {
+	uint64_t __0;
+	// the timerfd is nonblocking, so a timerfd that has not expired is left as it is.
+	while (read(_, &__0, sizeof(__0)) == -1 && errno == EINTR) {}
 }
 #endif
 
+int __cswiftslash_eventtrigger_reap(pid_t _, int __, bool ___, int32_t *_Nonnull ____, bool *_Nonnull _____) {
+	const int __0 = (___ == true) ? 0 : WNOHANG;
+	#ifdef __linux__
+	if (__ >= 0) {
+		siginfo_t __1;
+		memset(&__1, 0, sizeof(__1));
+		int __2;
+		do {
+			__2 = waitid(PIDFD_IDTYPE, (id_t)__, &__1, WEXITED | __0);
+		} while (__2 == -1 && errno == EINTR);
+		if (__2 == 0) {
+			// a child process that has not exited leaves the pid unset.
+			if (__1.si_pid == 0) {
+				return 0;
+			}
+			*_____ = (__1.si_code != CLD_EXITED);
+			*____ = __1.si_status;
+			return 1;
+		}
+		if (errno != EINVAL) {
+			return -1;
+		}
+		// kernels that provide pidfds but cannot wait on them (linux 5.3) reject the wait type. reap by pid instead.
+	}
+	#endif
+	int __3 = 0;
+	pid_t __4;
+	do {
+		__4 = waitpid(_, &__3, __0);
+	} while (__4 == -1 && errno == EINTR);
+	if (__4 == 0) {
+		return 0;
+	} else if (__4 < 0) {
+		return -1;
+	}
+	if (WIFSIGNALED(__3)) {
+		*_____ = true;
+		*____ = WTERMSIG(__3);
+	} else {
+		*_____ = false;
+		*____ = WEXITSTATUS(__3);
+	}
+	return 1;
+}
+
 int32_t __cswiftslash_eventtrigger_wifsignaled(const int32_t status) {
 	return WIFSIGNALED(status);
 }
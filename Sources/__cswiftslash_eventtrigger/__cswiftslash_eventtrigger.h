@@ -12,17 +12,85 @@ copyright (c) tanner silva 2025. all rights reserved.
 #ifndef __CLIBSWIFTSLASH_EVENTTRIGGER_H
 #define __CLIBSWIFTSLASH_EVENTTRIGGER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <sys/wait.h>
 
 #ifdef __linux__
 #include <sys/epoll.h>
-#include <sys/ioctl.h>
-/// a wrapper function for `ioctl(fd, FIONREAD, &byteCount)`. swift cannot call into variadic functions, let alone passing some inout shit into a variable arg...so here we are with this function. only used on Linux.
-/// @param fd the file descriptor associated with the fionread request.
-/// @param sizeptr the resulting value of the fionread request.
-/// @return 0 if the fionread request returns a value as expected. a non-zero value will be returned if an unexpected error is encountered.
-int __cswiftslash_fcntl_fionread(int fd, int *_Nonnull sizeptr);
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <poll.h>
+
+/// an io_uring instance that is used to wait for readiness of registered file handles. the structure is private to the implementation.
+typedef struct __cswiftslash_eventtrigger_uring __cswiftslash_eventtrigger_uring_t;
+
+/// a single completion that was taken from the completion queue of an io_uring instance.
+typedef struct __cswiftslash_eventtrigger_uring_event {
+	/// the user data that was given when the poll was armed.
+	uint64_t ____ud;
+	/// the poll event mask that triggered the completion, or a negative error number if the poll failed or was removed.
+	int32_t ____rs;
+	/// true if the poll remains armed after this completion. when false, this is the final completion for the poll.
+	bool ____mr;
+} __cswiftslash_eventtrigger_uring_event_t;
+
+/// the poll mask values, named here so that swift callers do not need the platform module.
+#define __CSWIFTSLASH_EVENTTRIGGER_URING_POLLIN POLLIN
+#define __CSWIFTSLASH_EVENTTRIGGER_URING_POLLOUT POLLOUT
+#define __CSWIFTSLASH_EVENTTRIGGER_URING_POLLERR POLLERR
+#define __CSWIFTSLASH_EVENTTRIGGER_URING_POLLHUP POLLHUP
+
+/// creates a new io_uring instance for readiness polling. fails if the kernel does not provide io_uring, refuses it (as seccomp profiles commonly do), or does not support multishot polls.
+/// @param entries the number of submission queue entries to request. rounded up to a power of two by the kernel.
+/// @param err a pointer to an int that will be set to the error number when NULL is returned.
+/// @return a pointer to the new instance, or NULL if io_uring is unavailable.
+__cswiftslash_eventtrigger_uring_t *_Nullable __cswiftslash_eventtrigger_uring_init(uint32_t entries, int *_Nonnull err);
+
+/// arms a poll for a file handle. may be called from any thread.
+/// @param ring the io_uring instance.
+/// @param fd the file handle to poll.
+/// @param mask the poll events to wait for.
+/// @param ud the user data to post with each completion. zero is valid, UINT64_MAX is reserved.
+/// @param multishot when true, a completion is posted each time the handle signals readiness. when false, the poll ends with its first completion.
+/// @return 0 on success, or a positive error number if the poll could not be submitted.
+int __cswiftslash_eventtrigger_uring_poll_add(__cswiftslash_eventtrigger_uring_t *_Nonnull ring, int fd, uint32_t mask, uint64_t ud, bool multishot);
+
+/// removes the poll that was armed with the given user data. the poll posts a final completion once it has been removed. may be called from any thread.
+/// @param ring the io_uring instance.
+/// @param ud the user data of the poll to remove.
+/// @return 0 on success, or a positive error number if the removal could not be submitted.
+int __cswiftslash_eventtrigger_uring_poll_remove(__cswiftslash_eventtrigger_uring_t *_Nonnull ring, uint64_t ud);
+
+/// waits for at least one completion and takes as many pending completions as will fit in the event buffer. only one thread may wait on an instance at a time.
+/// @param ring the io_uring instance.
+/// @param events the buffer to store the completions in.
+/// @param max the capacity of the event buffer.
+/// @return the number of completions stored in the buffer (which may be zero), or a negative error number if the wait failed.
+int32_t __cswiftslash_eventtrigger_uring_wait(__cswiftslash_eventtrigger_uring_t *_Nonnull ring, __cswiftslash_eventtrigger_uring_event_t *_Nonnull events, int32_t max);
+
+/// closes an io_uring instance. all polls that are still armed are cancelled by the kernel.
+/// @param ring the io_uring instance to close. this pointer is no longer valid after this call.
+void __cswiftslash_eventtrigger_uring_close(__cswiftslash_eventtrigger_uring_t *_Nonnull ring);
+
+/// opens a pidfd for a child process. the pidfd becomes readable once the child process exits, so it can be waited on alongside any other file handle.
+/// @param pid the child process to open a pidfd for.
+/// @return the new pidfd (which always has the close-on-exec flag set), or -1 with errno set if the kernel does not provide pidfds or the process does not exist.
+int __cswiftslash_eventtrigger_pidfd_open(pid_t pid);
+
+/// opens a nonblocking timerfd on the monotonic clock. the timerfd becomes readable once it expires.
+/// @return the new timerfd, or -1 with errno set if it could not be created.
+int __cswiftslash_eventtrigger_timerfd_open(void);
+
+/// arms a timerfd to expire once, at the given deadline. any earlier deadline that the timerfd was armed for is replaced.
+/// @param fd the timerfd to arm.
+/// @param deadline the deadline on the monotonic clock, in nanoseconds (see __cswiftslash_timer_now). a deadline that has already passed expires immediately.
+/// @return 0 on success, or -1 with errno set if the timerfd could not be armed.
+int __cswiftslash_eventtrigger_timerfd_arm(int fd, uint64_t deadline);
+
+/// clears the expiration of a timerfd so that it stops signaling readiness.
+/// @param fd the timerfd to clear.
+void __cswiftslash_eventtrigger_timerfd_clear(int fd);
 #endif // __linux__
 
 #ifdef __APPLE__
@@ -30,6 +98,15 @@ int __cswiftslash_fcntl_fionread(int fd, int *_Nonnull sizeptr);
 #include <sys/event.h>
 #endif // __APPLE__
 
+/// reaps a child process. unless asked to block, this returns immediately when the child process has not exited yet.
+/// @param pid the child process to reap.
+/// @param pidfd a pidfd for the child process (linux only), or -1 to reap by pid alone. the pidfd is used where the kernel supports waiting on it.
+/// @param block when true, waits for the child process to exit.
+/// @param code set to the exit code of the child process, or the signal that ended it.
+/// @param signaled set to true if the child process was ended by a signal.
+/// @return 1 if the child process was reaped, 0 if it has not exited yet, or -1 with errno set if it could not be waited on.
+int __cswiftslash_eventtrigger_reap(pid_t pid, int pidfd, bool block, int32_t *_Nonnull code, bool *_Nonnull signaled);
+
 // c macros cannot be called from swift so wrapper functions must be declared.
 /// wraps WIFSIGNALED as a discrete function instead of a macro.
 int32_t __cswiftslash_eventtrigger_wifsignaled(const int32_t status);
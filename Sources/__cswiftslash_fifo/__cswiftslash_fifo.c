@@ -9,7 +9,12 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 */
 
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "__cswiftslash_fifo.h"
+#include "__cswiftslash_timer.h"
 
 #include <pthread.h>
 #include <stdatomic.h>
@@ -17,6 +22,168 @@ copyright (c) tanner silva 2025. all rights reserved.
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
+#include <time.h>
+
+/// internal function that initializes the wait condition of a fifo. on linux, the condition is bound to the monotonic clock so that timed waits are immune to wall clock adjustments. apple platforms use relative timed waits, which are unaffected by the wall clock.
+/// @param _ the condition to initialize.
+void ____cswiftslash_fifo_cond_init(
+	pthread_cond_t *_Nonnull _
+) {
+	#if defined(__APPLE__)
+	pthread_cond_init(_, NULL);
+	#else
+	pthread_condattr_t __0;
+	pthread_condattr_init(&__0);
+	pthread_condattr_setclock(&__0, CLOCK_MONOTONIC);
+	pthread_cond_init(_, &__0);
+	pthread_condattr_destroy(&__0);
+	#endif
+}
+
+/// internal function that parks the calling thread on the wait condition of a fifo until it is signaled or the deadline passes. must be called while holding the mutex that is passed.
+/// @param _ the fifo whose wait condition will be waited on.
+/// @param __ the mutex that protects the wait. this is released while the thread is parked.
+/// @param ___ pointer to the deadline of the wait, or `NULL` to wait without a deadline.
+/// @return `false` if the deadline passed before the condition was signaled; `true` otherwise.
+bool ____cswiftslash_fifo_wait(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	pthread_mutex_t *_Nonnull __,
+	const uint64_t *_Nullable ___
+) {
+	if (___ == NULL) {
+		pthread_cond_wait(&_->____wv, __);
+		return true;
+	}
+	#if defined(__APPLE__)
+	const uint64_t __0 = __cswiftslash_timer_now();
+	if (__0 >= *___) {
+		return false;
+	}
+	const struct timespec __1 = {
+		.tv_sec = (time_t)((*___ - __0) / 1000000000ULL),
+		.tv_nsec = (long)((*___ - __0) % 1000000000ULL)
+	};
+	return pthread_cond_timedwait_relative_np(&_->____wv, __, &__1) != ETIMEDOUT;
+	#else
+	const struct timespec __1 = {
+		.tv_sec = (time_t)(*___ / 1000000000ULL),
+		.tv_nsec = (long)(*___ % 1000000000ULL)
+	};
+	return pthread_cond_timedwait(&_->____wv, __, &__1) != ETIMEDOUT;
+	#endif
+}
+
+/// internal function that releases a consumer that is blocked on the wait condition of a fifo. must be called while holding the state mutex when the fifo has one, and after the element (or cap) that the consumer is being woken for has been stored.
+/// @param _ the fifo whose blocked consumer should be released.
+void ____cswiftslash_fifo_wake_blocked(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	// a fifo without a state mutex blocks its consumer under the wait mutex, so the wait mutex is held here. the consumer holds it from the moment it observes an empty chain until it is parked on the condition, so the signal cannot land in between and be lost.
+	if (_->____hm == false) {
+		pthread_mutex_lock(&_->____wm);
+	}
+	bool __0 = true;
+	if (atomic_compare_exchange_strong_explicit(&_->____iwlk, &__0, false, memory_order_acq_rel, memory_order_relaxed) == true) {
+		pthread_cond_signal(&_->____wv);
+	}
+	if (_->____hm == false) {
+		pthread_mutex_unlock(&_->____wm);
+	}
+}
+
+/// internal function that stores a consumer waiter in a fifo. the context is written before the waiter function is published with release ordering, so that a producer that claims the waiter always observes its context.
+/// @param _ the fifo to store the waiter in.
+/// @param __ the waiter function to store.
+/// @param ___ the context pointer to be passed to the waiter function when it is fired.
+void ____cswiftslash_fifo_waiter_store(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_fifo_waiter_f _Nonnull __,
+	const __cswiftslash_optr_t ___
+) {
+	atomic_store_explicit(&_->____wc, ___, memory_order_relaxed);
+	atomic_store_explicit(&_->____wf, __, memory_order_release);
+}
+
+/// internal function that reads whether a consumer waiter is stored in a fifo.
+/// @param _ the fifo to check.
+/// @return `true` if a waiter is stored; `false` otherwise.
+bool ____cswiftslash_fifo_waiter_stored(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	return atomic_load_explicit(&_->____wf, memory_order_acquire) != NULL;
+}
+
+/// internal function that claims the consumer waiter stored in a fifo. the waiter function is exchanged out of the fifo, so exactly one caller can claim a stored waiter.
+/// @param _ the fifo to claim the waiter from.
+/// @param __ pointer where the context of the claimed waiter will be written. not written when no waiter is stored.
+/// @return the claimed waiter function, or `NULL` if no waiter was stored.
+__cswiftslash_fifo_waiter_optr_f ____cswiftslash_fifo_waiter_claim(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __
+) {
+	const __cswiftslash_fifo_waiter_optr_f __0 = atomic_exchange_explicit(&_->____wf, NULL, memory_order_acq_rel);
+	if (__0 != NULL) {
+		*__ = atomic_load_explicit(&_->____wc, memory_order_relaxed);
+	}
+	return __0;
+}
+
+/// internal function that records elements passed into a fifo, raising the high-water mark when the resulting depth exceeds it. does nothing when statistics are not enabled. NOTE: on a ring fifo, this must be called before the elements are published to the consumer.
+/// @param _ the fifo the elements were passed into.
+/// @param __ the number of elements that were passed.
+void ____cswiftslash_fifo_stats_passed(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const size_t __
+) {
+	__cswiftslash_fifo_stats_t *_Nullable __0 = _->____st;
+	if (__0 == NULL || __ == 0) {
+		return;
+	}
+	const uint64_t __1 = atomic_fetch_add_explicit(&__0->____tp, __, memory_order_relaxed) + __;
+	const uint64_t __2 = atomic_load_explicit(&__0->____tc, memory_order_relaxed);
+	const size_t __3 = (__1 > __2) ? (size_t)(__1 - __2) : 0;
+	size_t __4 = atomic_load_explicit(&__0->____hw, memory_order_relaxed);
+	while (__4 < __3 && atomic_compare_exchange_weak_explicit(&__0->____hw, &__4, __3, memory_order_relaxed, memory_order_relaxed) == false) {}
+}
+
+/// internal function that records elements consumed from a fifo. does nothing when statistics are not enabled.
+/// @param _ the fifo the elements were consumed from.
+/// @param __ the number of elements that were consumed.
+void ____cswiftslash_fifo_stats_consumed(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const size_t __
+) {
+	if (_->____st == NULL || __ == 0) {
+		return;
+	}
+	atomic_fetch_add_explicit(&_->____st->____tc, __, memory_order_relaxed);
+}
+
+/// internal function that reads the start time of a consumer wait.
+/// @param _ the fifo the consumer is about to wait on.
+/// @return the current time of the monotonic clock, or `0` when statistics are not enabled (so that the clock is only read when it is needed).
+uint64_t ____cswiftslash_fifo_stats_wait_began(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	if (_->____st == NULL) {
+		return 0;
+	}
+	return __cswiftslash_timer_now();
+}
+
+/// internal function that records the time a consumer spent waiting on a fifo. does nothing when statistics are not enabled.
+/// @param _ the fifo the consumer waited on.
+/// @param __ the start time of the wait, as returned by `____cswiftslash_fifo_stats_wait_began`.
+void ____cswiftslash_fifo_stats_wait_ended(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const uint64_t __
+) {
+	if (_->____st == NULL) {
+		return;
+	}
+	atomic_fetch_add_explicit(&_->____st->____bt, __cswiftslash_timer_now() - __, memory_order_relaxed);
+}
 
 pthread_mutex_t __cswiftslash_fifo_mutex_new() {
 	pthread_mutex_t mutex;
@@ -38,11 +205,17 @@ __cswiftslash_fifo_linkpair_ptr_t __cswiftslash_fifo_init(
 			.____hm = true, // state mutex
 			.____iwlk = false,
 			.____hme = false,
-			.____me = 0
+			.____me = 0,
+			.____wf = NULL,
+			.____wc = NULL,
+			.____lp = __cswiftslash_pool_init(sizeof(struct __cswiftslash_fifo_link), __CSWIFTSLASH_FIFO_LINK_POOL_MAX),
+			.____rb = NULL,
+			.____rw = false,
+			.____st = NULL
 		};
 		pthread_mutex_init(&__0.____m, NULL);
 		pthread_mutex_init(&__0.____wm, NULL);
-		pthread_mutex_lock(&__0.____wm);
+		____cswiftslash_fifo_cond_init(&__0.____wv);
 		void *__1 = malloc(sizeof(__cswiftslash_fifo_linkpair_t));
 		memcpy(__1, &__0, sizeof(__cswiftslash_fifo_linkpair_t));
 
@@ -59,17 +232,48 @@ __cswiftslash_fifo_linkpair_ptr_t __cswiftslash_fifo_init(
 			.____hm = false, // no state mutex
 			.____iwlk = false,
 			.____hme = false,
-			.____me = 0
+			.____me = 0,
+			.____wf = NULL,
+			.____wc = NULL,
+			// the link pool is guarded by the state mutex, so a fifo without one never holds a link for reuse.
+			.____lp = __cswiftslash_pool_init(sizeof(struct __cswiftslash_fifo_link), 0),
+			.____rb = NULL,
+			.____rw = false,
+			.____st = NULL
 		};
 		// state mutex would initialize here if it was enabled, but it is not.
 		pthread_mutex_init(&__0.____wm, NULL);
-		pthread_mutex_lock(&__0.____wm);
+		____cswiftslash_fifo_cond_init(&__0.____wv);
 		void *__1 = malloc(sizeof(__cswiftslash_fifo_linkpair_t));
 		memcpy(__1, &__0, sizeof(__cswiftslash_fifo_linkpair_t));
 		return __1;
 	}
 }
 
+__cswiftslash_fifo_linkpair_ptr_t __cswiftslash_fifo_init_ring(
+	const size_t _
+) {
+	size_t __0 = 1;
+	while (__0 < _) {
+		__0 <<= 1;
+	}
+	// aligned_alloc requires the allocation size to be a multiple of the alignment.
+	const size_t __1 = sizeof(__cswiftslash_fifo_ring_t) + (sizeof(__cswiftslash_optr_t) * __0);
+	__cswiftslash_fifo_ring_t *__2 = aligned_alloc(__CSWIFTSLASH_FIFO_CACHE_LINE, ((__1 + __CSWIFTSLASH_FIFO_CACHE_LINE - 1) / __CSWIFTSLASH_FIFO_CACHE_LINE) * __CSWIFTSLASH_FIFO_CACHE_LINE);
+	if (__2 == NULL) {
+		printf("swiftslash fifo internal error: couldn't allocate fifo ring\n");
+		abort();
+	}
+	atomic_store_explicit(&__2->____h, 0, memory_order_relaxed);
+	__2->____ct = 0;
+	atomic_store_explicit(&__2->____t, 0, memory_order_relaxed);
+	__2->____ch = 0;
+	__2->____mk = __0 - 1;
+	const __cswiftslash_fifo_linkpair_ptr_t __3 = __cswiftslash_fifo_init(true);
+	__3->____rb = __2;
+	return __3;
+}
+
 bool __cswiftslash_fifo_set_max_elements(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
 	const size_t __
@@ -78,6 +282,9 @@ bool __cswiftslash_fifo_set_max_elements(
 	if (_->____hm == true) {
 		pthread_mutex_lock(&_->____m);
 	}
+	if (_->____rb != NULL) {
+		goto returnTime;
+	}
 	if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
 		goto returnTime;
 	}
@@ -94,6 +301,248 @@ bool __cswiftslash_fifo_set_max_elements(
 		return __0;
 }
 
+/// internal function that consumes the next data pointer from the ring of a fifo. takes no locks - must only be called from the consuming side of the ring (or while the consumer is suspended on a stored waiter).
+/// @param _ the ring fifo to consume from.
+/// @param __ the pointer that will be set to the consumed pointer (or the cap pointer).
+/// @return the result of the consumption operation.
+__cswiftslash_fifo_consume_result_t ____cswiftslash_fifo_ring_consume(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __
+) {
+	__cswiftslash_fifo_ring_t *_Nonnull __0 = _->____rb;
+	const size_t __1 = atomic_load_explicit(&__0->____h, memory_order_relaxed);
+	if (__1 == __0->____ct) {
+		__0->____ct = atomic_load_explicit(&__0->____t, memory_order_acquire);
+		if (__1 == __0->____ct) {
+			if (atomic_load_explicit(&_->____ic, memory_order_acquire) == false) {
+				return __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK;
+			}
+			// the cap may have been stored after a final element was published, so the producer index is observed once more before the cap is returned.
+			__0->____ct = atomic_load_explicit(&__0->____t, memory_order_acquire);
+			if (__1 == __0->____ct) {
+				*__ = atomic_load_explicit(&_->____cp, memory_order_acquire);
+				return __CSWIFTSLASH_FIFO_CONSUME_CAP;
+			}
+		}
+	}
+	*__ = __0->____s[__1 & __0->____mk];
+	atomic_store_explicit(&__0->____h, __1 + 1, memory_order_release);
+	____cswiftslash_fifo_stats_consumed(_, 1);
+	return __CSWIFTSLASH_FIFO_CONSUME_RESULT;
+}
+
+/// internal function that wakes a consumer that is parked on a ring fifo. a stored waiter is handed the next element of the ring directly, and a blocked consumer is released to consume it on its own thread.
+/// @param _ the ring fifo whose consumer should be woken.
+void ____cswiftslash_fifo_ring_wake(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	__cswiftslash_fifo_waiter_f _Nullable __0 = NULL;
+	__cswiftslash_optr_t __1 = NULL;
+	__cswiftslash_optr_t __2 = NULL;
+	__cswiftslash_fifo_consume_result_t __3 = __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK;
+	pthread_mutex_lock(&_->____m);
+	if (____cswiftslash_fifo_waiter_stored(_) == true) {
+		__3 = ____cswiftslash_fifo_ring_consume(_, &__2);
+		if (__3 != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK) {
+			__0 = ____cswiftslash_fifo_waiter_claim(_, &__1);
+			atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+			if (_->____st != NULL) {
+				____cswiftslash_fifo_stats_wait_ended(_, _->____st->____ws);
+			}
+		}
+	}
+	if (atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+		atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+		____cswiftslash_fifo_wake_blocked(_);
+	}
+	pthread_mutex_unlock(&_->____m);
+	if (__0 != NULL) {
+		__0(__3, __2, __1);
+	}
+}
+
+/// internal function that passes a data pointer into the ring of a fifo. the element is published with a single release store, and the state mutex is only taken when a consumer is parked on the fifo.
+/// @param _ the ring fifo to pass the data pointer into.
+/// @param __ the data pointer to pass.
+/// @return `0` on success. `-1` when the fifo is capped. `-2` when the ring is full.
+int8_t ____cswiftslash_fifo_ring_pass(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t __
+) {
+	__cswiftslash_fifo_ring_t *_Nonnull __0 = _->____rb;
+	if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+		return -1;
+	}
+	const size_t __1 = atomic_load_explicit(&__0->____t, memory_order_relaxed);
+	if ((__1 - __0->____ch) > __0->____mk) {
+		__0->____ch = atomic_load_explicit(&__0->____h, memory_order_acquire);
+		if ((__1 - __0->____ch) > __0->____mk) {
+			return -2;
+		}
+	}
+	__0->____s[__1 & __0->____mk] = __;
+	____cswiftslash_fifo_stats_passed(_, 1);
+	atomic_store_explicit(&__0->____t, __1 + 1, memory_order_release);
+	// a consumer publishes its intent to park before checking the ring one final time. this fence pairs with the fence on the consuming side, so that either the consumer observes this element or this producer observes the parked consumer.
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&_->____rw, memory_order_relaxed) == true) {
+		____cswiftslash_fifo_ring_wake(_);
+	}
+	return 0;
+}
+
+/// internal function that consumes the next data pointer from the ring of a fifo, blocking the calling thread until an element or cap is available (or the deadline passes).
+/// @param _ the ring fifo to consume from.
+/// @param __ the pointer that will be set to the consumed pointer (or the cap pointer).
+/// @param ___ pointer to the deadline of the wait, or `NULL` to wait without a deadline.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` is returned when the deadline passes.
+__cswiftslash_fifo_consume_result_t ____cswiftslash_fifo_ring_consume_blocking(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	const uint64_t *_Nullable ___
+) {
+	__cswiftslash_fifo_consume_result_t __0;
+	loadAgain:
+		__0 = ____cswiftslash_fifo_ring_consume(_, __);
+		if (__0 != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK) {
+			return __0;
+		}
+		pthread_mutex_lock(&_->____m);
+		if (____cswiftslash_fifo_waiter_stored(_) == true || atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+			printf("swiftslash fifo internal error: a consumer is already waiting on this fifo\n");
+			abort();
+		}
+		atomic_store_explicit(&_->____iwlk, true, memory_order_relaxed);
+		atomic_store_explicit(&_->____rw, true, memory_order_relaxed);
+		atomic_thread_fence(memory_order_seq_cst);
+		__0 = ____cswiftslash_fifo_ring_consume(_, __);
+		if (__0 != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK) {
+			atomic_store_explicit(&_->____iwlk, false, memory_order_release);
+			atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+			pthread_mutex_unlock(&_->____m);
+			return __0;
+		}
+		const uint64_t __2 = ____cswiftslash_fifo_stats_wait_began(_);
+		const bool __1 = ____cswiftslash_fifo_wait(_, &_->____m, ___);
+		____cswiftslash_fifo_stats_wait_ended(_, __2);
+		atomic_store_explicit(&_->____iwlk, false, memory_order_release);
+		atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+		pthread_mutex_unlock(&_->____m);
+		if (__1 == false) {
+			// the deadline passed. the ring is observed one final time in case an element landed as the wait timed out.
+			return ____cswiftslash_fifo_ring_consume(_, __);
+		}
+		goto loadAgain;
+}
+
+/// internal function that consumes the next data pointer from the ring of a fifo, storing the waiter when the ring is empty.
+/// @param _ the ring fifo to consume from.
+/// @param __ the pointer that will be set to the consumed pointer (or the cap pointer).
+/// @param ___ the waiter function to store if the ring is empty.
+/// @param ____ the context pointer to be passed to the waiter function when it is fired.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` indicates that the waiter was stored.
+__cswiftslash_fifo_consume_result_t ____cswiftslash_fifo_ring_consume_async(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	const __cswiftslash_fifo_waiter_f _Nonnull ___,
+	const __cswiftslash_optr_t ____
+) {
+	__cswiftslash_fifo_consume_result_t __0 = ____cswiftslash_fifo_ring_consume(_, __);
+	if (__0 != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK) {
+		return __0;
+	}
+	pthread_mutex_lock(&_->____m);
+	if (____cswiftslash_fifo_waiter_stored(_) == true || atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+		printf("swiftslash fifo internal error: a consumer is already waiting on this fifo\n");
+		abort();
+	}
+	____cswiftslash_fifo_waiter_store(_, ___, ____);
+	atomic_store_explicit(&_->____rw, true, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	if (_->____st != NULL) {
+		_->____st->____ws = __cswiftslash_timer_now();
+	}
+	__0 = ____cswiftslash_fifo_ring_consume(_, __);
+	if (__0 != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK) {
+		__cswiftslash_optr_t __1 = NULL;
+		____cswiftslash_fifo_waiter_claim(_, &__1);
+		atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+	}
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+/// internal function that takes a link from the recycled link pool of the fifo, allocating a new link only when the pool is empty. the pool is guarded by the state mutex, so a fifo without a state mutex always allocates a new link.
+/// @param _ the fifo to take the link from.
+/// @param __ the data pointer to store in the link.
+/// @return a link that stores the data pointer and has no next link.
+__cswiftslash_fifo_link_ptr_t ____cswiftslash_fifo_link_take(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t __
+) {
+	const __cswiftslash_fifo_link_ptr_t __0 = __cswiftslash_pool_take(&_->____lp);
+	__0->_ = __;
+	atomic_store_explicit(&__0->__, NULL, memory_order_relaxed);
+	return __0;
+}
+
+/// internal function that returns a consumed link to the recycled link pool of the fifo. the link is freed if the pool is full, or if the fifo has no state mutex to guard the pool.
+/// @param _ the fifo to return the link to.
+/// @param __ the link to return.
+void ____cswiftslash_fifo_link_give(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_fifo_link_ptr_t _Nonnull __
+) {
+	__cswiftslash_pool_give(&_->____lp, __);
+}
+
+bool __cswiftslash_fifo_enable_statistics(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	if (_->____st != NULL) {
+		return false;
+	}
+	__cswiftslash_fifo_stats_t *__0 = malloc(sizeof(__cswiftslash_fifo_stats_t));
+	if (__0 == NULL) {
+		printf("swiftslash fifo internal error: couldn't allocate fifo statistics\n");
+		abort();
+	}
+	atomic_store_explicit(&__0->____tp, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____tc, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____hw, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____bt, 0, memory_order_relaxed);
+	__0->____ws = 0;
+	_->____st = __0;
+	return true;
+}
+
+bool __cswiftslash_fifo_statistics(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	size_t *_Nonnull __,
+	size_t *_Nonnull ___,
+	uint64_t *_Nonnull ____,
+	uint64_t *_Nonnull _____,
+	uint64_t *_Nonnull ______
+) {
+	__cswiftslash_fifo_stats_t *_Nullable __0 = _->____st;
+	if (__0 == NULL) {
+		return false;
+	}
+	// the consumed count is read first so that the depth can never be computed from a consumed count that is ahead of the passed count.
+	*_____ = atomic_load_explicit(&__0->____tc, memory_order_acquire);
+	*____ = atomic_load_explicit(&__0->____tp, memory_order_acquire);
+	*__ = (*____ > *_____) ? (size_t)(*____ - *_____) : 0;
+	*___ = atomic_load_explicit(&__0->____hw, memory_order_acquire);
+	*______ = atomic_load_explicit(&__0->____bt, memory_order_acquire);
+	return true;
+}
+
+size_t __cswiftslash_fifo_link_allocations(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	return __cswiftslash_pool_allocations(&_->____lp);
+}
+
 bool __cswiftslash_fifo_close(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
 	const __cswiftslash_fifo_link_ptr_consume_f _Nonnull __,
@@ -103,18 +552,12 @@ bool __cswiftslash_fifo_close(
 	if (_->____hm == true) {
 		pthread_mutex_lock(&_->____m);
 	}
-	bool __2 = true;
-	if (atomic_compare_exchange_weak(&_->____iwlk, &__2, false) == true) {
-		pthread_mutex_unlock(&_->____wm);
-		if (_->____hm == true) {
-			pthread_mutex_unlock(&_->____m);
-		}
-		pthread_mutex_lock(&_->____wm);
-		if (_->____hm == true) {
-			pthread_mutex_lock(&_->____m);
-		}
-		pthread_mutex_unlock(&_->____wm);
-	} else if (__2 == true) {
+	if (atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+		printf("swiftslash fifo internal error: fifo closed while a consumer is blocked\n");
+		abort();
+	}
+	if (____cswiftslash_fifo_waiter_stored(_) == true) {
+		printf("swiftslash fifo internal error: fifo closed while a consumer waiter is stored\n");
 		abort();
 	}
 	__cswiftslash_fifo_link_ptr_t __0 = atomic_load_explicit(&_->____bp, memory_order_acquire);
@@ -124,6 +567,18 @@ bool __cswiftslash_fifo_close(
 		free(__0);
 		__0 = __1;
 	}
+	// hand the unconsumed ring elements to the deallocator and free the ring.
+	if (_->____rb != NULL) {
+		__cswiftslash_fifo_ring_t *_Nonnull __5 = _->____rb;
+		const size_t __6 = atomic_load_explicit(&__5->____t, memory_order_acquire);
+		for (size_t __7 = atomic_load_explicit(&__5->____h, memory_order_acquire); __7 != __6; __7++) {
+			__(__5->____s[__7 & __5->____mk], ___);
+		}
+		free(__5);
+		_->____rb = NULL;
+	}
+	// free the recycled links that are held in the pool.
+	__cswiftslash_pool_drain(&_->____lp);
 	atomic_store_explicit(&_->____bp, NULL, memory_order_release);
 	atomic_store_explicit(&_->____tp, NULL, memory_order_release);
 	atomic_store_explicit(&_->____ec, 0, memory_order_release);
@@ -131,7 +586,11 @@ bool __cswiftslash_fifo_close(
 	if (__4 == true) {
 		(*____) = atomic_load_explicit(&_->____cp, memory_order_acquire);
 	}
-	pthread_mutex_unlock(&_->____wm);
+	if (_->____st != NULL) {
+		free(_->____st);
+		_->____st = NULL;
+	}
+	pthread_cond_destroy(&_->____wv);
 	pthread_mutex_destroy(&_->____wm);
 	if (_->____hm == true) {
 		pthread_mutex_unlock(&_->____m);
@@ -141,22 +600,105 @@ bool __cswiftslash_fifo_close(
 	return __4;
 }
 
+/// internal function that flushes a single entry.
+///	@param _ the pre-loaded atomic base pointer of the chain.
+///	@param __ the chain that this operation will act on.
+///	@param ___ the pointer that will be set to the consumed pointer.
+/// - returns: true if the operation was successful and the element count could be decremented. false if the operation was not successful.
+bool ____cswiftslash_fifo_consume_next(
+	__cswiftslash_fifo_link_ptr_t _,
+	const __cswiftslash_fifo_linkpair_ptr_t __,
+	__cswiftslash_optr_t *_Nonnull ___
+) {
+	if (_ == NULL) {
+		return false;
+	}
+	__cswiftslash_fifo_link_ptr_t __0 = atomic_load_explicit(&_->__, memory_order_acquire);
+	if (atomic_compare_exchange_weak_explicit(&__->____bp, &_, __0, memory_order_acq_rel, memory_order_relaxed) == true) {
+		if (__0 == NULL) {
+			atomic_store_explicit(&__->____tp, NULL, memory_order_release);
+		}
+		atomic_fetch_sub_explicit(&__->____ec, 1, memory_order_acq_rel);
+		____cswiftslash_fifo_stats_consumed(__, 1);
+		*___ = _->_;
+		____cswiftslash_fifo_link_give(__, _);
+		return true;
+	}
+	return false;
+}
+
+/// internal function that hands the next element of the chain to a waiter that was stored on a fifo without a state mutex. a consumer publishes its waiter before checking the chain one final time, and a producer calls this after counting its elements. the fences on either side guarantee that either the consumer observes the elements or this producer observes the waiter. does nothing on a fifo with a state mutex, since its producers check for the waiter under the mutex.
+/// @param _ the fifo whose stored waiter should be handed the next element.
+void ____cswiftslash_fifo_chain_wake(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+) {
+	if (_->____hm == true) {
+		return;
+	}
+	atomic_thread_fence(memory_order_seq_cst);
+	if (____cswiftslash_fifo_waiter_stored(_) == false) {
+		return;
+	}
+	__cswiftslash_optr_t __0 = NULL;
+	__cswiftslash_fifo_waiter_optr_f __1 = ____cswiftslash_fifo_waiter_claim(_, &__0);
+	__cswiftslash_optr_t __2 = NULL;
+	__cswiftslash_fifo_consume_result_t __3;
+	while (__1 != NULL) {
+		// the claimed waiter stands in for the only consumer, so nothing else consumes from the chain until it is fired or stored again.
+		if (atomic_load_explicit(&_->____ec, memory_order_acquire) > 0) {
+			// the count is raised only after an element is linked, so the consumption can only fail spuriously.
+			while (____cswiftslash_fifo_consume_next(atomic_load_explicit(&_->____bp, memory_order_acquire), _, &__2) == false) {}
+			__3 = __CSWIFTSLASH_FIFO_CONSUME_RESULT;
+			goto fireTime;
+		} else if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+			__2 = atomic_load_explicit(&_->____cp, memory_order_acquire);
+			__3 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
+			goto fireTime;
+		}
+		// the element this producer counted was consumed before the waiter was stored. the waiter is stored again, and is only claimed back if another element (or the cap) landed in between.
+		____cswiftslash_fifo_waiter_store(_, __1, __0);
+		atomic_thread_fence(memory_order_seq_cst);
+		if (atomic_load_explicit(&_->____ec, memory_order_acquire) == 0 && atomic_load_explicit(&_->____ic, memory_order_acquire) == false) {
+			return;
+		}
+		__1 = ____cswiftslash_fifo_waiter_claim(_, &__0);
+	}
+	return;
+	fireTime:
+		if (_->____st != NULL) {
+			____cswiftslash_fifo_stats_wait_ended(_, _->____st->____ws);
+		}
+		__1(__3, __2, __0);
+}
+
 bool __cswiftslash_fifo_pass_cap(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
 	const __cswiftslash_optr_t __
 ) {
 	bool __0 = false;
+	__cswiftslash_fifo_waiter_f _Nullable __3 = NULL;
+	__cswiftslash_optr_t __4 = NULL;
+	__cswiftslash_fifo_consume_result_t __5 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
+	__cswiftslash_optr_t __6 = __;
 	if (_->____hm == true) {
 		pthread_mutex_lock(&_->____m);
 	}
 	bool __1 = false;
 	if (atomic_compare_exchange_weak_explicit(&_->____ic, &__1, true, memory_order_acq_rel, memory_order_relaxed) == true) {
 		atomic_store_explicit(&_->____cp, __, memory_order_release);
-		bool __2 = true;
-		if (atomic_compare_exchange_weak_explicit(&_->____iwlk, &__2, false, memory_order_acq_rel, memory_order_acquire) == true) {
-			pthread_mutex_unlock(&_->____wm);
-		} else if (__2 == true) {
-			abort();
+		____cswiftslash_fifo_wake_blocked(_);
+		// a consumer without a state mutex publishes its waiter before checking for the cap one final time. this fence pairs with the fence on the consuming side, so that either the consumer observes the cap or the waiter is claimed here.
+		atomic_thread_fence(memory_order_seq_cst);
+		// take the stored waiter (if any) so that it can be fired with the cap once the state mutex is released.
+		__3 = ____cswiftslash_fifo_waiter_claim(_, &__4);
+		atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+		if (__3 != NULL && _->____rb != NULL) {
+			// a ring may still hold elements that were published before the cap. the waiter is handed the next of these before it is handed the cap.
+			__5 = ____cswiftslash_fifo_ring_consume(_, &__6);
+		} else if (__3 != NULL && _->____hm == false && atomic_load_explicit(&_->____ec, memory_order_acquire) > 0) {
+			// a chain without a state mutex may hold an element that a producer counted after the waiter was stored. the waiter is handed that element before the cap.
+			while (____cswiftslash_fifo_consume_next(atomic_load_explicit(&_->____bp, memory_order_acquire), _, &__6) == false) {}
+			__5 = __CSWIFTSLASH_FIFO_CONSUME_RESULT;
 		}
 		__0 = true;
 		goto returnTime;
@@ -168,6 +710,9 @@ bool __cswiftslash_fifo_pass_cap(
 		if (_->____hm == true) {
 			pthread_mutex_unlock(&_->____m);
 		}
+		if (__3 != NULL) {
+			__3(__5, __6, __4);
+		}
 		return __0;
 }
 
@@ -196,9 +741,14 @@ bool ____cswiftslash_fifo_pass_link(
 
 int8_t __cswiftslash_fifo_pass(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
-	const __cswiftslash_ptr_t __
+	const __cswiftslash_optr_t __
 ) {
+	if (_->____rb != NULL) {
+		return ____cswiftslash_fifo_ring_pass(_, __);
+	}
 	int8_t __0 = -1;
+	__cswiftslash_fifo_waiter_f _Nullable __4 = NULL;
+	__cswiftslash_optr_t __5 = NULL;
 	if (_->____hm == true) {
 		pthread_mutex_lock(&_->____m);
 	}
@@ -209,21 +759,27 @@ int8_t __cswiftslash_fifo_pass(
 				goto returnTime;
 			}
 		}
-		const struct __cswiftslash_fifo_link __1 = {
-			._ = __,
-			.__ = NULL
-		};
-		const __cswiftslash_fifo_link_ptr_t __2 = memcpy(malloc(sizeof(struct __cswiftslash_fifo_link)), &__1, sizeof(struct __cswiftslash_fifo_link));
+		__4 = ____cswiftslash_fifo_waiter_claim(_, &__5);
+		if (__4 != NULL) {
+			// a consumer is waiting for this element. hand it off directly (once the state mutex is released) without storing it in the chain.
+			____cswiftslash_fifo_stats_passed(_, 1);
+			____cswiftslash_fifo_stats_consumed(_, 1);
+			if (_->____st != NULL) {
+				____cswiftslash_fifo_stats_wait_ended(_, _->____st->____ws);
+			}
+			__0 = 0;
+			goto returnTime;
+		}
+		const __cswiftslash_fifo_link_ptr_t __2 = ____cswiftslash_fifo_link_take(_, __);
 		if (____cswiftslash_fifo_pass_link(_, __2) == false) {
-			free(__2);
+			____cswiftslash_fifo_link_give(_, __2);
 			__0 = 1;
 			goto returnTime;
 		}
 		atomic_fetch_add_explicit(&_->____ec, 1, memory_order_acq_rel);
-		bool __3 = true;
-		if (atomic_compare_exchange_weak_explicit(&_->____iwlk, &__3, false, memory_order_acq_rel, memory_order_relaxed) == true) {
-			pthread_mutex_unlock(&_->____wm);
-		}
+		____cswiftslash_fifo_stats_passed(_, 1);
+		____cswiftslash_fifo_wake_blocked(_);
+		____cswiftslash_fifo_chain_wake(_);
 		__0 = 0;
 		goto returnTime;
 	} else {
@@ -234,39 +790,122 @@ int8_t __cswiftslash_fifo_pass(
 		if (_->____hm == true) {
 			pthread_mutex_unlock(&_->____m);
 		}
+		if (__4 != NULL) {
+			__4(__CSWIFTSLASH_FIFO_CONSUME_RESULT, __, __5);
+		}
 		return __0;
 }
 
-/// internal function that flushes a single entry.
-///	@param _ the pre-loaded atomic base pointer of the chain.
-///	@param __ the chain that this operation will act on.
-///	@param ___ the pointer that will be set to the consumed pointer.
-/// - returns: true if the operation was successful and the element count could be decremented. false if the operation was not successful.
-bool ____cswiftslash_fifo_consume_next(
-	__cswiftslash_fifo_link_ptr_t _,
-	const __cswiftslash_fifo_linkpair_ptr_t __,
-	__cswiftslash_ptr_t *_Nonnull ___
+/// internal function that passes a batch of data pointers into the ring of a fifo. the batch is published with a single release store.
+/// @param _ the ring fifo to pass the data pointers into.
+/// @param __ pointer to the first of the data pointers to pass.
+/// @param ___ the number of data pointers to pass.
+/// @param ____ pointer where the number of data pointers that were passed will be written.
+/// @return `0` when every data pointer was passed. `-1` when the fifo is capped. `-2` when the ring filled before every data pointer could be passed.
+int8_t ____cswiftslash_fifo_ring_pass_many(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t *_Nonnull __,
+	const size_t ___,
+	size_t *_Nonnull ____
 ) {
-	if (_ == NULL) {
-		return false;
+	__cswiftslash_fifo_ring_t *_Nonnull __0 = _->____rb;
+	*____ = 0;
+	if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+		return -1;
 	}
-	__cswiftslash_fifo_link_ptr_t __0 = atomic_load_explicit(&_->__, memory_order_acquire);
-	if (atomic_compare_exchange_weak_explicit(&__->____bp, &_, __0, memory_order_acq_rel, memory_order_relaxed) == true) {
-		if (__0 == NULL) {
-			atomic_store_explicit(&__->____tp, NULL, memory_order_release);
+	const size_t __1 = atomic_load_explicit(&__0->____t, memory_order_relaxed);
+	size_t __2 = (__0->____mk + 1) - (__1 - __0->____ch);
+	if (__2 < ___) {
+		__0->____ch = atomic_load_explicit(&__0->____h, memory_order_acquire);
+		__2 = (__0->____mk + 1) - (__1 - __0->____ch);
+	}
+	const size_t __3 = (__2 < ___) ? __2 : ___;
+	for (size_t __4 = 0; __4 < __3; __4++) {
+		__0->____s[(__1 + __4) & __0->____mk] = __[__4];
+	}
+	*____ = __3;
+	if (__3 > 0) {
+		____cswiftslash_fifo_stats_passed(_, __3);
+		atomic_store_explicit(&__0->____t, __1 + __3, memory_order_release);
+		atomic_thread_fence(memory_order_seq_cst);
+		if (atomic_load_explicit(&_->____rw, memory_order_relaxed) == true) {
+			____cswiftslash_fifo_ring_wake(_);
 		}
-		atomic_fetch_sub_explicit(&__->____ec, 1, memory_order_acq_rel);
-		*___ = _->_;
-		free((void*)_);
-		return true;
 	}
-	return false;
+	return (__3 == ___) ? 0 : -2;
+}
+
+int8_t __cswiftslash_fifo_pass_many(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t *_Nonnull __,
+	const size_t ___,
+	size_t *_Nonnull ____
+) {
+	if (_->____rb != NULL) {
+		return ____cswiftslash_fifo_ring_pass_many(_, __, ___, ____);
+	}
+	int8_t __0 = 0;
+	size_t __1 = ___;
+	size_t __2 = 0;
+	__cswiftslash_fifo_waiter_f _Nullable __3 = NULL;
+	__cswiftslash_optr_t __4 = NULL;
+	*____ = 0;
+	if (_->____hm == true) {
+		pthread_mutex_lock(&_->____m);
+	}
+	if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+		__0 = -1;
+		goto returnTime;
+	}
+	if (atomic_load_explicit(&_->____hme, memory_order_acquire) == true) {
+		const size_t __5 = atomic_load_explicit(&_->____ec, memory_order_acquire);
+		const size_t __6 = atomic_load_explicit(&_->____me, memory_order_acquire);
+		const size_t __7 = (__5 >= __6) ? 0 : (__6 - __5);
+		if (__7 < __1) {
+			__1 = __7;
+			__0 = -2;
+		}
+	}
+	if (__1 > 0) {
+		__3 = ____cswiftslash_fifo_waiter_claim(_, &__4);
+	}
+	if (__3 != NULL) {
+		// a consumer is waiting. the first element of the batch is handed off directly (once the state mutex is released) and the remainder is stored in the chain.
+		__2 = 1;
+		if (_->____st != NULL) {
+			____cswiftslash_fifo_stats_wait_ended(_, _->____st->____ws);
+		}
+	}
+	for (size_t __8 = __2; __8 < __1; __8++) {
+		const __cswiftslash_fifo_link_ptr_t __9 = ____cswiftslash_fifo_link_take(_, __[__8]);
+		// the state mutex is held, so a failed exchange is spurious and can be retried immediately.
+		while (____cswiftslash_fifo_pass_link(_, __9) == false) {}
+	}
+	____cswiftslash_fifo_stats_passed(_, __1);
+	____cswiftslash_fifo_stats_consumed(_, __2);
+	if (__1 > __2) {
+		atomic_fetch_add_explicit(&_->____ec, __1 - __2, memory_order_acq_rel);
+		____cswiftslash_fifo_wake_blocked(_);
+		____cswiftslash_fifo_chain_wake(_);
+	}
+	*____ = __1;
+	returnTime:
+		if (_->____hm == true) {
+			pthread_mutex_unlock(&_->____m);
+		}
+		if (__3 != NULL) {
+			__3(__CSWIFTSLASH_FIFO_CONSUME_RESULT, __[0], __4);
+		}
+		return __0;
 }
 
 __cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_nonblocking(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
 	__cswiftslash_optr_t *_Nonnull __
 ) {
+	if (_->____rb != NULL) {
+		return ____cswiftslash_fifo_ring_consume(_, __);
+	}
 	if (_->____hm == true) {
 		pthread_mutex_lock(&_->____m);
 	}
@@ -296,15 +935,29 @@ __cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_nonblocking(
 		return __0;
 }
 
-__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking(
+/// internal function that consumes the next data pointer in the chain, blocking the calling thread until an element or cap is available (or the deadline passes).
+/// @param _ the fifo to consume from.
+/// @param __ the pointer that will be set to the consumed pointer (or the cap pointer).
+/// @param ___ pointer to the deadline of the wait, or `NULL` to wait without a deadline.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` is returned when the deadline passes.
+__cswiftslash_fifo_consume_result_t ____cswiftslash_fifo_consume_blocking_deadline(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
-	__cswiftslash_optr_t*_Nonnull __
+	__cswiftslash_optr_t *_Nonnull __,
+	const uint64_t *_Nullable ___
 ) {
+	if (_->____rb != NULL) {
+		return ____cswiftslash_fifo_ring_consume_blocking(_, __, ___);
+	}
+	// the state mutex guards the wait when the fifo has one. a fifo without a state mutex waits under its dedicated wait mutex, which producers also take to wake the consumer.
+	pthread_mutex_t *_Nonnull __0 = (_->____hm == true) ? &_->____m : &_->____wm;
+	pthread_mutex_lock(__0);
+	if (____cswiftslash_fifo_waiter_stored(_) == true || atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+		printf("swiftslash fifo internal error: a consumer is already waiting on this fifo\n");
+		abort();
+	}
+	__cswiftslash_fifo_consume_result_t __1;
+	bool __2 = false;
 	loadAgain:
-		if (_->____hm == true) {
-			pthread_mutex_lock(&_->____m);
-		}
-		__cswiftslash_fifo_consume_result_t __1;
 		if (atomic_load_explicit(&_->____ec, memory_order_acquire) > 0) {
 			if (____cswiftslash_fifo_consume_next(atomic_load_explicit(&_->____bp, memory_order_acquire), _, __)) {
 				__1 = __CSWIFTSLASH_FIFO_CONSUME_RESULT;
@@ -313,28 +966,176 @@ __cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking(
 				__1 = __CSWIFTSLASH_FIFO_CONSUME_INTERNAL_ERROR;
 				goto returnTime;
 			}
+		} else if (atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+			*__ = atomic_load_explicit(&_->____cp, memory_order_acquire);
+			__1 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
+			goto returnTime;
+		} else if (__2 == true) {
+			__1 = __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK;
+			goto returnTime;
+		}
+		atomic_store_explicit(&_->____iwlk, true, memory_order_release);
+		// the chain is observed once more after the deadline passes, in case an element landed as the wait timed out.
+		const uint64_t __3 = ____cswiftslash_fifo_stats_wait_began(_);
+		__2 = (____cswiftslash_fifo_wait(_, __0, ___) == false);
+		____cswiftslash_fifo_stats_wait_ended(_, __3);
+		goto loadAgain;
+	returnTime:
+		atomic_store_explicit(&_->____iwlk, false, memory_order_release);
+		pthread_mutex_unlock(__0);
+		return __1;
+}
+
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t*_Nonnull __
+) {
+	return ____cswiftslash_fifo_consume_blocking_deadline(_, __, NULL);
+}
+
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking_until(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t*_Nonnull __,
+	const uint64_t ___
+) {
+	return ____cswiftslash_fifo_consume_blocking_deadline(_, __, &___);
+}
+
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_async(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t*_Nonnull __,
+	const __cswiftslash_fifo_waiter_f _Nonnull ___,
+	const __cswiftslash_optr_t ____
+) {
+	if (_->____rb != NULL) {
+		return ____cswiftslash_fifo_ring_consume_async(_, __, ___, ____);
+	}
+	if (_->____hm == true) {
+		pthread_mutex_lock(&_->____m);
+	}
+	__cswiftslash_fifo_consume_result_t __0;
+	loadAgain:
+		if (atomic_load_explicit(&_->____ec, memory_order_acquire) > 0) {
+			if (____cswiftslash_fifo_consume_next(atomic_load_explicit(&_->____bp, memory_order_acquire), _, __) == true) {
+				__0 = __CSWIFTSLASH_FIFO_CONSUME_RESULT;
+				goto returnTime;
+			} else {
+				__0 = __CSWIFTSLASH_FIFO_CONSUME_INTERNAL_ERROR;
+				goto returnTime;
+			}
 		} else {
 			if (atomic_load_explicit(&_->____ic, memory_order_acquire) == false) {
-				bool __2 = false;
-				if (atomic_compare_exchange_weak_explicit(&_->____iwlk, &__2, true, memory_order_acq_rel, memory_order_relaxed) == false) {
+				if (____cswiftslash_fifo_waiter_stored(_) == true || atomic_load_explicit(&_->____iwlk, memory_order_acquire) == true) {
+					printf("swiftslash fifo internal error: a consumer is already waiting on this fifo\n");
 					abort();
 				}
-				goto blockForNext;
+				if (_->____st != NULL) {
+					_->____st->____ws = __cswiftslash_timer_now();
+				}
+				____cswiftslash_fifo_waiter_store(_, ___, ____);
+				if (_->____hm == false) {
+					// producers do not serialize with this consumer, so the chain and cap are checked once more after the waiter is published. this fence pairs with the fences on the producing side, so that either this check observes their element (or cap) or they observe the waiter.
+					atomic_thread_fence(memory_order_seq_cst);
+					if (atomic_load_explicit(&_->____ec, memory_order_acquire) > 0 || atomic_load_explicit(&_->____ic, memory_order_acquire) == true) {
+						__cswiftslash_optr_t __1 = NULL;
+						if (____cswiftslash_fifo_waiter_claim(_, &__1) != NULL) {
+							// the waiter was taken back before any producer claimed it.
+							goto loadAgain;
+						}
+						// a producer claimed the waiter and will fire it.
+					}
+				}
+				__0 = __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK;
+				goto returnTime;
 			} else {
 				*__ = atomic_load_explicit(&_->____cp, memory_order_acquire);
-				__1 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
+				__0 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
 				goto returnTime;
 			}
 		}
-	blockForNext:
-		if (_->____hm) {
+	returnTime:
+		if (_->____hm == true) {
 			pthread_mutex_unlock(&_->____m);
 		}
-		pthread_mutex_lock(&_->____wm);
-		goto loadAgain;
+		return __0;
+}
+
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_all(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_fifo_link_ptr_consume_f _Nonnull __,
+	const __cswiftslash_optr_t ___,
+	__cswiftslash_optr_t *_Nonnull ____
+) {
+	if (_->____rb != NULL) {
+		// the ring is drained from the consuming side without a lock. the consumer index is published once for the entire batch.
+		__cswiftslash_fifo_ring_t *_Nonnull __0 = _->____rb;
+		const size_t __1 = atomic_load_explicit(&__0->____h, memory_order_relaxed);
+		__0->____ct = atomic_load_explicit(&__0->____t, memory_order_acquire);
+		if (__1 == __0->____ct) {
+			return ____cswiftslash_fifo_ring_consume(_, ____);
+		}
+		for (size_t __2 = __1; __2 != __0->____ct; __2++) {
+			__(__0->____s[__2 & __0->____mk], ___);
+		}
+		atomic_store_explicit(&__0->____h, __0->____ct, memory_order_release);
+		____cswiftslash_fifo_stats_consumed(_, __0->____ct - __1);
+		return __CSWIFTSLASH_FIFO_CONSUME_RESULT;
+	}
+	if (_->____hm == true) {
+		pthread_mutex_lock(&_->____m);
+	}
+	__cswiftslash_fifo_consume_result_t __0;
+	__cswiftslash_fifo_link_ptr_t __1 = atomic_load_explicit(&_->____bp, memory_order_acquire);
+	if (__1 == NULL) {
+		if (atomic_load_explicit(&_->____ic, memory_order_acquire) == false) {
+			__0 = __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK;
+			goto returnTime;
+		} else {
+			*____ = atomic_load_explicit(&_->____cp, memory_order_acquire);
+			__0 = __CSWIFTSLASH_FIFO_CONSUME_CAP;
+			goto returnTime;
+		}
+	}
+	// detach the entire chain, then hand each element to the consumer function and recycle its link.
+	atomic_store_explicit(&_->____bp, NULL, memory_order_release);
+	atomic_store_explicit(&_->____tp, NULL, memory_order_release);
+	atomic_store_explicit(&_->____ec, 0, memory_order_release);
+	size_t __3 = 0;
+	while (__1 != NULL) {
+		__cswiftslash_fifo_link_ptr_t __2 = atomic_load_explicit(&__1->__, memory_order_acquire);
+		__(__1->_, ___);
+		____cswiftslash_fifo_link_give(_, __1);
+		__1 = __2;
+		__3 += 1;
+	}
+	____cswiftslash_fifo_stats_consumed(_, __3);
+	__0 = __CSWIFTSLASH_FIFO_CONSUME_RESULT;
 	returnTime:
-		if (_->____hm) {
+		if (_->____hm == true) {
 			pthread_mutex_unlock(&_->____m);
 		}
-		return __1;
+		return __0;
+}
+
+bool __cswiftslash_fifo_revoke_waiter(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t __
+) {
+	bool __0 = false;
+	if (_->____hm == true) {
+		pthread_mutex_lock(&_->____m);
+	}
+	__cswiftslash_fifo_waiter_optr_f __1 = atomic_load_explicit(&_->____wf, memory_order_acquire);
+	// the waiter is only revoked if it is still the one that was stored with this context. the exchange fails if a producer claims the waiter first.
+	if (__1 != NULL && atomic_load_explicit(&_->____wc, memory_order_relaxed) == __ && atomic_compare_exchange_strong_explicit(&_->____wf, &__1, NULL, memory_order_acq_rel, memory_order_acquire) == true) {
+		atomic_store_explicit(&_->____rw, false, memory_order_relaxed);
+		if (_->____st != NULL) {
+			____cswiftslash_fifo_stats_wait_ended(_, _->____st->____ws);
+		}
+		__0 = true;
+	}
+	if (_->____hm == true) {
+		pthread_mutex_unlock(&_->____m);
+	}
+	return __0;
 }
\ No newline at end of file
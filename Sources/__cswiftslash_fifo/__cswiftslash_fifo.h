@@ -13,11 +13,22 @@ copyright (c) tanner silva 2025. all rights reserved.
 #define __CLIBSWIFTSLASH_FIFO_H
 
 #include "__cswiftslash_types.h"
+#include "__cswiftslash_pool.h"
 
 #include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 
+/// the size of a cache line on the target architecture. used to keep the producer and consumer indices of a ring on separate cache lines.
+#if defined(__APPLE__) && defined(__aarch64__)
+#define __CSWIFTSLASH_FIFO_CACHE_LINE 128
+#else
+#define __CSWIFTSLASH_FIFO_CACHE_LINE 64
+#endif
+
+/// the maximum number of consumed links that a fifo will hold for reuse. links that are consumed beyond this count are freed.
+#define __CSWIFTSLASH_FIFO_LINK_POOL_MAX 128
+
 /// forward declaration of the fifo link structure. represents a single link (a single element) in a chain of n number of elements. a foundational structure for the fifo mechanism.
 struct __cswiftslash_fifo_link;
 
@@ -29,7 +40,7 @@ typedef _Atomic __cswiftslash_fifo_link_ptr_t __cswiftslash_fifo_link_aptr_t;
 
 /// function prototype for consuming data from the chain.
 typedef void (* __cswiftslash_fifo_link_ptr_consume_f)(
-	const __cswiftslash_ptr_t,
+	const __cswiftslash_optr_t,
 	const __cswiftslash_optr_t
 );
 
@@ -47,12 +58,53 @@ typedef enum __cswiftslash_fifo_consume_result {
 
 } __cswiftslash_fifo_consume_result_t;
 
+/// function prototype for a consumer waiter. a stored waiter is fired exactly once, from the thread that passes the next element (or cap) into the fifo.
+/// @param _ the result of the consumption operation. this will be either `__CSWIFTSLASH_FIFO_CONSUME_RESULT` or `__CSWIFTSLASH_FIFO_CONSUME_CAP`.
+/// @param __ the consumed data pointer, or the cap pointer of the fifo.
+/// @param ___ the context pointer that was stored with the waiter.
+typedef void (* __cswiftslash_fifo_waiter_f)(
+	const __cswiftslash_fifo_consume_result_t,
+	const __cswiftslash_optr_t,
+	const __cswiftslash_optr_t
+);
+
+/// a nullable consumer waiter function pointer.
+typedef __cswiftslash_fifo_waiter_f _Nullable __cswiftslash_fifo_waiter_optr_f;
+
+/// defines an atomic version of `__cswiftslash_fifo_waiter_optr_f`, so that a waiter can be stored and claimed safely on fifos that are initialized without a state mutex.
+typedef _Atomic __cswiftslash_fifo_waiter_optr_f __cswiftslash_fifo_waiter_aptr_f;
+
 /// structure representing a single link within the fifo, stores a data item and a pointer to the next chain item.
 typedef struct __cswiftslash_fifo_link {
-	const __cswiftslash_ptr_t _;
+	__cswiftslash_optr_t _;
 	__cswiftslash_fifo_link_aptr_t __;
 } __cswiftslash_fifo_link_t;
 
+/// structure representing a bounded single-producer single-consumer ring of data pointers. the consumer index and the producer index live on separate cache lines, and each side caches its last observation of the opposing index so that the shared line is only touched when the ring appears empty (or full).
+typedef struct __cswiftslash_fifo_ring {
+	_Alignas(__CSWIFTSLASH_FIFO_CACHE_LINE) _Atomic size_t ____h;
+	size_t ____ct;
+	_Alignas(__CSWIFTSLASH_FIFO_CACHE_LINE) _Atomic size_t ____t;
+	size_t ____ch;
+	_Alignas(__CSWIFTSLASH_FIFO_CACHE_LINE) size_t ____mk;
+	__cswiftslash_optr_t ____s[];
+} __cswiftslash_fifo_ring_t;
+
+/// a nullable pointer to a fifo ring structure.
+typedef __cswiftslash_fifo_ring_t *_Nullable __cswiftslash_fifo_ring_ptr_t;
+
+/// structure holding the introspection counters of a fifo. these counters are only maintained when statistics are enabled on the fifo with `__cswiftslash_fifo_enable_statistics`. NOTE: none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_fifo_stats {
+	_Atomic uint64_t ____tp;
+	_Atomic uint64_t ____tc;
+	_Atomic size_t ____hw;
+	_Atomic uint64_t ____bt;
+	uint64_t ____ws;
+} __cswiftslash_fifo_stats_t;
+
+/// a nullable pointer to the introspection counters of a fifo.
+typedef __cswiftslash_fifo_stats_t *_Nullable __cswiftslash_fifo_stats_ptr_t;
+
 /// structure representing a pair of pointers to the head and tail of a fifo, enabling efficient management and access to both ends of the chain. stores an assortment of other metadata to facilitate efficient and safe operation of the fifo mechanism. NOTE: none of the fields in this structure need to be accessed directly by the caller.
 typedef struct __cswiftslash_fifo_linkpair {
 	__cswiftslash_fifo_link_aptr_t ____bp;
@@ -64,8 +116,15 @@ typedef struct __cswiftslash_fifo_linkpair {
 	pthread_mutex_t ____m;
 	_Atomic bool ____iwlk;
 	pthread_mutex_t ____wm;
+	pthread_cond_t ____wv;
 	_Atomic bool ____hme;
 	_Atomic size_t ____me;
+	__cswiftslash_fifo_waiter_aptr_f ____wf;
+	_Atomic __cswiftslash_optr_t ____wc;
+	__cswiftslash_pool_t ____lp;
+	__cswiftslash_fifo_ring_ptr_t ____rb;
+	_Atomic bool ____rw;
+	__cswiftslash_fifo_stats_ptr_t ____st;
 } __cswiftslash_fifo_linkpair_t;
 
 /// defines a non-null pointer to a fifo pair structure, facilitating operations on the entire chain.
@@ -78,15 +137,46 @@ __cswiftslash_fifo_linkpair_ptr_t __cswiftslash_fifo_init(
 	const bool _
 );
 
+/// initializes a new fifo that stores its elements in a bounded ring rather than a linked chain. the ring is designed for exactly one producing thread and one consuming thread - elements are exchanged through the ring using acquire/release ordering only, and the state mutex is only taken when a consumer needs to wait (or be woken). passes into a full ring return `-2`, as with a fifo that has reached its maximum element count.
+/// @param _ the number of elements the ring can hold. this value is rounded up to the next power of two.
+/// @return a heap pointer to a newly initialized `_cswiftslash_fifo_linkpair_t`. NOTE: this pointer must be closed with `__cswiftslash_fifo_close` to free all associated memory.
+__cswiftslash_fifo_linkpair_ptr_t __cswiftslash_fifo_init_ring(
+	const size_t _
+);
+
 /// sets the maximum number of elements that can be buffered by the fifo if there is not a consumer immediately available.
 /// @param _ pointer to the fifo to assign the element limit to.
 /// @param __ the maximum number of elements that can be stored in the chain.
-/// @return `true` if the max elements was successfully set; `false` if the max elements could not be set.
+/// @return `true` if the max elements was successfully set; `false` if the max elements could not be set. the max elements of a ring fifo cannot be set.
 bool __cswiftslash_fifo_set_max_elements(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
 	const size_t __
 );
 
+/// enables the introspection counters of a fifo. once enabled, the fifo tracks its current depth, the highest depth it has reached, the total number of elements passed and consumed, and the cumulative time a consumer has spent waiting for an element. NOTE: this function must be called before the fifo is shared with another thread.
+/// @param _ pointer to the fifo to enable the counters on.
+/// @return `true` if the counters were enabled; `false` if the counters were already enabled.
+bool __cswiftslash_fifo_enable_statistics(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+);
+
+/// reads a snapshot of the introspection counters of a fifo. each counter is read atomically, but the counters are not read as a single atomic unit, so the snapshot may straddle a concurrent pass or consume.
+/// @param _ pointer to the fifo to read the counters from.
+/// @param __ pointer where the number of elements currently buffered by the fifo will be written.
+/// @param ___ pointer where the highest number of elements the fifo has buffered will be written.
+/// @param ____ pointer where the total number of elements passed into the fifo will be written.
+/// @param _____ pointer where the total number of elements consumed from the fifo will be written.
+/// @param ______ pointer where the cumulative number of nanoseconds that consumers have spent waiting for an element will be written.
+/// @return `true` if the counters were read; `false` if statistics are not enabled on the fifo, in which case nothing is written.
+bool __cswiftslash_fifo_statistics(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	size_t *_Nonnull __,
+	size_t *_Nonnull ___,
+	uint64_t *_Nonnull ____,
+	uint64_t *_Nonnull _____,
+	uint64_t *_Nonnull ______
+);
+
 /// deinitializes a fifo instance, freeing all associated memory and resources.
 /// @param _ pointer to the fifo to be deinitialized.
 /// @param __ function used for deallocating the unconsumed elements in the chain.
@@ -100,6 +190,13 @@ bool __cswiftslash_fifo_close(
 	__cswiftslash_optr_t *_Nonnull ____
 );
 
+/// returns the number of links that have been allocated by the fifo over its lifetime. consumed links are recycled by a fifo with a state mutex, so this value grows with the peak number of buffered elements rather than the total number of elements passed. a fifo without a state mutex does not recycle links.
+/// @param _ pointer to the fifo to query.
+/// @return the total number of link allocations made by the fifo.
+size_t __cswiftslash_fifo_link_allocations(
+	const __cswiftslash_fifo_linkpair_ptr_t _
+);
+
 /// cap off the fifo with a final element. any elements passed into the chain after capping it off will be stored and handled by the deallocator when this instance is closed (they will not be passed to a consumer, nor will they be forever leaked into memory).
 /// @param _ pointer to the fifo to be capped.
 /// @param __ pointer to the final element to be added to the chain.
@@ -111,11 +208,24 @@ bool __cswiftslash_fifo_pass_cap(
 
 /// inserts a new data pointer into the chain for storage and future processing. if the chain is capped, the data will be stored and handled by the deallocator when this instance is closed (it will not be passed to a consumer).
 /// @param _ pointer to the fifo that will store the new data.
-/// @param __ data pointer to be stored in the chain.
+/// @param __ data pointer to be stored in the chain. the pointer is never dereferenced by the fifo and may be NULL, which allows callers to store raw bit patterns in place of allocated data.
 /// @return `0` on success. `1` when a retry should be done on the function call. `-1` when the fifo is capped and no retry is necessary. `-2` will be returned if the maximum number of elements has been reached.
 int8_t __cswiftslash_fifo_pass(
 	const __cswiftslash_fifo_linkpair_ptr_t _,
-	const __cswiftslash_ptr_t __
+	const __cswiftslash_optr_t __
+);
+
+/// inserts a batch of data pointers into the chain under a single acquisition of the state mutex. the data pointers are passed in order, and a waiting consumer (if any) is woken once for the entire batch.
+/// @param _ pointer to the fifo that will store the new data.
+/// @param __ pointer to the first of the data pointers to be stored in the chain.
+/// @param ___ the number of data pointers to be stored in the chain.
+/// @param ____ pointer where the number of data pointers that were stored in the chain will be written. data pointers beyond this count were not stored and remain owned by the caller.
+/// @return `0` when every data pointer was stored. `-1` when the fifo is capped and no data pointers were stored. `-2` when the maximum number of elements was reached before every data pointer could be stored.
+int8_t __cswiftslash_fifo_pass_many(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t *_Nonnull __,
+	const size_t ___,
+	size_t *_Nonnull ____
 );
 
 /// consumes the next data pointer in the chain, removing it from the chain and returning it to the caller.
@@ -136,4 +246,50 @@ __cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking(
 	__cswiftslash_optr_t *_Nonnull __
 );
 
+/// consumes every data pointer that is currently stored in the chain under a single acquisition of the state mutex. the consumed data pointers are handed to the consumer function in the order they were passed. NOTE: the consumer function is called while the state mutex is held and must not call back into the fifo.
+/// @param _ pointer to the fifo where data will be consumed.
+/// @param __ the function that each consumed data pointer is handed to.
+/// @param ___ the context pointer to be passed to the consumer function.
+/// @param ____ pointer to the cap pointer. this is only written to when the function returns `__CSWIFTSLASH_FIFO_CONSUME_CAP`.
+/// @return `__CSWIFTSLASH_FIFO_CONSUME_RESULT` when one or more data pointers were consumed. `__CSWIFTSLASH_FIFO_CONSUME_CAP` when the chain is empty and capped. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` when the chain is empty.
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_all(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_fifo_link_ptr_consume_f _Nonnull __,
+	const __cswiftslash_optr_t ___,
+	__cswiftslash_optr_t *_Nonnull ____
+);
+
+/// consumes the next data pointer in the chain, removing it from the chain and returning it to the caller. NOTE: if the chain is empty, the function will block until a new element is added to the chain or the deadline passes.
+/// @param _ pointer to the fifo where data will be consumed.
+/// @param __ pointer to the consumed data pointer.
+/// @param ___ the deadline of the wait, expressed as an absolute number of nanoseconds on the clock that is read by `__cswiftslash_timer_now`.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` is returned when the deadline passes before an element (or cap) is available.
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_blocking_until(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	const uint64_t ___
+);
+
+/// consumes the next data pointer in the chain without blocking the calling thread. if the chain is empty, the waiter function is stored in the fifo and fired exactly once with the next element (or cap) that is passed into the chain. the element is handed directly to the waiter and is never stored in the chain.
+/// @param _ pointer to the fifo where data will be consumed.
+/// @param __ pointer to the consumed data pointer. this is only written to when the function returns `__CSWIFTSLASH_FIFO_CONSUME_RESULT` or `__CSWIFTSLASH_FIFO_CONSUME_CAP`.
+/// @param ___ the waiter function to store if the chain is empty.
+/// @param ____ the context pointer to be passed to the waiter function when it is fired.
+/// @return the result of the consumption operation. `__CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK` indicates that the waiter was stored and will be fired at a later time. any other result indicates that the waiter was not stored and will never be fired.
+__cswiftslash_fifo_consume_result_t __cswiftslash_fifo_consume_async(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	__cswiftslash_optr_t *_Nonnull __,
+	const __cswiftslash_fifo_waiter_f _Nonnull ___,
+	const __cswiftslash_optr_t ____
+);
+
+/// removes a waiter that was stored by `__cswiftslash_fifo_consume_async` before it is fired. this allows a suspended consumer to give up waiting at a deadline.
+/// @param _ pointer to the fifo that the waiter is stored in.
+/// @param __ the context pointer that the waiter was stored with.
+/// @return `true` if the waiter was removed and will never be fired. `false` if the waiter is not stored in the fifo (it has been fired, or is being fired).
+bool __cswiftslash_fifo_revoke_waiter(
+	const __cswiftslash_fifo_linkpair_ptr_t _,
+	const __cswiftslash_optr_t __
+);
+
 #endif // __CLIBSWIFTSLASH_FIFO_H
\ No newline at end of file
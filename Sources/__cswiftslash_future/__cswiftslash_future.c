@@ -9,8 +9,11 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 */
 
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
 #include "__cswiftslash_future.h"
-#include "__cswiftslash_identified_list.h"
 
 #include <stdatomic.h>
 #include <stdbool.h>
@@ -18,11 +21,51 @@ copyright (c) tanner silva 2025. all rights reserved.
 #include <string.h>
 #include <stdio.h>
 
-/// an internal tool to help with the identified list iterator.
-struct ____cswiftslash_future_identified_list_tool {
-	const uint8_t _;
-	const __cswiftslash_optr_t __;
-};
+#if defined(__APPLE__)
+#include <os/os_sync_wait_on_address.h>
+#else
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// the bits of the future state word that hold the status of the future. the remaining bits hold the address of the top link in the waiter stack (links are always aligned well beyond these bits).
+#define ____CSWIFTSLASH_FUTURE_STATUS_MASK ((uintptr_t)3)
+
+/// the bit of a link state word that is set once the link has been claimed (by the resolving thread or by an invalidation). the remaining bits hold the identifier of the waiter that occupies the link, so a claim only succeeds for the identifier that is current.
+#define ____CSWIFTSLASH_FUTURE_LINK_CLAIMED ((uint64_t)1)
+
+/// the bits of a waiter identifier generation. the generation occupies the upper half of the identifier and is kept below the top bit, so the identifier can be shifted into a link state word.
+#define ____CSWIFTSLASH_FUTURE_GENERATION_MASK ((uint64_t)0x7fffffff)
+
+/// the bits of the free list head (and of a waiter identifier) that hold a link index plus one. zero means no link.
+#define ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK ((uint64_t)0xffffffff)
+
+/// parks the calling thread until the value at the specified address is no longer the expected value. spurious returns are possible, so callers must check the value again after returning.
+/// @param _ the address to park on.
+/// @param __ the value that the address is expected to hold while parked.
+void ____cswiftslash_future_park(
+	_Atomic uint32_t *_Nonnull _,
+	const uint32_t __
+) {
+	#if defined(__APPLE__)
+	os_sync_wait_on_address((void *)_, (uint64_t)__, sizeof(uint32_t), OS_SYNC_WAIT_ON_ADDRESS_NONE);
+	#else
+	syscall(SYS_futex, (uint32_t *)_, FUTEX_WAIT_PRIVATE, __, NULL, NULL, 0);
+	#endif
+}
+
+/// wakes the thread that is parked on the specified address. the address may no longer belong to a parked waiter by the time this is called (a waiter may observe its new value and return before being woken), which is harmless since waking does not access the memory at the address.
+/// @param _ the address to wake.
+void ____cswiftslash_future_unpark(
+	_Atomic uint32_t *_Nonnull _
+) {
+	#if defined(__APPLE__)
+	os_sync_wake_by_address_any((void *)_, sizeof(uint32_t), OS_SYNC_WAKE_BY_ADDRESS_NONE);
+	#else
+	syscall(SYS_futex, (uint32_t *)_, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+	#endif
+}
 
 __cswiftslash_future_wait_t __cswiftslash_future_wait_t_init_struct() {
 	__cswiftslash_future_wait_t __0 = {
@@ -31,120 +74,341 @@ __cswiftslash_future_wait_t __cswiftslash_future_wait_t_init_struct() {
 		.____r = NULL,
 		.____e = NULL,
 		.____v = NULL,
-		.____ic = false
+		.____i = 0,
+		.____ws = __CSWIFTSLASH_FUTURE_WAIT_PARKED
 	};
 	return __0;
 }
 
-/// create a new synchronous waiter for a future.
+/// initialize a future waiter.
 /// @param _ the context pointer to pass to the result handler when it comes time to fire.
 /// @param __ the handler to call when the future is complete with a valid result.
 /// @param ___ the handler to call when the future is complete with an error.
 /// @param ____ the handler to call when the future is cancelled and a result will never be available.
-/// @param _____ a pointer to the memory space that the waiter structure will be initialized into.
-/// @return a pointer to the waiter structure on the heap.
-void ____cswiftslash_future_wait_t_init_sync(
+/// @param _____ `true` if the waiter is synchronous (the handlers are called from the blocking thread), `false` if the waiter is asynchronous (the handlers are called from the resolving thread).
+/// @param ______ a pointer to the memory space that the waiter structure will be initialized into.
+void ____cswiftslash_future_wait_t_init(
 	__cswiftslash_optr_t _,
 	__cswiftslash_future_result_val_handler_f __,
 	__cswiftslash_future_result_err_handler_f ___,
 	__cswiftslash_future_result_cncl_handler_f ____,
-	__cswiftslash_future_wait_ptr_t _____
+	const bool _____,
+	__cswiftslash_future_wait_ptr_t ______
 ) {
 	const __cswiftslash_future_wait_t __0 = {
 		.____c = _,
-		.____sy = true,
+		.____sy = _____,
 		.____r = (__cswiftslash_ptr_t)__,
 		.____e = (__cswiftslash_ptr_t)___,
 		.____v = (__cswiftslash_ptr_t)____,
-		.____ic = false
+		.____i = 0,
+		.____ws = __CSWIFTSLASH_FUTURE_WAIT_PARKED
 	};
-	memcpy(_____, &__0, sizeof(__cswiftslash_future_wait_t));
-	if (pthread_mutex_init(&_____->____rm, NULL) != 0) {
-		printf("swiftslash future internal error: couldn't initialize future sync_wait mutex\n");
-		abort();
+	memcpy(______, &__0, sizeof(__cswiftslash_future_wait_t));
+}
+
+/// internal function that returns the link at the specified index of a future. links are never freed before the future is destroyed, so this is safe to call with an index that was decoded from an untrusted waiter identifier.
+/// @param _ the future to look up the link in.
+/// @param __ the index of the link.
+/// @return the link, or NULL if the storage for the index has not been allocated.
+__cswiftslash_future_link_t *_Nullable ____cswiftslash_future_link_at(
+	const __cswiftslash_future_ptr_t _,
+	const uint32_t __
+) {
+	if (__ == 0) {
+		return &_->____l0;
+	}
+	const __cswiftslash_future_link_dir_optr_t __0 = atomic_load_explicit(&_->____ld, memory_order_acquire);
+	if (__0 == NULL) {
+		return NULL;
 	}
-	pthread_mutex_lock(&_____->____rm);
+	const uint32_t __1 = 31 - (uint32_t)__builtin_clz(__);
+	__cswiftslash_future_link_t *_Nullable __2 = atomic_load_explicit(&__0[__1], memory_order_acquire);
+	if (__2 == NULL) {
+		return NULL;
+	}
+	return &__2[__ - ((uint32_t)1 << __1)];
 }
 
-/// create a new asynchronous waiter for a future.
-/// @param _ the context pointer to pass to the result handler when it comes time to fire.
-/// @param __ the handler to call when the future is complete with a valid result.
-/// @param ___ the handler to call when the future is complete with an error.
-/// @param ____ the handler to call when the future is cancelled and a result will never be available.
-/// @return the waiter structure.
-__cswiftslash_future_wait_ptr_t ____cswiftslash_future_wait_t_init_async(__cswiftslash_optr_t _, __cswiftslash_future_result_val_handler_f __, __cswiftslash_future_result_err_handler_f ___, __cswiftslash_future_result_cncl_handler_f ____) {
-	__cswiftslash_future_wait_t __0 = {
-		.____c = _,
-		.____sy = false,
-		.____r = (__cswiftslash_ptr_t)__,
-		.____e = (__cswiftslash_ptr_t)___,
-		.____v = (__cswiftslash_ptr_t)____,
-		.____ic = false
-	};
-	__cswiftslash_future_wait_ptr_t __1 = malloc(sizeof(__cswiftslash_future_wait_t));
-	memcpy(__1, &__0, sizeof(__cswiftslash_future_wait_t));
-	return __1;
+/// internal function that returns the storage for a new link, installing the chunk directory and the chunk that contains the index if another thread has not already done so.
+/// @param _ the future to allocate the link in.
+/// @param __ the index of the new link.
+/// @return the link at the specified index.
+__cswiftslash_future_link_t *_Nonnull ____cswiftslash_future_link_alloc(
+	const __cswiftslash_future_ptr_t _,
+	const uint32_t __
+) {
+	if (__ == 0) {
+		return &_->____l0;
+	}
+	__cswiftslash_future_link_dir_optr_t __0 = atomic_load_explicit(&_->____ld, memory_order_acquire);
+	if (__0 == NULL) {
+		__cswiftslash_future_link_dir_optr_t __1 = calloc(__CSWIFTSLASH_FUTURE_LINK_CHUNKS, sizeof(__cswiftslash_future_link_aptr_t));
+		if (__1 == NULL) {
+			printf("swiftslash future internal error: couldn't allocate future link directory\n");
+			abort();
+		}
+		if (atomic_compare_exchange_strong_explicit(&_->____ld, &__0, __1, memory_order_acq_rel, memory_order_acquire) == true) {
+			__0 = __1;
+		} else {
+			free(__1);
+		}
+	}
+	const uint32_t __2 = 31 - (uint32_t)__builtin_clz(__);
+	__cswiftslash_future_link_t *_Nullable __3 = atomic_load_explicit(&__0[__2], memory_order_acquire);
+	if (__3 == NULL) {
+		// chunks are zeroed so that a link that is not yet in use never matches a waiter identifier.
+		__cswiftslash_future_link_t *_Nullable __4 = calloc((size_t)1 << __2, sizeof(__cswiftslash_future_link_t));
+		if (__4 == NULL) {
+			printf("swiftslash future internal error: couldn't allocate future waiter links\n");
+			abort();
+		}
+		if (atomic_compare_exchange_strong_explicit(&__0[__2], &__3, __4, memory_order_acq_rel, memory_order_acquire) == true) {
+			__3 = __4;
+		} else {
+			free(__4);
+		}
+	}
+	__cswiftslash_future_link_t *_Nonnull __5 = &__3[__ - ((uint32_t)1 << __2)];
+	__5->____x = __;
+	return __5;
 }
 
-/// @brief unlock and destroy a synchronous waiter result for a future.
-/// @param _ the waiter to destroy.
-void ____cswiftslash_future_wait_t_unlock_destroy_sync(__cswiftslash_future_wait_ptr_t _) {
-	pthread_mutex_unlock(&_->____rm);
-	pthread_mutex_destroy(&_->____rm);
+/// internal function that pops a link from the free list of a future. the head of the free list carries a tag that is advanced on every update, so a link that is popped and pushed again between the load and the exchange is detected.
+/// @param _ the future to pop a link from.
+/// @return a link whose waiter was fired or invalidated, or NULL if the free list is empty.
+__cswiftslash_future_link_t *_Nullable ____cswiftslash_future_link_pop(
+	const __cswiftslash_future_ptr_t _
+) {
+	uint64_t __0 = atomic_load_explicit(&_->____fh, memory_order_acquire);
+	while ((__0 & ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK) != 0) {
+		__cswiftslash_future_link_t *_Nonnull __1 = ____cswiftslash_future_link_at(_, (uint32_t)(__0 & ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK) - 1);
+		const uint64_t __2 = (((__0 >> 32) + 1) << 32) | atomic_load_explicit(&__1->____fn, memory_order_relaxed);
+		if (atomic_compare_exchange_weak_explicit(&_->____fh, &__0, __2, memory_order_acq_rel, memory_order_acquire) == true) {
+			return __1;
+		}
+	}
+	return NULL;
 }
 
-/// @brief destroy an asynchronous waiter for a future.
-/// @param _ the waiter to destroy.
-void ____cswiftslash_future_wait_t_destroy_async(__cswiftslash_future_wait_ptr_t _) {
-	free((void*)_);
+/// internal function that pushes a claimed link onto the free list of a future so that it can be reused by the next waiter. NOTE: the caller must be finished with the waiter of the link before calling this function.
+/// @param _ the future that the link belongs to.
+/// @param __ the link to release.
+void ____cswiftslash_future_link_release(
+	const __cswiftslash_future_ptr_t _,
+	__cswiftslash_future_link_t *_Nonnull __
+) {
+	uint64_t __0 = atomic_load_explicit(&_->____fh, memory_order_relaxed);
+	do {
+		atomic_store_explicit(&__->____fn, (uint32_t)(__0 & ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK), memory_order_relaxed);
+	} while (atomic_compare_exchange_weak_explicit(&_->____fh, &__0, (((__0 >> 32) + 1) << 32) | ((uint64_t)__->____x + 1), memory_order_release, memory_order_relaxed) == false);
 }
 
-void ____cswiftslash_future_identified_list_cancel_iterator(
-	const uint64_t _,
-	const __cswiftslash_ptr_t __,
-	const __cswiftslash_optr_t ___
+/// internal function that acquires a link for a new waiter. links whose waiters were invalidated are reused before new links are allocated, and the first link of every future is stored inline, so a future with a single waiter never allocates.
+/// @param _ the future to acquire a link from.
+/// @param __ set to `true` if the link is new and must be pushed onto the waiter stack, or `false` if the link was recycled (a recycled link keeps its place in the waiter stack).
+/// @return a link that is ready to be assigned a waiter.
+__cswiftslash_future_link_t *_Nonnull ____cswiftslash_future_link_acquire(
+	const __cswiftslash_future_ptr_t _,
+	bool *_Nonnull __
+) {
+	__cswiftslash_future_link_t *_Nullable __0 = ____cswiftslash_future_link_pop(_);
+	if (__0 != NULL) {
+		*__ = false;
+		return __0;
+	}
+	const uint32_t __1 = atomic_fetch_add_explicit(&_->____ln, 1, memory_order_relaxed);
+	if (__1 == UINT32_MAX) {
+		printf("swiftslash future internal error: too many concurrent future waiters\n");
+		abort();
+	}
+	__0 = ____cswiftslash_future_link_alloc(_, __1);
+	__0->____n = NULL;
+	*__ = true;
+	return __0;
+}
+
+/// internal function that pushes a link onto the waiter stack of a future, as long as the future is still pending.
+/// @param _ the future to push the link onto.
+/// @param __ the link to push.
+/// @return the status of the future. if the returned status is pending, the link was pushed. otherwise the link was not pushed and the future is resolved with the returned status.
+uint8_t ____cswiftslash_future_link_push(
+	const __cswiftslash_future_ptr_t _,
+	__cswiftslash_future_link_t *_Nonnull __
+) {
+	uintptr_t __0 = atomic_load_explicit(&_->____s, memory_order_acquire);
+	do {
+		if ((__0 & ____CSWIFTSLASH_FUTURE_STATUS_MASK) != __CSWIFTSLASH_FUTURE_STATUS_PEND) {
+			return (uint8_t)(__0 & ____CSWIFTSLASH_FUTURE_STATUS_MASK);
+		}
+		__->____n = (__cswiftslash_future_link_t *)__0;
+	} while (atomic_compare_exchange_weak_explicit(&_->____s, &__0, (uintptr_t)__, memory_order_seq_cst, memory_order_acquire) == false);
+	return __CSWIFTSLASH_FUTURE_STATUS_PEND;
+}
+
+/// internal function that stores a waiter in a future, or fires it immediately if the future is already resolved.
+/// @param _ the future to store the waiter in.
+/// @param __ the link that will store the waiter. the waiter of the link must be assigned before calling this function.
+/// @param ___ `true` if the link is new and must be pushed onto the waiter stack, `false` if the link was recycled.
+/// @return the unique identifier of the waiter, or zero if the future was already resolved and the waiter was fired immediately.
+uint64_t ____cswiftslash_future_wait_t_store(
+	const __cswiftslash_future_ptr_t _,
+	__cswiftslash_future_link_t *_Nonnull __,
+	const bool ___
 ) {
-	if (((__cswiftslash_future_wait_ptr_t)__)->____sy == true) {
-		pthread_mutex_unlock(&((__cswiftslash_future_wait_ptr_t)__)->____rm);
+	const __cswiftslash_future_wait_ptr_t __0 = __->____w;
+	// the identifier is the index of the link and a generation that advances each time the link is reused, so an identifier that belonged to a previous waiter of the link never matches again.
+	const uint64_t __1 = (((((atomic_load_explicit(&__->____ls, memory_order_relaxed) >> 33) + 1) & ____CSWIFTSLASH_FUTURE_GENERATION_MASK) << 32) | ((uint64_t)__->____x + 1));
+	atomic_store_explicit(&__0->____i, __1, memory_order_release);
+	atomic_store_explicit(&__->____ls, __1 << 1, memory_order_seq_cst);
+	uint8_t __2;
+	if (___ == true) {
+		__2 = ____cswiftslash_future_link_push(_, __);
 	} else {
-		((__cswiftslash_future_wait_ptr_t)__)->____v(((__cswiftslash_future_wait_ptr_t)__)->____c);
-		____cswiftslash_future_wait_t_destroy_async((__cswiftslash_future_wait_ptr_t)__);
+		// a recycled link is still part of the waiter stack unless the stack has been detached by a resolution. the status is loaded after the link is reopened, so either this thread observes the resolution or the resolving thread observes the reopened link.
+		__2 = (uint8_t)(atomic_load_explicit(&_->____s, memory_order_seq_cst) & ____CSWIFTSLASH_FUTURE_STATUS_MASK);
+	}
+	if (__2 == __CSWIFTSLASH_FUTURE_STATUS_PEND) {
+		return __1;
 	}
+	// the future was resolved before the waiter could be stored. the link is claimed back so that the waiter is fired exactly once.
+	uint64_t __3 = __1 << 1;
+	if (atomic_compare_exchange_strong_explicit(&__->____ls, &__3, __3 | ____CSWIFTSLASH_FUTURE_LINK_CLAIMED, memory_order_seq_cst, memory_order_seq_cst) == false) {
+		// the resolving thread claimed the recycled link first and is firing the waiter.
+		return __1;
+	}
+	// the handlers are fired from the calling thread.
+	switch (__2) {
+		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
+			__0->____r(_->____rt, _->____rv, __0->____c);
+			break;
+		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
+			__0->____e(_->____rt, _->____rv, __0->____c);
+			break;
+		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
+			__0->____v(__0->____c);
+			break;
+		default:
+			printf("swiftslash future internal error: invalid future status\n");
+			abort();
+	}
+	____cswiftslash_future_link_release(_, __);
+	return 0;
 }
 
-bool __cswiftslash_future_t_broadcast_cancel(
-	const __cswiftslash_future_ptr_t _
-) {	
-	pthread_mutex_lock(&_->____m);
-	uint8_t expected_complete = __CSWIFTSLASH_FUTURE_STATUS_PEND;
-	if (atomic_compare_exchange_strong_explicit(&_->____s, &expected_complete, __CSWIFTSLASH_FUTURE_STATUS_CANCEL, memory_order_acq_rel, memory_order_relaxed) == false) {
-		pthread_mutex_unlock(&_->____m);
+/// internal function that fires a single waiter with the resolved status of its future. NOTE: the caller must have claimed the link of the waiter before calling this function.
+/// @param _ the future that was resolved.
+/// @param __ the waiter to fire.
+/// @param ___ the resolved status of the future.
+void ____cswiftslash_future_wait_t_fire(
+	const __cswiftslash_future_ptr_t _,
+	const __cswiftslash_future_wait_ptr_t __,
+	const uint8_t ___
+) {
+	if (__->____sy == true) {
+		// synchronous waiters call their own handlers from the blocking thread, so they only need to be woken.
+		atomic_store_explicit(&__->____ws, (___ == __CSWIFTSLASH_FUTURE_STATUS_CANCEL) ? __CSWIFTSLASH_FUTURE_WAIT_CANCELLED : __CSWIFTSLASH_FUTURE_WAIT_FIRED, memory_order_release);
+		____cswiftslash_future_unpark(&__->____ws);
+		return;
+	}
+	switch (___) {
+		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
+			__->____r(_->____rt, _->____rv, __->____c);
+			break;
+		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
+			__->____e(_->____rt, _->____rv, __->____c);
+			break;
+		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
+			__->____v(__->____c);
+			break;
+		default:
+			printf("swiftslash future internal error: invalid future status\n");
+			abort();
+	}
+}
+
+/// internal function that resolves a future with a final status, firing every waiter in the order that its link was first registered.
+/// @param _ the future to resolve.
+/// @param __ the final status of the future.
+/// @param ___ the result or error type.
+/// @param ____ the result or error pointer.
+/// @return `true` if the future was resolved by this call; `false` if the future was already resolved.
+bool ____cswiftslash_future_resolve(
+	const __cswiftslash_future_ptr_t _,
+	const uint8_t __,
+	const uint8_t ___,
+	const __cswiftslash_optr_t ____
+) {
+	if (atomic_exchange_explicit(&_->____cl, true, memory_order_acq_rel) == true) {
 		return false;
 	}
-	__cswiftslash_identified_list_iterate_consume_zero(_->____wi, ____cswiftslash_future_identified_list_cancel_iterator, NULL, false);
-	pthread_mutex_unlock(&_->____m);
+	// the result is stored before the status is published, so any thread that observes the status also observes the result.
+	_->____rt = ___;
+	_->____rv = ____;
+	const uintptr_t __0 = atomic_exchange_explicit(&_->____s, (uintptr_t)__, memory_order_seq_cst);
+	// the detached stack is ordered newest first. it is reversed so that waiters are fired in the order they were registered. nothing else follows the links of a detached stack, so this is safe to do in place.
+	__cswiftslash_future_link_t *_Nullable __1 = (__cswiftslash_future_link_t *)(__0 & ~____CSWIFTSLASH_FUTURE_STATUS_MASK);
+	__cswiftslash_future_link_t *_Nullable __2 = NULL;
+	while (__1 != NULL) {
+		__cswiftslash_future_link_t *_Nullable __3 = __1->____n;
+		__1->____n = __2;
+		__2 = __1;
+		__1 = __3;
+	}
+	// a link may be reopened for a new waiter while this walk is in progress, so the claim is retried until the link is observed claimed.
+	while (__2 != NULL) {
+		uint64_t __3 = atomic_load_explicit(&__2->____ls, memory_order_seq_cst);
+		while ((__3 & ____CSWIFTSLASH_FUTURE_LINK_CLAIMED) == 0) {
+			if (atomic_compare_exchange_weak_explicit(&__2->____ls, &__3, __3 | ____CSWIFTSLASH_FUTURE_LINK_CLAIMED, memory_order_seq_cst, memory_order_seq_cst) == true) {
+				____cswiftslash_future_wait_t_fire(_, __2->____w, __);
+				break;
+			}
+		}
+		__2 = __2->____n;
+	}
 	return true;
 }
 
-void ____cswiftslash_future_identified_list_close(
-	const uint64_t _,
-	const __cswiftslash_ptr_t __,
-	const __cswiftslash_ptr_t ___
+/// internal function that claims the link of a waiter so that it will never be fired by the future. the identifier is decoded into a link index that is looked up in the storage of the future, so an identifier that is stale or was not issued by this future is rejected rather than dereferenced.
+/// @param _ the future that the waiter belongs to.
+/// @param __ the unique identifier of the waiter.
+/// @return the claimed link, or NULL if the waiter was already fired, the identifier does not match a waiter of the future, or the future is already resolved. NOTE: the caller must release a claimed link once it is finished with the waiter.
+__cswiftslash_future_link_t *_Nullable ____cswiftslash_future_link_claim(
+	const __cswiftslash_future_ptr_t _,
+	const uint64_t __
 ) {
-	free((void*)__);
+	if ((__ & ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK) == 0 || (__ >> 63) != 0 || (atomic_load_explicit(&_->____s, memory_order_acquire) & ____CSWIFTSLASH_FUTURE_STATUS_MASK) != __CSWIFTSLASH_FUTURE_STATUS_PEND) {
+		return NULL;
+	}
+	__cswiftslash_future_link_t *_Nullable __0 = ____cswiftslash_future_link_at(_, (uint32_t)(__ & ____CSWIFTSLASH_FUTURE_FREE_INDEX_MASK) - 1);
+	if (__0 == NULL) {
+		return NULL;
+	}
+	uint64_t __1 = __ << 1;
+	if (atomic_compare_exchange_strong_explicit(&__0->____ls, &__1, __1 | ____CSWIFTSLASH_FUTURE_LINK_CLAIMED, memory_order_seq_cst, memory_order_relaxed) == false) {
+		return NULL;
+	}
+	return __0;
 }
 
 __cswiftslash_future_ptr_t __cswiftslash_future_t_init() {
 	__cswiftslash_future_ptr_t __0 = malloc(sizeof(__cswiftslash_future_t));
-	atomic_store_explicit(&__0->____s, __CSWIFTSLASH_FUTURE_STATUS_PEND, memory_order_release);
-	if (pthread_mutex_init(&__0->____m, NULL) != 0) {
-		printf("swiftslash future internal error: couldn't initialize future mutex\n");
+	if (__0 == NULL) {
+		printf("swiftslash future internal error: couldn't allocate future\n");
 		abort();
 	}
-	__cswiftslash_identified_list_pair_t __1 = __cswiftslash_identified_list_init();
-	__cswiftslash_ptr_t __2 = malloc(sizeof(__cswiftslash_identified_list_pair_t));
-	memcpy(__2, &__1, sizeof(__cswiftslash_identified_list_pair_t));
-	__0->____wi = __2;
+	atomic_store_explicit(&__0->____s, (uintptr_t)__CSWIFTSLASH_FUTURE_STATUS_PEND, memory_order_relaxed);
+	atomic_store_explicit(&__0->____cl, false, memory_order_relaxed);
+	__0->____rt = 0;
+	__0->____rv = NULL;
+	__0->____l0.____n = NULL;
+	atomic_store_explicit(&__0->____l0.____ls, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____l0.____fn, 0, memory_order_relaxed);
+	__0->____l0.____x = 0;
+	__0->____l0.____w = NULL;
+	atomic_store_explicit(&__0->____ln, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____fh, 0, memory_order_relaxed);
+	atomic_store_explicit(&__0->____ld, NULL, memory_order_release);
 	return __0;
 }
 
@@ -154,52 +418,36 @@ void __cswiftslash_future_t_destroy(
 	const _Nonnull __cswiftslash_future_result_val_handler_f ___,
 	const _Nonnull __cswiftslash_future_result_err_handler_f ____
 ) {
-	pthread_mutex_lock(&_->____m);
-	int8_t __0 = atomic_load_explicit(&_->____s, memory_order_acquire);
-	switch (__0) {
-		case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-			__cswiftslash_identified_list_iterate_consume_zero(_->____wi, ____cswiftslash_future_identified_list_cancel_iterator, NULL, false);
-			break;
+	// a future that is still pending is cancelled so that its waiters are fired before the memory is released.
+	____cswiftslash_future_resolve(_, __CSWIFTSLASH_FUTURE_STATUS_CANCEL, 0, NULL);
+	switch (atomic_load_explicit(&_->____s, memory_order_acquire) & ____CSWIFTSLASH_FUTURE_STATUS_MASK) {
 		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-			___(atomic_load_explicit(&_->____rt, memory_order_acquire), atomic_load_explicit(&_->____rv, memory_order_acquire), __);
+			___(_->____rt, _->____rv, __);
 			break;
 		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-			____(atomic_load_explicit(&_->____rt, memory_order_acquire), atomic_load_explicit(&_->____rv, memory_order_acquire), __);
+			____(_->____rt, _->____rv, __);
+			break;
+		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
+			// waiters were already fired when the future was cancelled, and there is no result to hand back.
 			break;
 		default:
 			printf("swiftslash future internal error: invalid future status\n");
 			abort();
 	}
-	pthread_mutex_unlock(&_->____m);
-	pthread_mutex_lock(&_->____m);
-	__cswiftslash_identified_list_close(_->____wi, ____cswiftslash_future_identified_list_close, NULL);
-	pthread_mutex_unlock(&_->____m);
-	pthread_mutex_destroy(&_->____m);
+	const __cswiftslash_future_link_dir_optr_t __0 = atomic_load_explicit(&_->____ld, memory_order_acquire);
+	if (__0 != NULL) {
+		for (size_t __1 = 0; __1 < __CSWIFTSLASH_FUTURE_LINK_CHUNKS; __1++) {
+			free(atomic_load_explicit(&__0[__1], memory_order_relaxed));
+		}
+		free(__0);
+	}
 	free(_);
 }
 
 bool __cswiftslash_future_t_has_result(
 	const __cswiftslash_future_ptr_t _
 ) {
-	pthread_mutex_lock(&_->____m);
-	const int8_t __0 = atomic_load_explicit(&_->____s, memory_order_acquire);
-	switch (__0) {
-		case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-			pthread_mutex_unlock(&_->____m);
-			return false;
-		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-			pthread_mutex_unlock(&_->____m);
-			return true;
-		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-			pthread_mutex_unlock(&_->____m);
-			return true;
-		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-			pthread_mutex_unlock(&_->____m);
-			return true;
-		default:
-			printf("swiftslash future internal error: invalid future status\n");
-			abort();
-	}
+	return (atomic_load_explicit(&_->____s, memory_order_acquire) & ____CSWIFTSLASH_FUTURE_STATUS_MASK) != __CSWIFTSLASH_FUTURE_STATUS_PEND;
 }
 
 __cswiftslash_optr_t __cswiftslash_future_t_wait_sync_register(
@@ -210,39 +458,14 @@ __cswiftslash_optr_t __cswiftslash_future_t_wait_sync_register(
 	const _Nonnull __cswiftslash_future_result_cncl_handler_f _____,
 	const __cswiftslash_future_wait_ptr_t ______
 ) {
-	pthread_mutex_lock(&_->____m);
-	uint8_t __1;
-	__cswiftslash_optr_t __2;
-	uint64_t __3;
-	checkStat:
-		switch (atomic_load_explicit(&_->____s, memory_order_acquire)) {
-			case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-				____cswiftslash_future_wait_t_init_sync(__, ___, ____, _____, ______);
-				atomic_store_explicit(&______->____i, __cswiftslash_identified_list_insert(_->____wi, ______), memory_order_release);
-				goto proceedToBlock;
-			case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-				__1 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-				__2 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-				___(__1, __2, __);
-				goto returnTime;
-			case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-				__1 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-				__2 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-				____(__1, __2, __);
-				goto returnTime;
-			case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-				_____(__);
-				goto returnTime;
-			default:
-				printf("swiftslash future internal error: invalid future status\n");
-				abort();
-		}
-	returnTime:
-		pthread_mutex_unlock(&_->____m);
+	____cswiftslash_future_wait_t_init(__, ___, ____, _____, true, ______);
+	bool __0;
+	__cswiftslash_future_link_t *_Nonnull __1 = ____cswiftslash_future_link_acquire(_, &__0);
+	__1->____w = ______;
+	if (____cswiftslash_future_wait_t_store(_, __1, __0) == 0) {
 		return (__cswiftslash_optr_t)NULL;
-	proceedToBlock:
-		pthread_mutex_unlock(&_->____m);
-		return (__cswiftslash_optr_t)______;
+	}
+	return (__cswiftslash_optr_t)______;
 }
 
 /// returns the unique waiter ID for a future waiter.
@@ -258,73 +481,41 @@ void __cswiftslash_future_t_wait_sync_block(
 	const __cswiftslash_future_ptr_t _,
 	const __cswiftslash_ptr_t __
 ) {
-	pthread_mutex_lock(&((__cswiftslash_future_wait_ptr_t)__)->____rm);
-	pthread_mutex_lock(&_->____m);
-	uint8_t __1;
-	__cswiftslash_optr_t __2;
-	if (atomic_load_explicit(&((__cswiftslash_future_wait_ptr_t)__)->____ic, memory_order_acquire) == true) {
-		((__cswiftslash_future_wait_ptr_t)__)->____v(((__cswiftslash_future_wait_ptr_t)__)->____c);
-	} else {
-		switch (atomic_load_explicit(&_->____s, memory_order_acquire)) {
-			case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-				__1 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-				__2 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-				((__cswiftslash_future_wait_ptr_t)__)->____r(__1, __2, ((__cswiftslash_future_wait_ptr_t)__)->____c);
-				break;
-			case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-				__1 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-				__2 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-				((__cswiftslash_future_wait_ptr_t)__)->____e(__1, __2, ((__cswiftslash_future_wait_ptr_t)__)->____c);
-				break;
-			case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-				((__cswiftslash_future_wait_ptr_t)__)->____v(((__cswiftslash_future_wait_ptr_t)__)->____c);
-				break;
-			default:
-				printf("swiftslash future internal error: invalid future status\n");
-				abort();
-		}
+	const __cswiftslash_future_wait_ptr_t __0 = (__cswiftslash_future_wait_ptr_t)__;
+	uint32_t __1;
+	while ((__1 = atomic_load_explicit(&__0->____ws, memory_order_acquire)) == __CSWIFTSLASH_FUTURE_WAIT_PARKED) {
+		____cswiftslash_future_park(&__0->____ws, __CSWIFTSLASH_FUTURE_WAIT_PARKED);
 	}
-	pthread_mutex_unlock(&_->____m);
-	____cswiftslash_future_wait_t_unlock_destroy_sync(((__cswiftslash_future_wait_ptr_t)__));
-}
-
-/// @brief a optional pointer to a future waiter.
-typedef __cswiftslash_future_wait_t *_Nullable __cswiftslash_future_wait_optr_t;
-
-bool __cswiftslash_future_wait_sync_invalidate(
-	const __cswiftslash_future_ptr_t _,
-	const uint64_t __
-) {
-	pthread_mutex_lock(&_->____m);
-	const int8_t __0 = atomic_load_explicit(&_->____s, memory_order_acquire);
-	__cswiftslash_future_wait_optr_t __1;
-	switch (__0) {
-		case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-			goto cancelWaiter;
+	if (__1 == __CSWIFTSLASH_FUTURE_WAIT_CANCELLED) {
+		__0->____v(__0->____c);
+		return;
+	}
+	switch (atomic_load_explicit(&_->____s, memory_order_acquire) & ____CSWIFTSLASH_FUTURE_STATUS_MASK) {
 		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-			goto returnFalse;
+			__0->____r(_->____rt, _->____rv, __0->____c);
+			break;
 		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-			goto returnFalse;
-		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-			goto returnFalse;
+			__0->____e(_->____rt, _->____rv, __0->____c);
+			break;
 		default:
 			printf("swiftslash future internal error: invalid future status\n");
 			abort();
 	}
-	cancelWaiter:
-		__1 = (__cswiftslash_future_wait_optr_t)__cswiftslash_identified_list_remove(_->____wi, __);
-		if (__1 == NULL) {
-			pthread_mutex_unlock(&_->____m);
-			return false;
-		} else {
-			atomic_store_explicit(&((__cswiftslash_future_wait_ptr_t)__1)->____ic, true, memory_order_release);
-			pthread_mutex_unlock(&_->____m);
-			pthread_mutex_unlock(&__1->____rm);
-			return true;
-		}
-	returnFalse:
-		pthread_mutex_unlock(&_->____m);
+}
+
+bool __cswiftslash_future_wait_sync_invalidate(
+	const __cswiftslash_future_ptr_t _,
+	const uint64_t __
+) {
+	__cswiftslash_future_link_t *_Nullable __0 = ____cswiftslash_future_link_claim(_, __);
+	if (__0 == NULL) {
 		return false;
+	}
+	const __cswiftslash_future_wait_ptr_t __1 = __0->____w;
+	____cswiftslash_future_link_release(_, __0);
+	atomic_store_explicit(&__1->____ws, __CSWIFTSLASH_FUTURE_WAIT_CANCELLED, memory_order_release);
+	____cswiftslash_future_unpark(&__1->____ws);
+	return true;
 }
 
 uint64_t __cswiftslash_future_t_wait_async(
@@ -334,106 +525,25 @@ uint64_t __cswiftslash_future_t_wait_async(
 	const _Nonnull __cswiftslash_future_result_err_handler_f ____,
 	const _Nonnull __cswiftslash_future_result_cncl_handler_f _____
 ) {
-	const __cswiftslash_future_wait_ptr_t __0 = ____cswiftslash_future_wait_t_init_async(__, ___, ____, _____);
-	pthread_mutex_lock(&_->____m);
-	const int8_t __1 = atomic_load_explicit(&_->____s, memory_order_acquire);
-	uint64_t __2;
-	uint8_t __3;
-	__cswiftslash_optr_t __4;
-	checkStat:
-	switch (__1) {
-		case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-			__2 = __cswiftslash_identified_list_insert(_->____wi, (__cswiftslash_ptr_t)__0);
-			atomic_store_explicit(&__0->____i, __2, memory_order_release);
-			goto returnTimeWaiting;
-		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-			__3 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-			__4 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-			___(__3, __4, __);
-			goto returnTimeNoWait;
-		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-			__3 = atomic_load_explicit(&_->____rt, memory_order_acquire);
-			__4 = atomic_load_explicit(&_->____rv, memory_order_acquire);
-			____(__3, __4, __);
-			goto returnTimeNoWait;
-		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-			_____(NULL);
-			goto returnTimeNoWait;
-		default:
-			printf("swiftslash future internal error: invalid future status\n");
-			abort();
-	}
-	returnTimeNoWait:
-		pthread_mutex_unlock(&_->____m);
-		____cswiftslash_future_wait_t_destroy_async(__0);
-		return 0;
-	returnTimeWaiting:
-		pthread_mutex_unlock(&_->____m);
-		if (__2 == 0) {
-			printf("swiftslash future internal error: future waiter should never have zero id. this is an internal error\n");
-			abort();
-		}
-		return __2;
+	bool __0;
+	__cswiftslash_future_link_t *_Nonnull __1 = ____cswiftslash_future_link_acquire(_, &__0);
+	____cswiftslash_future_wait_t_init(__, ___, ____, _____, false, &__1->____aw);
+	__1->____w = &__1->____aw;
+	return ____cswiftslash_future_wait_t_store(_, __1, __0);
 }
 
 bool __cswiftslash_future_t_wait_async_invalidate(
 	const __cswiftslash_future_ptr_t _,
 	const uint64_t __
 ) {
-	pthread_mutex_lock(&_->____m);
-	const int8_t __0 = atomic_load_explicit(&_->____s, memory_order_acquire);
-	__cswiftslash_optr_t __1;
-	switch (__0) {
-		case __CSWIFTSLASH_FUTURE_STATUS_PEND:
-			goto cancelWaiter;
-		case __CSWIFTSLASH_FUTURE_STATUS_RESULT:
-			goto returnFalse;
-		case __CSWIFTSLASH_FUTURE_STATUS_THROW:
-			goto returnFalse;
-		case __CSWIFTSLASH_FUTURE_STATUS_CANCEL:
-			goto returnFalse;
-		default:
-			printf("swiftslash future internal error: invalid future status\n");
-			abort();
-	}
-	cancelWaiter:
-		__1 = __cswiftslash_identified_list_remove(_->____wi, __);
-		pthread_mutex_unlock(&_->____m);
-		if (__1 == NULL) {
-			return false;
-		}
-		((__cswiftslash_future_wait_ptr_t)__1)->____v(((__cswiftslash_future_wait_ptr_t)(__1))->____c);
-		____cswiftslash_future_wait_t_destroy_async(__1);
-		return true;
-	returnFalse:
-		pthread_mutex_unlock(&_->____m);
+	__cswiftslash_future_link_t *_Nullable __0 = ____cswiftslash_future_link_claim(_, __);
+	if (__0 == NULL) {
 		return false;
-}
-
-void ____cswiftslash_future_identified_list_val_iterator(
-	const uint64_t _,
-	const __cswiftslash_ptr_t wptr,
-	const __cswiftslash_ptr_t ___
-) {
-	if (((__cswiftslash_future_wait_ptr_t)wptr)->____sy == true) {
-		pthread_mutex_unlock(&((__cswiftslash_future_wait_ptr_t)wptr)->____rm);
-	} else {
-		((__cswiftslash_future_wait_ptr_t)wptr)->____r(((struct ____cswiftslash_future_identified_list_tool*)___)->_, ((struct ____cswiftslash_future_identified_list_tool*)___)->__, ((__cswiftslash_future_wait_ptr_t)wptr)->____c);
-		____cswiftslash_future_wait_t_destroy_async((__cswiftslash_future_wait_ptr_t)wptr);
-	}
-}
-
-void ____cswiftslash_future_identified_list_throw_iterator(
-	const uint64_t _,
-	const __cswiftslash_ptr_t wptr,
-	const __cswiftslash_ptr_t ___
-) {
-	if (((__cswiftslash_future_wait_ptr_t)wptr)->____sy == true) {
-		pthread_mutex_unlock(&((__cswiftslash_future_wait_ptr_t)wptr)->____rm);
-	} else {
-		((__cswiftslash_future_wait_ptr_t)wptr)->____e(((struct ____cswiftslash_future_identified_list_tool*)___)->_, ((struct ____cswiftslash_future_identified_list_tool*)___)->__, ((__cswiftslash_future_wait_ptr_t)wptr)->____c);
-		____cswiftslash_future_wait_t_destroy_async((__cswiftslash_future_wait_ptr_t)wptr);
 	}
+	// the waiter is stored in the link, so the handler is fired before the link is released for reuse.
+	__0->____aw.____v(__0->____aw.____c);
+	____cswiftslash_future_link_release(_, __0);
+	return true;
 }
 
 bool __cswiftslash_future_t_broadcast_res_val(
@@ -441,21 +551,7 @@ bool __cswiftslash_future_t_broadcast_res_val(
 	const uint8_t __,
 	const __cswiftslash_optr_t ___
 ) {
-	pthread_mutex_lock(&_->____m);
-	uint8_t expected_complete = __CSWIFTSLASH_FUTURE_STATUS_PEND;
-	if (atomic_compare_exchange_strong_explicit(&_->____s, &expected_complete, __CSWIFTSLASH_FUTURE_STATUS_RESULT, memory_order_acq_rel, memory_order_relaxed) == false) {
-		pthread_mutex_unlock(&_->____m);
-		return false;
-	}
-	atomic_store_explicit(&_->____rv, ___, memory_order_release);
-	atomic_store_explicit(&_->____rt, __, memory_order_release);
-	struct ____cswiftslash_future_identified_list_tool __0 = {
-		._ = __,
-		.__ = ___
-	};
-	__cswiftslash_identified_list_iterate_consume_zero(_->____wi, ____cswiftslash_future_identified_list_val_iterator, &__0, false);
-	pthread_mutex_unlock(&_->____m);
-	return true;
+	return ____cswiftslash_future_resolve(_, __CSWIFTSLASH_FUTURE_STATUS_RESULT, __, ___);
 }
 
 bool __cswiftslash_future_t_broadcast_res_throw(
@@ -463,19 +559,129 @@ bool __cswiftslash_future_t_broadcast_res_throw(
 	const uint8_t __,
 	const __cswiftslash_optr_t ___
 ) {
-	pthread_mutex_lock(&_->____m);
-	uint8_t expected_complete = __CSWIFTSLASH_FUTURE_STATUS_PEND;
-	if (atomic_compare_exchange_strong_explicit(&_->____s, &expected_complete, __CSWIFTSLASH_FUTURE_STATUS_THROW, memory_order_acq_rel, memory_order_relaxed) == false) {
-		pthread_mutex_unlock(&_->____m);
+	return ____cswiftslash_future_resolve(_, __CSWIFTSLASH_FUTURE_STATUS_THROW, __, ___);
+}
+
+bool __cswiftslash_future_t_broadcast_cancel(
+	const __cswiftslash_future_ptr_t _
+) {
+	return ____cswiftslash_future_resolve(_, __CSWIFTSLASH_FUTURE_STATUS_CANCEL, 0, NULL);
+}
+
+/// internal function that fires the handler of a countdown, as long as it has not already fired.
+/// @param _ the countdown to fire.
+/// @param __ the index to pass to the handler.
+/// @return `true` if the handler was fired by this call.
+bool ____cswiftslash_future_countdown_fire(
+	const __cswiftslash_future_countdown_ptr_t _,
+	const size_t __
+) {
+	if (atomic_exchange_explicit(&_->____fd, true, memory_order_acq_rel) == true) {
 		return false;
 	}
-	atomic_store_explicit(&_->____rv, ___, memory_order_release);
-	atomic_store_explicit(&_->____rt, __, memory_order_release);
-	struct ____cswiftslash_future_identified_list_tool __0 = {
-		._ = __,
-		.__ = ___
-	};
-	__cswiftslash_identified_list_iterate_consume_zero(_->____wi, ____cswiftslash_future_identified_list_throw_iterator, &__0, false);
-	pthread_mutex_unlock(&_->____m);
+	_->____h(__, _->____c);
 	return true;
+}
+
+/// internal function that drops a single reference to a countdown, freeing it when the last reference is dropped.
+/// @param _ the countdown to drop a reference to.
+void ____cswiftslash_future_countdown_unref(
+	const __cswiftslash_future_countdown_ptr_t _
+) {
+	if (atomic_fetch_sub_explicit(&_->____rc, 1, memory_order_acq_rel) == 1) {
+		free(_);
+	}
+}
+
+/// internal function that handles the resolution of a single future that a countdown is registered with. every registration calls this exactly once, whether the future resolved, was cancelled, or the registration was invalidated.
+/// @param _ the slot of the countdown registration.
+void ____cswiftslash_future_countdown_slot_resolved(
+	__cswiftslash_future_countdown_slot_t *_Nonnull _
+) {
+	const __cswiftslash_future_countdown_ptr_t __0 = _->____cd;
+	size_t __1 = atomic_load_explicit(&__0->____r, memory_order_acquire);
+	while (__1 > 0) {
+		if (atomic_compare_exchange_weak_explicit(&__0->____r, &__1, __1 - 1, memory_order_acq_rel, memory_order_acquire) == true) {
+			if (__1 == 1) {
+				____cswiftslash_future_countdown_fire(__0, _->____x);
+			}
+			break;
+		}
+	}
+	____cswiftslash_future_countdown_unref(__0);
+}
+
+void ____cswiftslash_future_countdown_val_handler(
+	const uint8_t _,
+	const __cswiftslash_optr_t __,
+	const __cswiftslash_optr_t ___
+) {
+	(void)_;
+	(void)__;
+	____cswiftslash_future_countdown_slot_resolved((__cswiftslash_future_countdown_slot_t *)___);
+}
+
+void ____cswiftslash_future_countdown_cncl_handler(
+	const __cswiftslash_optr_t _
+) {
+	____cswiftslash_future_countdown_slot_resolved((__cswiftslash_future_countdown_slot_t *)_);
+}
+
+__cswiftslash_future_countdown_ptr_t __cswiftslash_future_countdown_init(
+	const __cswiftslash_future_ptr_t *_Nonnull _,
+	const size_t __,
+	const size_t ___,
+	const __cswiftslash_future_countdown_f ____,
+	const __cswiftslash_optr_t _____
+) {
+	if (__ == 0) {
+		printf("swiftslash future internal error: a countdown requires at least one future\n");
+		abort();
+	}
+	__cswiftslash_future_countdown_t *_Nullable __0 = malloc(sizeof(__cswiftslash_future_countdown_t) + (sizeof(__cswiftslash_future_countdown_slot_t) * __));
+	if (__0 == NULL) {
+		printf("swiftslash future internal error: couldn't allocate future countdown\n");
+		abort();
+	}
+	atomic_store_explicit(&__0->____r, (___ == 0) ? 1 : ((___ > __) ? __ : ___), memory_order_relaxed);
+	// one reference for each registration and one for the owner.
+	atomic_store_explicit(&__0->____rc, __ + 1, memory_order_relaxed);
+	atomic_store_explicit(&__0->____fd, false, memory_order_relaxed);
+	__0->____h = ____;
+	__0->____c = _____;
+	__0->____n = __;
+	for (size_t __1 = 0; __1 < __; __1++) {
+		__0->____sl[__1].____cd = __0;
+		__0->____sl[__1].____x = __1;
+		__0->____sl[__1].____f = _[__1];
+		__0->____sl[__1].____i = 0;
+	}
+	for (size_t __1 = 0; __1 < __; __1++) {
+		if (atomic_load_explicit(&__0->____fd, memory_order_acquire) == true) {
+			// the countdown already fired, so the remaining futures do not need to be registered. their references are dropped here (the owner reference keeps the countdown allocated).
+			atomic_fetch_sub_explicit(&__0->____rc, __ - __1, memory_order_acq_rel);
+			break;
+		}
+		__0->____sl[__1].____i = __cswiftslash_future_t_wait_async(_[__1], &__0->____sl[__1], ____cswiftslash_future_countdown_val_handler, ____cswiftslash_future_countdown_val_handler, ____cswiftslash_future_countdown_cncl_handler);
+	}
+	return __0;
+}
+
+bool __cswiftslash_future_countdown_cancel(
+	const __cswiftslash_future_countdown_ptr_t _
+) {
+	return ____cswiftslash_future_countdown_fire(_, __CSWIFTSLASH_FUTURE_COUNTDOWN_CANCELLED);
+}
+
+void __cswiftslash_future_countdown_release(
+	const __cswiftslash_future_countdown_ptr_t _
+) {
+	atomic_store_explicit(&_->____fd, true, memory_order_release);
+	for (size_t __0 = 0; __0 < _->____n; __0++) {
+		if (_->____sl[__0].____i != 0) {
+			// a registration that has already fired is not affected by the invalidation.
+			__cswiftslash_future_t_wait_async_invalidate(_->____sl[__0].____f, _->____sl[__0].____i);
+		}
+	}
+	____cswiftslash_future_countdown_unref(_);
 }
\ No newline at end of file
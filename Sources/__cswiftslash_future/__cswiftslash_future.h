@@ -17,6 +17,7 @@ copyright (c) tanner silva 2025. all rights reserved.
 #include <pthread.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /// status values.
 typedef enum __cswiftslash_future_status_t {
@@ -57,16 +58,25 @@ typedef void(* _Nonnull __cswiftslash_future_result_cncl_handler_f)(
 	const __cswiftslash_optr_t _
 );
 
+/// the values of the word that a synchronous waiter parks on.
+typedef enum __cswiftslash_future_wait_state_t {
+	/// the waiter is parked and has not been fired.
+	__CSWIFTSLASH_FUTURE_WAIT_PARKED = 0,
+	/// the waiter was fired with a result or error that is stored in the future.
+	__CSWIFTSLASH_FUTURE_WAIT_FIRED = 1,
+	/// the waiter was fired with a cancellation, either because the future was cancelled or because the waiter was invalidated.
+	__CSWIFTSLASH_FUTURE_WAIT_CANCELLED = 2,
+} __cswiftslash_future_wait_state_t;
+
 /// used to represent a thread that is synchronously waiting and blocking for the result of a future.
 typedef struct __cswiftslash_future_wait_t {
 	const __cswiftslash_optr_t ____c;
 	const bool ____sy;
-	pthread_mutex_t ____rm;
 	const __cswiftslash_future_result_val_handler_f ____r;
 	const __cswiftslash_future_result_err_handler_f ____e;
 	const __cswiftslash_future_result_cncl_handler_f ____v;
 	_Atomic uint64_t ____i;
-	_Atomic bool ____ic;
+	_Atomic uint32_t ____ws;
 } __cswiftslash_future_wait_t;
 
 /// initialize a synchronous future waiter.
@@ -75,13 +85,38 @@ __cswiftslash_future_wait_t __cswiftslash_future_wait_t_init_struct();
 /// a non-optional pointer to a future waiter.
 typedef __cswiftslash_future_wait_t *_Nonnull __cswiftslash_future_wait_ptr_t;
 
-/// a future that will either succeed with a pointer type and pointer, or fail with an error type and pointer.
+/// a single entry in the waiter stack of a future. links are owned by the future and are not freed until the future is destroyed. once the waiter of a link is invalidated, the link is recycled in place for the next waiter, so the waiter stack never grows beyond the peak number of concurrent waiters.
+typedef struct __cswiftslash_future_link {
+	struct __cswiftslash_future_link *_Nullable ____n;
+	_Atomic uint64_t ____ls;
+	_Atomic uint32_t ____fn;
+	uint32_t ____x;
+	__cswiftslash_future_wait_t *_Nullable ____w;
+	__cswiftslash_future_wait_t ____aw;
+} __cswiftslash_future_link_t;
+
+/// an optional pointer to a future link.
+typedef __cswiftslash_future_link_t *_Nullable __cswiftslash_future_link_optr_t;
+
+/// an atomic optional pointer to a future link.
+typedef _Atomic __cswiftslash_future_link_optr_t __cswiftslash_future_link_aptr_t;
+
+/// an optional pointer to the chunk directory of a future.
+typedef __cswiftslash_future_link_aptr_t *_Nullable __cswiftslash_future_link_dir_optr_t;
+
+/// the number of chunks in the link directory of a future. chunk `k` holds `2^k` links, which is enough to address every 32 bit link index.
+#define __CSWIFTSLASH_FUTURE_LINK_CHUNKS 32
+
+/// a future that will either succeed with a pointer type and pointer, or fail with an error type and pointer. the status of the future and the top of its waiter stack are packed into a single atomic state word, so no operation on the future takes a lock.
 typedef struct __cswiftslash_future {
-	_Atomic uint8_t ____s;
-	pthread_mutex_t ____m;
-	_Atomic uint8_t ____rt;
-	_Atomic __cswiftslash_optr_t ____rv;
-	__cswiftslash_ptr_t ____wi;
+	_Atomic uintptr_t ____s;
+	_Atomic bool ____cl;
+	uint8_t ____rt;
+	__cswiftslash_optr_t ____rv;
+	_Atomic uint32_t ____ln;
+	_Atomic uint64_t ____fh;
+	_Atomic __cswiftslash_future_link_dir_optr_t ____ld;
+	__cswiftslash_future_link_t ____l0;
 } __cswiftslash_future_t;
 
 /// a pointer to a future.
@@ -104,7 +139,7 @@ void __cswiftslash_future_t_destroy(
 	const _Nonnull __cswiftslash_future_result_err_handler_f ____
 );
 
-/// returns whether or not the future has stored a result.
+/// returns whether or not the future has stored a result. this is a single atomic load.
 /// @param _ the future to check the result status of.
 /// @return `true` if the future has a result or has been cancelled, `false` if the future is still pending
 bool __cswiftslash_future_t_has_result(
@@ -170,7 +205,7 @@ uint64_t __cswiftslash_future_t_wait_async(
 /// cancel an asynchronous waiter for a future. after calling this function, you can rest assured that the result handlers will not be fired for the specified waiter. however, it is possible that a result becomes available during the course of calling this function, and such conditions are reported by the return value.
 /// @param _ the future to cancel the waiter for.
 /// @param __ the unique waiter identifier to cancel.
-/// @return a boolean value indicating if the cancellation was successful. if the waiter was already complete and the handler functions were fired, this function will return false.
+/// @return a boolean value indicating if the cancellation was successful. if the waiter was already complete and the handler functions were fired, this function will return false. an identifier that is stale (its waiter was already fired or invalidated) or that was not issued by this future is rejected without effect.
 bool __cswiftslash_future_t_wait_async_invalidate(
 	const __cswiftslash_future_ptr_t _,
 	const uint64_t __
@@ -205,4 +240,68 @@ bool __cswiftslash_future_t_broadcast_cancel(
 	const __cswiftslash_future_ptr_t _
 );
 
+/// the index that is passed to a countdown handler when the countdown was cancelled before enough of its futures resolved.
+#define __CSWIFTSLASH_FUTURE_COUNTDOWN_CANCELLED SIZE_MAX
+
+/// countdown handler function. this is fired exactly once for each countdown, from the thread that completed (or cancelled) the countdown.
+/// @param _ the index of the future whose resolution completed the countdown, or `__CSWIFTSLASH_FUTURE_COUNTDOWN_CANCELLED` if the countdown was cancelled.
+/// @param __ function context pointer (optional).
+typedef void(* _Nonnull __cswiftslash_future_countdown_f)(
+	const size_t _,
+	const __cswiftslash_optr_t __
+);
+
+/// forward declaration of the countdown structure.
+struct __cswiftslash_future_countdown;
+
+/// the registration of a countdown in a single future.
+typedef struct __cswiftslash_future_countdown_slot {
+	struct __cswiftslash_future_countdown *_Nonnull ____cd;
+	size_t ____x;
+	__cswiftslash_future_ptr_t ____f;
+	uint64_t ____i;
+} __cswiftslash_future_countdown_slot_t;
+
+/// a single waiter that is shared across a set of futures. the countdown fires once a threshold number of its futures have resolved (or been cancelled), so waiting on any number of futures costs a single handler invocation.
+typedef struct __cswiftslash_future_countdown {
+	_Atomic size_t ____r;
+	_Atomic size_t ____rc;
+	_Atomic bool ____fd;
+	__cswiftslash_future_countdown_f ____h;
+	__cswiftslash_optr_t ____c;
+	size_t ____n;
+	__cswiftslash_future_countdown_slot_t ____sl[];
+} __cswiftslash_future_countdown_t;
+
+/// a pointer to a countdown.
+typedef __cswiftslash_future_countdown_t *_Nonnull __cswiftslash_future_countdown_ptr_t;
+
+/// create a countdown and register it with each of the specified futures. the handler may be fired before this function returns if enough of the futures are already resolved.
+/// @param _ the futures to count down. each future must remain allocated until `__cswiftslash_future_countdown_release` is called.
+/// @param __ the number of futures. must be at least one.
+/// @param ___ the number of futures that must resolve before the countdown fires. this is clamped between one and the number of futures.
+/// @param ____ the handler to fire when the countdown completes or is cancelled.
+/// @param _____ the context pointer to pass to the handler.
+/// @return the countdown. the caller is OBLIGATED to call `__cswiftslash_future_countdown_release` when it is finished with the countdown.
+__cswiftslash_future_countdown_ptr_t __cswiftslash_future_countdown_init(
+	const __cswiftslash_future_ptr_t *_Nonnull _,
+	const size_t __,
+	const size_t ___,
+	const __cswiftslash_future_countdown_f ____,
+	const __cswiftslash_optr_t _____
+);
+
+/// fire a countdown before enough of its futures have resolved. the handler is passed `__CSWIFTSLASH_FUTURE_COUNTDOWN_CANCELLED`.
+/// @param _ the countdown to cancel.
+/// @return `true` if the countdown was fired by this call; `false` if the countdown had already fired.
+bool __cswiftslash_future_countdown_cancel(
+	const __cswiftslash_future_countdown_ptr_t _
+);
+
+/// release a countdown. the handler will not be fired after this function is called, and any registrations that are still stored in the futures are invalidated. the countdown is freed once every registration has been released.
+/// @param _ the countdown to release.
+void __cswiftslash_future_countdown_release(
+	const __cswiftslash_future_countdown_ptr_t _
+);
+
 #endif // __CLIBSWIFTSLASH_FUTURE_H
\ No newline at end of file
@@ -13,44 +13,49 @@ copyright (c) tanner silva 2025. all rights reserved.
 #include "__cswiftslash_types.h"
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 
-/// initial size of the hash table.
+/// initial size of the hash table. must be a power of two.
 #define INITIAL_HASH_TABLE_SIZE 16
-/// maximum size of the hash table.
-#define MAX_HASH_TABLE_SIZE 2097152
-/// load factor threshold for resizing up (e.g., 0.75 means resize when 75% full).
-#define RESIZE_UP_FACTOR 0.75
-/// load factor threshold for resizing down (e.g., 0.25 means resize when 25% full).
-#define RESIZE_DOWN_FACTOR 0.25
-/// factor by which the hash table size increases upon resizing.
-#define RESIZE_MULTIPLIER 2
+/// the hash table grows when an insertion would push the load past GROW_NUMERATOR / GROW_DENOMINATOR (75%).
+#define GROW_NUMERATOR 3
+#define GROW_DENOMINATOR 4
+/// the hash table shrinks when the load falls below 1 / SHRINK_DIVISOR (12.5%). the wide gap between the grow and shrink thresholds keeps a list that hovers around a boundary from resizing on every insert/remove pair.
+#define SHRINK_DIVISOR 8
 
+/// splitmix64 finalizer. keys are handed out sequentially, so the identity hash placed every key directly next to its predecessor and turned any cluster into one long probe run. mixing spreads consecutive keys across the whole table.
 static size_t HF_(uint64_t key) {
-	return key;
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9ULL;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111ebULL;
+	key ^= key >> 31;
+	return (size_t)key;
 }
 
+/// rebuilds the hash table at a new capacity from the ordered list.
+/// @param _ the list pair whose table is being rebuilt.
+/// @param __ the new capacity. must be a power of two.
 static void resize_hashtable(
 	__cswiftslash_identified_list_pair_ptr_t _,
 	const size_t __
 ) {
 	__cswiftslash_identified_list_ptr_t* __0 = calloc(__, sizeof(__cswiftslash_identified_list_ptr_t));
-	memset(__0, 0, __ * sizeof(__cswiftslash_identified_list_ptr_t));
-	__cswiftslash_identified_list_ptr_t __1 = _->____o;
-	while (__1 != NULL) {
-		size_t __2 = HF_(__1->____k) % __;
-		size_t __3 = __2;
-		size_t __4 = 0;
-		while (__0[__2] != NULL) {
-			__4++;
-			__2 = (__3 + __4) % __;
+	const size_t __1 = __ - 1;
+	__cswiftslash_identified_list_ptr_t __2 = _->____o;
+	while (__2 != NULL) {
+		size_t __3 = HF_(__2->____k) & __1;
+		while (__0[__3] != NULL) {
+			__3 = (__3 + 1) & __1;
 		}
-		__0[__2] = __1;
-		__1 = __1->____n;
+		__0[__3] = __2;
+		__2 = __2->____n;
 	}
 	free(_->____ht);
 	_->____ht = __0;
@@ -64,7 +69,8 @@ __cswiftslash_identified_list_pair_t __cswiftslash_identified_list_init() {
 		.____i = 0,
 		.____idi = 0,
 		.____p = NULL,
-		.____o = NULL
+		.____o = NULL,
+		.____np = __cswiftslash_pool_init(sizeof(__cswiftslash_identified_list_t), __CSWIFTSLASH_IDENTIFIED_LIST_NODE_POOL_MAX)
 	};
 	pthread_mutex_init(&__0.____m, NULL);
 	return __0;
@@ -81,34 +87,30 @@ uint64_t ____increment_overflow_guard(
 	return *__;
 }
 
-uint64_t __cswiftslash_identified_list_insert(
+/// places a new node for an already chosen key into the list. the caller must hold the list lock.
+/// @param _ the list pair to store into.
+/// @param __ the key to store the node under. must not already be present in the list.
+/// @param ___ the data pointer to associate with the key.
+void ____cswiftslash_identified_list_store(
 	const __cswiftslash_identified_list_pair_ptr_t _,
-	const __cswiftslash_ptr_t __
+	const uint64_t __,
+	const __cswiftslash_ptr_t ___
 ) {
-	pthread_mutex_lock(&_->____m);
-	double __0 = (double)(_->____i + 1) / _->____hn;
-	if (__0 > RESIZE_UP_FACTOR && _->____hn < MAX_HASH_TABLE_SIZE) {
-		size_t __1 = _->____hn * RESIZE_MULTIPLIER;
-		if (__1 > MAX_HASH_TABLE_SIZE) {
-			__1 = MAX_HASH_TABLE_SIZE;
-		}
-		resize_hashtable(_, __1);
+	if ((_->____i + 1) * GROW_DENOMINATOR > _->____hn * GROW_NUMERATOR) {
+		resize_hashtable(_, _->____hn * 2);
 	}
-	uint64_t __1 = ____increment_overflow_guard(&_->____idi);
-	size_t __2 = HF_((size_t)__1) % _->____hn;
-	size_t __3 = __2;
-	size_t __4 = 0;
+	const size_t __0 = _->____hn - 1;
+	size_t __2 = HF_(__) & __0;
 	while (_->____ht[__2] != NULL) {
-		__4++;
-		__2 = (__3 + __4) % _->____hn;
+		__2 = (__2 + 1) & __0;
 	}
 	const __cswiftslash_identified_list_t __5 = {
-		.____k = __1,
-		.____d = __,
+		.____k = __,
+		.____d = ___,
 		.____n = NULL,
 		.____p = _->____p
 	};
-	__cswiftslash_identified_list_ptr_t __6 = malloc(sizeof(__cswiftslash_identified_list_t));
+	__cswiftslash_identified_list_ptr_t __6 = __cswiftslash_pool_take(&_->____np);
 	memcpy(__6, &__5, sizeof(__cswiftslash_identified_list_t));
 	_->____ht[__2] = __6;
 	if (_->____p != NULL) {
@@ -119,8 +121,17 @@ uint64_t __cswiftslash_identified_list_insert(
 		_->____o = __6;
 	}
 	_->____i++;
+}
+
+uint64_t __cswiftslash_identified_list_insert(
+	const __cswiftslash_identified_list_pair_ptr_t _,
+	const __cswiftslash_ptr_t __
+) {
+	pthread_mutex_lock(&_->____m);
+	uint64_t __0 = ____increment_overflow_guard(&_->____idi);
+	____cswiftslash_identified_list_store(_, __0, __);
 	pthread_mutex_unlock(&_->____m);
-	return __1;
+	return __0;
 }
 
 __cswiftslash_optr_t __cswiftslash_identified_list_remove(
@@ -128,35 +139,31 @@ __cswiftslash_optr_t __cswiftslash_identified_list_remove(
 	const uint64_t __
 ) {
 	pthread_mutex_lock(&_->____m);
-	size_t __0 = HF_((size_t)__) % _->____hn;
-	const size_t __1 = __0;
-	size_t __2 = 0;
+	const size_t __0 = _->____hn - 1;
+	size_t __1 = HF_(__) & __0;
 	__cswiftslash_identified_list_ptr_t __3 = NULL;
-	while (_->____ht[__0] != NULL) {
-		if (_->____ht[__0]->____k == __) {
-			__3 = _->____ht[__0];
+	while (_->____ht[__1] != NULL) {
+		if (_->____ht[__1]->____k == __) {
+			__3 = _->____ht[__1];
 			break;
 		}
-		__2++;
-		__0 = (__1 + __2) % _->____hn;
+		__1 = (__1 + 1) & __0;
 	}
 	if (__3 == NULL) {
 		pthread_mutex_unlock(&_->____m);
 		return (__cswiftslash_optr_t)NULL;
 	}
-	_->____ht[__0] = NULL;
-	__0 = (__0 + 1) % _->____hn;
-	while (_->____ht[__0] != NULL) {
-		__cswiftslash_identified_list_ptr_t __1 = _->____ht[__0];
-		_->____ht[__0] = NULL;
-		size_t __4 = HF_(__1->____k) % _->____hn;
-		size_t __5 = 0;
-		while (_->____ht[__4] != NULL) {
-			__5++;
-			__4 = (__4 + 1) % _->____hn;
+	// backward-shift deletion: walk the rest of the probe run and pull back every entry that may legally occupy the hole, so lookups never need tombstones.
+	_->____ht[__1] = NULL;
+	size_t __2 = (__1 + 1) & __0;
+	while (_->____ht[__2] != NULL) {
+		const size_t __5 = HF_(_->____ht[__2]->____k) & __0;
+		if (((__2 - __5) & __0) >= ((__2 - __1) & __0)) {
+			_->____ht[__1] = _->____ht[__2];
+			_->____ht[__2] = NULL;
+			__1 = __2;
 		}
-		_->____ht[__4] = __1;
-		__0 = (__0 + 1) % _->____hn;
+		__2 = (__2 + 1) & __0;
 	}
 	if (__3->____p != NULL) {
 		__3->____p->____n = __3->____n;
@@ -169,14 +176,10 @@ __cswiftslash_optr_t __cswiftslash_identified_list_remove(
 		_->____p = __3->____p;
 	}
 	__cswiftslash_optr_t __4 = __3->____d;
-	free(__3);
+	__cswiftslash_pool_give(&_->____np, __3);
 	_->____i--;
-	if (((double)((double)_->____i / (double)_->____hn)) < RESIZE_DOWN_FACTOR && _->____hn > INITIAL_HASH_TABLE_SIZE) {
-		size_t __5 = _->____hn / RESIZE_MULTIPLIER;
-		if (__5 < INITIAL_HASH_TABLE_SIZE) {
-			__5 = INITIAL_HASH_TABLE_SIZE;
-		}
-		resize_hashtable(_, __5);
+	if (_->____hn > INITIAL_HASH_TABLE_SIZE && _->____i * SHRINK_DIVISOR < _->____hn) {
+		resize_hashtable(_, _->____hn / 2);
 	}
 	pthread_mutex_unlock(&_->____m);
 	return __4;
@@ -212,6 +215,8 @@ void __cswiftslash_identified_list_close(
 			__0 = __0->____n;
 			free(__1);
 		}
+		// free the recycled nodes that are held in the pool.
+		__cswiftslash_pool_drain(&_->____np);
 		free(_->____ht);
 		pthread_mutex_unlock(&_->____m);
 		pthread_mutex_destroy(&_->____m);
@@ -229,18 +234,121 @@ void __cswiftslash_identified_list_iterate_consume_zero(
 		__(__0->____k, __0->____d, ___);
 		__cswiftslash_identified_list_ptr_t __1 = __0;
 		__0 = __0->____n;
-		free(__1);
+		__cswiftslash_pool_give(&_->____np, __1);
 	}
 	_->____o = NULL;
 	_->____p = NULL;
 	_->____i = 0;
+	memset(_->____ht, 0, _->____hn * sizeof(__cswiftslash_identified_list_ptr_t));
 	if (____ == false) {
 		pthread_mutex_unlock(&_->____m);
 	}
 }
 
+size_t __cswiftslash_identified_list_node_allocations(
+	const __cswiftslash_identified_list_pair_ptr_t _
+) {
+	return __cswiftslash_pool_allocations(&_->____np);
+}
+
 void __cswiftslash_identified_list_iterate_hanginglock_complete(
 	const __cswiftslash_identified_list_pair_ptr_t _
 ) {
 	pthread_mutex_unlock(&_->____m);
 }
+
+// sharded variant.
+
+__cswiftslash_identified_list_sharded_ptr_t __cswiftslash_identified_list_sharded_init(
+	const size_t _
+) {
+	size_t __0 = 1;
+	while (__0 < _ && __0 < __CSWIFTSLASH_IDENTIFIED_LIST_MAX_SHARDS) {
+		__0 <<= 1;
+	}
+	// aligned_alloc requires the allocation size to be a multiple of the alignment.
+	const size_t __1 = sizeof(__cswiftslash_identified_list_sharded_t) + (__0 * sizeof(__cswiftslash_identified_list_shard_t));
+	__cswiftslash_identified_list_sharded_ptr_t __2 = aligned_alloc(__CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE, ((__1 + __CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE - 1) / __CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE) * __CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE);
+	if (__2 == NULL) {
+		printf("swiftslash identified list internal error: failed to allocate sharded list\n");
+		abort();
+	}
+	atomic_init(&__2->____idi, 0);
+	__2->____sm = __0 - 1;
+	for (size_t __3 = 0; __3 < __0; __3++) {
+		__2->____s[__3].____l = __cswiftslash_identified_list_init();
+	}
+	return __2;
+}
+
+/// @return the shard that owns the given key.
+static __cswiftslash_identified_list_pair_ptr_t ____cswiftslash_identified_list_shard_for(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const uint64_t __
+) {
+	return &_->____s[__ & _->____sm].____l;
+}
+
+void __cswiftslash_identified_list_sharded_close(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___
+) {
+	for (size_t __0 = 0; __0 <= _->____sm; __0++) {
+		__cswiftslash_identified_list_close(&_->____s[__0].____l, __, ___);
+	}
+	free(_);
+}
+
+uint64_t __cswiftslash_identified_list_sharded_insert(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_ptr_t __
+) {
+	// the key itself selects the shard, so consecutive inserts land on consecutive shards and a remove can find its shard without any shared lookup.
+	uint64_t __0;
+	do {
+		__0 = atomic_fetch_add_explicit(&_->____idi, 1, memory_order_relaxed) + 1;
+	} while (__0 == 0);
+	__cswiftslash_identified_list_pair_ptr_t __1 = ____cswiftslash_identified_list_shard_for(_, __0);
+	pthread_mutex_lock(&__1->____m);
+	____cswiftslash_identified_list_store(__1, __0, __);
+	pthread_mutex_unlock(&__1->____m);
+	return __0;
+}
+
+__cswiftslash_optr_t __cswiftslash_identified_list_sharded_remove(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const uint64_t __
+) {
+	return __cswiftslash_identified_list_remove(____cswiftslash_identified_list_shard_for(_, __), __);
+}
+
+void __cswiftslash_identified_list_sharded_iterate(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___,
+	const bool ____
+) {
+	for (size_t __0 = 0; __0 <= _->____sm; __0++) {
+		__cswiftslash_identified_list_iterate(&_->____s[__0].____l, __, ___, ____);
+	}
+}
+
+void __cswiftslash_identified_list_sharded_iterate_consume_zero(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___,
+	const bool ____
+) {
+	for (size_t __0 = 0; __0 <= _->____sm; __0++) {
+		__cswiftslash_identified_list_iterate_consume_zero(&_->____s[__0].____l, __, ___, ____);
+	}
+}
+
+void __cswiftslash_identified_list_sharded_iterate_hanginglock_complete(
+	const __cswiftslash_identified_list_sharded_ptr_t _
+) {
+	for (size_t __0 = _->____sm + 1; __0 > 0; __0--) {
+		__cswiftslash_identified_list_iterate_hanginglock_complete(&_->____s[__0 - 1].____l);
+	}
+}
\ No newline at end of file
@@ -13,11 +13,16 @@ copyright (c) tanner silva 2025. all rights reserved.
 #define __CLIBSWIFTSLASH_IDENTIFIED_LIST_H
 
 #include "__cswiftslash_types.h"
+#include "__cswiftslash_pool.h"
 
 #include <pthread.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+/// the maximum number of removed nodes that an identified list will hold for reuse. nodes that are removed beyond this count are freed.
+#define __CSWIFTSLASH_IDENTIFIED_LIST_NODE_POOL_MAX 128
+
 /// forward declaration of the identified list structure.
 struct __cswiftslash_identified_list;
 
@@ -45,6 +50,7 @@ typedef struct __cswiftslash_identified_list_pair {
 	__cswiftslash_identified_list_ptr_t ____p;
 	__cswiftslash_identified_list_ptr_t ____o;
 	pthread_mutex_t ____m;
+	__cswiftslash_pool_t ____np;
 } __cswiftslash_identified_list_pair_t;
 
 /// non-null pointer to an atomic list pair.
@@ -111,10 +117,104 @@ void __cswiftslash_identified_list_iterate_consume_zero(
 	const bool ____
 );
 
+/// returns the number of nodes that have been allocated by the identified list over its lifetime. removed nodes are recycled by the list, so this value grows with the peak number of stored elements rather than the total number of insertions.
+/// @param _ pointer to the atomic list pair instance.
+/// @return the total number of node allocations made by the identified list.
+size_t __cswiftslash_identified_list_node_allocations(
+	const __cswiftslash_identified_list_pair_ptr_t _
+);
+
 /// iterate functions allow for the session lock to hang outside of the function. when this is called, the session lock is not released, and this function is used to complete the lock.
 /// @param _ pointer to the atomic list pair instance.
 void __cswiftslash_identified_list_iterate_hanginglock_complete(
 	const __cswiftslash_identified_list_pair_ptr_t _
 );
 
+// sharded variant. the same operations as above, spread across independently locked shards so that threads working on different keys do not contend on one mutex. iteration visits the shards in order and each shard in its own insertion order; there is no global insertion order across shards.
+
+/// upper bound on the number of shards a sharded list may be created with.
+#define __CSWIFTSLASH_IDENTIFIED_LIST_MAX_SHARDS 256
+/// shards are padded to this size so that two shard locks never share a cache line.
+#define __CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE 64
+
+/// a single shard of a sharded identified list.
+typedef struct __cswiftslash_identified_list_shard {
+	_Alignas(__CSWIFTSLASH_IDENTIFIED_LIST_CACHE_LINE) __cswiftslash_identified_list_pair_t ____l;
+} __cswiftslash_identified_list_shard_t;
+
+/// primary storage container for the sharded identified list.
+typedef struct __cswiftslash_identified_list_sharded {
+	_Atomic uint64_t ____idi;
+	size_t ____sm;
+	__cswiftslash_identified_list_shard_t ____s[];
+} __cswiftslash_identified_list_sharded_t;
+
+/// non-null pointer to a sharded identified list.
+typedef __cswiftslash_identified_list_sharded_t* _Nonnull __cswiftslash_identified_list_sharded_ptr_t;
+
+/// initializes a new sharded identified list.
+/// @param _ the requested number of shards. rounded up to a power of two and capped at `__CSWIFTSLASH_IDENTIFIED_LIST_MAX_SHARDS`. a value around the number of cores is a good starting point.
+/// @return a heap pointer to a new sharded identified list. must be deallocated with `__cswiftslash_identified_list_sharded_close`.
+__cswiftslash_identified_list_sharded_ptr_t __cswiftslash_identified_list_sharded_init(
+	const size_t _
+);
+
+/// deallocates the sharded identified list, passing every remaining element to the consumer function.
+/// @param _ pointer to the sharded identified list to be deallocated.
+/// @param __ function used to process the data pointer before deallocation.
+/// @param ___ optional context pointer to be passed into the consumer function.
+void __cswiftslash_identified_list_sharded_close(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___
+);
+
+/// inserts a new data pointer into the sharded identified list. only the owning shard is locked.
+/// @param _ pointer to the sharded identified list.
+/// @param __ pointer to the data to be stored.
+/// @return the new key value associated with the data pointer. this key will NEVER be zero.
+uint64_t __cswiftslash_identified_list_sharded_insert(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_ptr_t __
+);
+
+/// removes a key (and its corresponding stored pointer) from the sharded identified list. only the owning shard is locked.
+/// @param _ pointer to the sharded identified list.
+/// @param __ the key value of the element to be removed.
+/// @return the data pointer that was removed. NULL if the key was not found.
+__cswiftslash_optr_t __cswiftslash_identified_list_sharded_remove(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const uint64_t __
+);
+
+/// iterates through every shard in order, processing each data pointer with the provided consumer function.
+/// @param _ pointer to the sharded identified list.
+/// @param __ function used to process each data pointer.
+/// @param ___ context pointer to be passed into the consumer function.
+/// @param ____ if true, every shard will remain locked after the iteration is complete.
+void __cswiftslash_identified_list_sharded_iterate(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___,
+	const bool ____
+);
+
+/// iterates through every shard in order, removing each element after it is processed.
+/// @param _ pointer to the sharded identified list.
+/// @param __ function used to process each data pointer.
+/// @param ___ context pointer to be passed into the consumer function.
+/// @param ____ if true, every shard will remain locked after the iteration is complete.
+void __cswiftslash_identified_list_sharded_iterate_consume_zero(
+	const __cswiftslash_identified_list_sharded_ptr_t _,
+	const __cswiftslash_identified_list_iterator_f __,
+	const __cswiftslash_optr_t ___,
+	const bool ____
+);
+
+/// releases the shard locks left held by a sharded iterate call.
+/// @param _ pointer to the sharded identified list.
+void __cswiftslash_identified_list_sharded_iterate_hanginglock_complete(
+	const __cswiftslash_identified_list_sharded_ptr_t _
+);
+
 #endif // __CLIBSWIFTSLASH_IDENTIFIED_LIST_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#include "__cswiftslash_pool.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+__cswiftslash_pool_t __cswiftslash_pool_init(
+	const size_t _,
+	const size_t __
+) {
+	if (_ < sizeof(__cswiftslash_optr_t)) {
+		printf("swiftslash pool internal error: pool nodes must be able to hold a pointer\n");
+		abort();
+	}
+	__cswiftslash_pool_t __0 = {
+		.____fl = NULL,
+		.____fn = 0,
+		.____mx = __,
+		.____sz = _,
+		.____la = 0
+	};
+	return __0;
+}
+
+__cswiftslash_ptr_t __cswiftslash_pool_take(
+	const __cswiftslash_pool_ptr_t _
+) {
+	__cswiftslash_optr_t __0 = _->____fl;
+	if (__0 != NULL) {
+		_->____fl = *(__cswiftslash_optr_t *)__0;
+		_->____fn -= 1;
+		return __0;
+	}
+	__0 = malloc(_->____sz);
+	if (__0 == NULL) {
+		printf("swiftslash pool internal error: couldn't allocate pool node\n");
+		abort();
+	}
+	atomic_fetch_add_explicit(&_->____la, 1, memory_order_relaxed);
+	return __0;
+}
+
+void __cswiftslash_pool_give(
+	const __cswiftslash_pool_ptr_t _,
+	const __cswiftslash_ptr_t __
+) {
+	if (_->____fn >= _->____mx) {
+		free(__);
+		return;
+	}
+	*(__cswiftslash_optr_t *)__ = _->____fl;
+	_->____fl = __;
+	_->____fn += 1;
+}
+
+void __cswiftslash_pool_drain(
+	const __cswiftslash_pool_ptr_t _
+) {
+	__cswiftslash_optr_t __0 = _->____fl;
+	while (__0 != NULL) {
+		__cswiftslash_optr_t __1 = *(__cswiftslash_optr_t *)__0;
+		free(__0);
+		__0 = __1;
+	}
+	_->____fl = NULL;
+	_->____fn = 0;
+}
+
+size_t __cswiftslash_pool_allocations(
+	const __cswiftslash_pool_ptr_t _
+) {
+	return atomic_load_explicit(&_->____la, memory_order_acquire);
+}
\ No newline at end of file
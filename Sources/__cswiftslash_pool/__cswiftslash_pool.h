@@ -0,0 +1,69 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#ifndef __CLIBSWIFTSLASH_POOL_H
+#define __CLIBSWIFTSLASH_POOL_H
+
+#include "__cswiftslash_types.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/// a bounded pool of released nodes of a single size, so that a container which repeatedly stores and removes elements can reuse its nodes instead of returning them to the allocator. pooled nodes are chained through their first word, so a node must be at least the size of a pointer. NOTE: a pool does no locking of its own - every function other than `__cswiftslash_pool_allocations` must be called while holding the lock of the container that owns the pool. none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_pool {
+	__cswiftslash_optr_t ____fl;
+	size_t ____fn;
+	size_t ____mx;
+	size_t ____sz;
+	_Atomic size_t ____la;
+} __cswiftslash_pool_t;
+
+/// a non-null pointer to a node pool.
+typedef __cswiftslash_pool_t *_Nonnull __cswiftslash_pool_ptr_t;
+
+/// initializes a node pool.
+/// @param _ the size of each node in bytes.
+/// @param __ the maximum number of released nodes to hold for reuse. nodes released beyond this count are freed. a pool with a maximum of zero never holds a node.
+/// @return the initialized pool.
+__cswiftslash_pool_t __cswiftslash_pool_init(
+	const size_t _,
+	const size_t __
+);
+
+/// takes a node from the pool, allocating a new node only when the pool is empty.
+/// @param _ the pool to take the node from.
+/// @return an uninitialized node.
+__cswiftslash_ptr_t __cswiftslash_pool_take(
+	const __cswiftslash_pool_ptr_t _
+);
+
+/// returns a node to the pool. the node is freed if the pool is full.
+/// @param _ the pool to return the node to.
+/// @param __ the node to return. its contents are not preserved.
+void __cswiftslash_pool_give(
+	const __cswiftslash_pool_ptr_t _,
+	const __cswiftslash_ptr_t __
+);
+
+/// frees every node that is held in the pool. the pool remains usable afterwards.
+/// @param _ the pool to drain.
+void __cswiftslash_pool_drain(
+	const __cswiftslash_pool_ptr_t _
+);
+
+/// returns the number of nodes that have been allocated by the pool over its lifetime. this value grows with the peak number of nodes in use rather than the total number of nodes taken.
+/// @param _ the pool to query.
+/// @return the total number of node allocations made by the pool.
+size_t __cswiftslash_pool_allocations(
+	const __cswiftslash_pool_ptr_t _
+);
+
+#endif // __CLIBSWIFTSLASH_POOL_H
\ No newline at end of file
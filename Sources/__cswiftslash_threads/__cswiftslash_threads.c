@@ -9,9 +9,23 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 */
 
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
 #include "__cswiftslash_threads.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/// the number of seconds an overflow worker waits for new work before it exits.
+#define OVERFLOW_WORKER_IDLE_SECONDS 5
+/// the initial capacity of a worker deque. must be a power of two.
+#define INITIAL_DEQUE_CAPACITY 16
 
 __cswiftslash_threads_config_t __cswiftslash_threads_config_garbage() {
 	__cswiftslash_threads_config_t garbage;
@@ -19,11 +33,83 @@ __cswiftslash_threads_config_t __cswiftslash_threads_config_garbage() {
 	return garbage;
 }
 
+/// internal function that applies a stack size to creation attributes. darwin only accepts stack sizes that are a multiple of the page size, so the size is rounded up to the page size.
+/// @param _ the attributes to apply the stack size to.
+/// @param __ the stack size in bytes. must be greater than 0.
+/// @return 0 on success, or the error reported while applying the stack size.
+int ____cswiftslash_threads_attr_stack_size(
+	pthread_attr_t *_Nonnull _,
+	const size_t __
+) {
+	const size_t __0 = (size_t)sysconf(_SC_PAGESIZE);
+	return pthread_attr_setstacksize(_, ((__ + __0 - 1) / __0) * __0);
+}
+
+/// internal function that builds the creation attributes for a configuration.
+/// @param _ the configuration to read.
+/// @param __ the attributes to initialize. must be destroyed by the caller, even when an error is returned.
+/// @return 0 on success, or the error reported while applying an attribute.
+int ____cswiftslash_threads_attr_make(
+	const __cswiftslash_threads_config_t *_Nonnull _,
+	pthread_attr_t *_Nonnull __
+) {
+	pthread_attr_init(__);
+	int __0 = 0;
+	if (_->____ss > 0) {
+		__0 = ____cswiftslash_threads_attr_stack_size(__, _->____ss);
+		if (__0 != 0) {
+			return __0;
+		}
+	}
+	if (_->____sp != __CSWIFTSLASH_THREADS_SCHED_INHERIT) {
+		struct sched_param __1;
+		memset(&__1, 0, sizeof(struct sched_param));
+		__1.sched_priority = _->____sr;
+		__0 = pthread_attr_setinheritsched(__, PTHREAD_EXPLICIT_SCHED);
+		if (__0 == 0) {
+			__0 = pthread_attr_setschedpolicy(__, _->____sp);
+		}
+		if (__0 == 0) {
+			__0 = pthread_attr_setschedparam(__, &__1);
+		}
+	}
+	return __0;
+}
+
+/// internal function that applies the attributes that a pthread can only set on itself (name and cpu affinity). called from the new pthread before any work runs. these are best-effort: a name or cpu set that the system rejects does not stop the work from running.
+/// @param _ the configuration to read.
+void ____cswiftslash_threads_apply_self(
+	const __cswiftslash_threads_config_t *_Nonnull _
+) {
+	if (_->____nm[0] != '\0') {
+		#if defined(__APPLE__)
+		pthread_setname_np(_->____nm);
+		#else
+		pthread_setname_np(pthread_self(), _->____nm);
+		#endif
+	}
+	#if !defined(__APPLE__)
+	cpu_set_t __0;
+	CPU_ZERO(&__0);
+	bool __1 = false;
+	for (size_t __2 = 0; __2 < __CSWIFTSLASH_THREADS_CPU_SET_WORDS * 64 && __2 < CPU_SETSIZE; __2++) {
+		if ((_->____cs[__2 / 64] >> (__2 % 64)) & 1) {
+			CPU_SET(__2, &__0);
+			__1 = true;
+		}
+	}
+	if (__1 == true) {
+		pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &__0);
+	}
+	#endif
+}
+
 void *_Nullable ____cswiftslash_threads_f(void *_Nonnull _) {
 	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
 	pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
 	__cswiftslash_threads_config_t __0 = *((__cswiftslash_threads_config_t*)_);
 	free(_);
+	____cswiftslash_threads_apply_self(&__0);
 	const __cswiftslash_ptr_t __1 = __0.____af(__0.____aa);
 	pthread_cleanup_push(__0.____df, __1);
 	pthread_cleanup_push(__0.____cr, __1);
@@ -48,20 +134,532 @@ void *_Nullable ____cswiftslash_threads_f(void *_Nonnull _) {
 		.____af = __,
 		.____mf = ___,
 		.____cr = ____,
-		.____df = _____
+		.____df = _____,
+		.____ss = 0,
+		.____sp = __CSWIFTSLASH_THREADS_SCHED_INHERIT,
+		.____sr = 0
 	};
+	memset(__0->____nm, 0, sizeof(__0->____nm));
+	memset(__0->____cs, 0, sizeof(__0->____cs));
 	return __0;
 }
 
+void __cswiftslash_threads_config_set_stack_size(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const size_t __
+) {
+	_->____ss = __;
+}
+
+void __cswiftslash_threads_config_set_name(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const char *_Nonnull __
+) {
+	strncpy(_->____nm, __, __CSWIFTSLASH_THREADS_NAME_MAX - 1);
+	_->____nm[__CSWIFTSLASH_THREADS_NAME_MAX - 1] = '\0';
+}
+
+bool __cswiftslash_threads_config_add_cpu(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const size_t __
+) {
+	if (__ >= __CSWIFTSLASH_THREADS_CPU_SET_WORDS * 64) {
+		return false;
+	}
+	_->____cs[__ / 64] |= ((uint64_t)1 << (__ % 64));
+	return true;
+}
+
+void __cswiftslash_threads_config_set_sched(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const int __,
+	const int ___
+) {
+	_->____sp = __;
+	_->____sr = ___;
+}
+
 __cswiftslash_threads_t_type __cswiftslash_threads_config_run(
 	const __cswiftslash_threads_config_t *_Nonnull _,
 	int *_Nonnull __
 ) {
 	__cswiftslash_threads_t_type __0;
 	memset(&__0, 0, sizeof(__cswiftslash_threads_t_type));
-	(*__) = pthread_create(&__0, NULL, ____cswiftslash_threads_f, (void*)_);
+	pthread_attr_t __1;
+	(*__) = ____cswiftslash_threads_attr_make(_, &__1);
+	if ((*__) == 0) {
+		(*__) = pthread_create(&__0, &__1, ____cswiftslash_threads_f, (void*)_);
+	}
+	pthread_attr_destroy(&__1);
 	if ((*__) != 0) {
 		free((void*)_);
 	}
 	return __0;
+}
+
+// jobs.
+
+/// the pool worker that the current thread is, if any. lets work that is submitted from inside a pool job land on the submitting worker's own deque.
+static _Thread_local __cswiftslash_threads_worker_t *_Nullable ____cswiftslash_threads_current_worker = NULL;
+
+/// internal function that builds a queued job from a configuration.
+/// @param _ the configuration to copy into the job. this pointer is freed.
+/// @return a new queued job.
+__cswiftslash_threads_job_t *_Nonnull ____cswiftslash_threads_job_make(
+	const __cswiftslash_threads_config_t *_Nonnull _
+) {
+	__cswiftslash_threads_job_t *__0 = malloc(sizeof(__cswiftslash_threads_job_t));
+	if (__0 == NULL) {
+		printf("swiftslash threads internal error: couldn't allocate job\n");
+		abort();
+	}
+	__0->____c = *_;
+	free((void*)_);
+	pthread_mutex_init(&__0->____m, NULL);
+	pthread_cond_init(&__0->____cv, NULL);
+	__0->____s = __CSWIFTSLASH_THREADS_JOB_QUEUED;
+	__0->____cq = false;
+	return __0;
+}
+
+/// internal function that marks a job as done and wakes any thread that is joining it. also serves as the outermost cancellation cleanup handler of a running job. the job must not be touched by the running thread after this returns.
+/// @param _ the job that has finished.
+void ____cswiftslash_threads_job_finish(
+	void *_Nonnull _
+) {
+	__cswiftslash_threads_job_t *__0 = _;
+	pthread_mutex_lock(&__0->____m);
+	__0->____s = __CSWIFTSLASH_THREADS_JOB_DONE;
+	pthread_cond_broadcast(&__0->____cv);
+	pthread_mutex_unlock(&__0->____m);
+}
+
+/// internal function that runs the full lifecycle of a job on the current thread. must be called with cancellation disabled. this is the same lifecycle that a dedicated pthread runs, with the job marked as done at the very end (or as the thread unwinds from a cancellation).
+/// @param _ the job to run.
+void ____cswiftslash_threads_job_run(
+	__cswiftslash_threads_job_t *_Nonnull _
+) {
+	pthread_mutex_lock(&_->____m);
+	_->____t = pthread_self();
+	_->____s = __CSWIFTSLASH_THREADS_JOB_RUNNING;
+	const bool __0 = _->____cq;
+	pthread_mutex_unlock(&_->____m);
+	const __cswiftslash_threads_config_t __1 = _->____c;
+	const __cswiftslash_ptr_t __2 = __1.____af(__1.____aa);
+	if (__0 == true) {
+		// cancelled before it was picked up. run the same handlers that an immediate cancellation would.
+		__1.____cr(__2);
+		__1.____df(__2);
+		____cswiftslash_threads_job_finish(_);
+		return;
+	}
+	pthread_cleanup_push(____cswiftslash_threads_job_finish, _);
+	pthread_cleanup_push(__1.____df, __2);
+	pthread_cleanup_push(__1.____cr, __2);
+	pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+	pthread_testcancel();
+	__1.____mf(__2);
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+	pthread_cleanup_pop(0);
+	pthread_cleanup_pop(1);
+	pthread_cleanup_pop(1);
+}
+
+void __cswiftslash_threads_job_cancel(
+	const __cswiftslash_threads_job_ptr_t _
+) {
+	pthread_mutex_lock(&_->____m);
+	switch (_->____s) {
+		case __CSWIFTSLASH_THREADS_JOB_QUEUED:
+			_->____cq = true;
+			break;
+		case __CSWIFTSLASH_THREADS_JOB_RUNNING:
+			// the running thread cannot mark the job done without this lock, so the cancellation can only ever land on this job.
+			pthread_cancel(_->____t);
+			break;
+		case __CSWIFTSLASH_THREADS_JOB_DONE:
+			break;
+	}
+	pthread_mutex_unlock(&_->____m);
+}
+
+void __cswiftslash_threads_job_join(
+	const __cswiftslash_threads_job_ptr_t _
+) {
+	pthread_mutex_lock(&_->____m);
+	while (_->____s != __CSWIFTSLASH_THREADS_JOB_DONE) {
+		pthread_cond_wait(&_->____cv, &_->____m);
+	}
+	pthread_mutex_unlock(&_->____m);
+}
+
+void __cswiftslash_threads_job_destroy(
+	const __cswiftslash_threads_job_ptr_t _
+) {
+	if (_->____s != __CSWIFTSLASH_THREADS_JOB_DONE) {
+		printf("swiftslash threads internal error: job destroyed before it was joined\n");
+		abort();
+	}
+	pthread_cond_destroy(&_->____cv);
+	pthread_mutex_destroy(&_->____m);
+	free(_);
+}
+
+/// the entry point of a dedicated job thread.
+void *_Nullable ____cswiftslash_threads_dedicated_f(void *_Nonnull _) {
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+	pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
+	____cswiftslash_threads_apply_self(&((__cswiftslash_threads_job_t *)_)->____c);
+	____cswiftslash_threads_job_run(_);
+	return NULL;
+}
+
+__cswiftslash_threads_job_t *_Nullable __cswiftslash_threads_job_launch_dedicated(
+	const __cswiftslash_threads_config_t *_Nonnull _,
+	int *_Nonnull __
+) {
+	__cswiftslash_threads_job_t *__0 = ____cswiftslash_threads_job_make(_);
+	pthread_attr_t __1;
+	(*__) = ____cswiftslash_threads_attr_make(&__0->____c, &__1);
+	if ((*__) == 0) {
+		pthread_attr_setdetachstate(&__1, PTHREAD_CREATE_DETACHED);
+		pthread_t __2;
+		(*__) = pthread_create(&__2, &__1, ____cswiftslash_threads_dedicated_f, __0);
+	}
+	pthread_attr_destroy(&__1);
+	if ((*__) != 0) {
+		__0->____s = __CSWIFTSLASH_THREADS_JOB_DONE;
+		__cswiftslash_threads_job_destroy(__0);
+		return NULL;
+	}
+	return __0;
+}
+
+// worker deques.
+
+/// internal function that pushes a job onto the back of a deque, growing it if needed.
+void ____cswiftslash_threads_deque_push(
+	__cswiftslash_threads_deque_t *_Nonnull _,
+	__cswiftslash_threads_job_t *_Nonnull __
+) {
+	pthread_mutex_lock(&_->____m);
+	if (_->____n == _->____cap) {
+		const size_t __0 = _->____cap * 2;
+		__cswiftslash_threads_job_t *_Nullable *__1 = malloc(__0 * sizeof(__cswiftslash_threads_job_t *));
+		if (__1 == NULL) {
+			printf("swiftslash threads internal error: couldn't grow worker deque\n");
+			abort();
+		}
+		for (size_t __2 = 0; __2 < _->____n; __2++) {
+			__1[__2] = _->____b[(_->____h + __2) & (_->____cap - 1)];
+		}
+		free(_->____b);
+		_->____b = __1;
+		_->____h = 0;
+		_->____cap = __0;
+	}
+	_->____b[(_->____h + _->____n) & (_->____cap - 1)] = __;
+	_->____n += 1;
+	pthread_mutex_unlock(&_->____m);
+}
+
+/// internal function that takes the newest job from a deque. used by the owning worker.
+/// @return the job, or NULL if the deque is empty.
+__cswiftslash_threads_job_t *_Nullable ____cswiftslash_threads_deque_pop(
+	__cswiftslash_threads_deque_t *_Nonnull _
+) {
+	__cswiftslash_threads_job_t *__0 = NULL;
+	pthread_mutex_lock(&_->____m);
+	if (_->____n > 0) {
+		_->____n -= 1;
+		__0 = _->____b[(_->____h + _->____n) & (_->____cap - 1)];
+	}
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+/// internal function that takes the oldest job from a deque. used by workers stealing from another worker.
+/// @return the job, or NULL if the deque is empty.
+__cswiftslash_threads_job_t *_Nullable ____cswiftslash_threads_deque_steal(
+	__cswiftslash_threads_deque_t *_Nonnull _
+) {
+	__cswiftslash_threads_job_t *__0 = NULL;
+	pthread_mutex_lock(&_->____m);
+	if (_->____n > 0) {
+		__0 = _->____b[_->____h];
+		_->____h = (_->____h + 1) & (_->____cap - 1);
+		_->____n -= 1;
+	}
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+// the worker pool.
+
+void *_Nullable ____cswiftslash_threads_worker_f(void *_Nonnull _);
+
+/// internal function that drops a reference to the pool memory. each live worker thread holds one reference and the pool owner holds one. the last reference frees the pool.
+void ____cswiftslash_threads_pool_release(
+	__cswiftslash_threads_pool_t *_Nonnull _
+) {
+	if (atomic_fetch_sub_explicit(&_->____rc, 1, memory_order_acq_rel) != 1) {
+		return;
+	}
+	for (size_t __0 = 0; __0 <= _->____wn; __0++) {
+		pthread_mutex_destroy(&_->____w[__0].____d.____m);
+		free(_->____w[__0].____d.____b);
+	}
+	pthread_cond_destroy(&_->____xv);
+	pthread_cond_destroy(&_->____cv);
+	pthread_mutex_destroy(&_->____m);
+	free(_);
+}
+
+/// internal function that starts a detached thread for a worker slot. must be called while holding the pool lock.
+/// @return true if the thread was started.
+bool ____cswiftslash_threads_pool_spawn(
+	__cswiftslash_threads_pool_t *_Nonnull _,
+	__cswiftslash_threads_worker_t *_Nonnull __
+) {
+	pthread_attr_t __0;
+	pthread_attr_init(&__0);
+	pthread_attr_setdetachstate(&__0, PTHREAD_CREATE_DETACHED);
+	if (_->____ss > 0 && ____cswiftslash_threads_attr_stack_size(&__0, _->____ss) != 0) {
+		pthread_attr_destroy(&__0);
+		return false;
+	}
+	atomic_fetch_add_explicit(&_->____rc, 1, memory_order_relaxed);
+	pthread_t __1;
+	const int __2 = pthread_create(&__1, &__0, ____cswiftslash_threads_worker_f, __);
+	pthread_attr_destroy(&__0);
+	if (__2 != 0) {
+		atomic_fetch_sub_explicit(&_->____rc, 1, memory_order_relaxed);
+		return false;
+	}
+	atomic_fetch_add_explicit(&_->____tc, 1, memory_order_relaxed);
+	return true;
+}
+
+/// internal function that records a worker thread leaving the pool. must be called while holding the pool lock.
+/// @param _ the pool that the worker is leaving.
+/// @param __ the slot of the worker that is leaving.
+void ____cswiftslash_threads_pool_worker_left(
+	__cswiftslash_threads_pool_t *_Nonnull _,
+	__cswiftslash_threads_worker_t *_Nonnull __
+) {
+	if (__->____x >= _->____wn) {
+		_->____ow -= 1;
+	}
+	_->____lw -= 1;
+	if (_->____lw == 0) {
+		pthread_cond_broadcast(&_->____xv);
+	}
+}
+
+/// cancellation cleanup handler of a worker thread. a job that was cancelled takes its thread down with it, so a persistent worker slot is handed to a fresh thread.
+void ____cswiftslash_threads_worker_cancelled(
+	void *_Nonnull _
+) {
+	__cswiftslash_threads_worker_t *__0 = _;
+	__cswiftslash_threads_pool_t *__1 = __0->____p;
+	pthread_mutex_lock(&__1->____m);
+	if (__0->____x >= __1->____wn || __1->____sd == true || ____cswiftslash_threads_pool_spawn(__1, __0) == false) {
+		____cswiftslash_threads_pool_worker_left(__1, __0);
+	}
+	pthread_mutex_unlock(&__1->____m);
+	____cswiftslash_threads_pool_release(__1);
+}
+
+/// internal function that finds the next job for a worker. the worker's own deque is checked first (newest job first), then the other deques are stolen from (oldest job first).
+/// @return the job, or NULL if there is no queued work.
+__cswiftslash_threads_job_t *_Nullable ____cswiftslash_threads_pool_take(
+	__cswiftslash_threads_pool_t *_Nonnull _,
+	__cswiftslash_threads_worker_t *_Nonnull __
+) {
+	__cswiftslash_threads_job_t *__0 = NULL;
+	if (__->____x < _->____wn) {
+		__0 = ____cswiftslash_threads_deque_pop(&__->____d);
+	}
+	for (size_t __1 = 1; __0 == NULL && __1 <= _->____wn; __1++) {
+		__0 = ____cswiftslash_threads_deque_steal(&_->____w[(__->____x + __1) % _->____wn].____d);
+	}
+	if (__0 != NULL) {
+		atomic_fetch_sub_explicit(&_->____pj, 1, memory_order_relaxed);
+	}
+	return __0;
+}
+
+/// internal function that parks an idle worker until there may be work for it.
+/// @return true if the worker should look for work again, false if the worker should exit. when false is returned, the worker has already been removed from the live count.
+bool ____cswiftslash_threads_pool_idle(
+	__cswiftslash_threads_pool_t *_Nonnull _,
+	__cswiftslash_threads_worker_t *_Nonnull __
+) {
+	pthread_mutex_lock(&_->____m);
+	if (atomic_load_explicit(&_->____pj, memory_order_acquire) > 0) {
+		pthread_mutex_unlock(&_->____m);
+		return true;
+	}
+	if (_->____sd == true) {
+		____cswiftslash_threads_pool_worker_left(_, __);
+		pthread_mutex_unlock(&_->____m);
+		return false;
+	}
+	const bool __0 = __->____x >= _->____wn;
+	struct timespec __1;
+	if (__0 == true) {
+		clock_gettime(CLOCK_REALTIME, &__1);
+		__1.tv_sec += OVERFLOW_WORKER_IDLE_SECONDS;
+	}
+	bool __2 = false;
+	_->____iw += 1;
+	while (_->____wk == 0 && _->____sd == false && __2 == false) {
+		if (__0 == true) {
+			__2 = pthread_cond_timedwait(&_->____cv, &_->____m, &__1) == ETIMEDOUT;
+		} else {
+			pthread_cond_wait(&_->____cv, &_->____m);
+		}
+	}
+	if (_->____wk > 0) {
+		// a submitter claimed this worker for its job.
+		_->____wk -= 1;
+		pthread_mutex_unlock(&_->____m);
+		return true;
+	}
+	_->____iw -= 1;
+	if (_->____sd == true || (__2 == true && atomic_load_explicit(&_->____pj, memory_order_acquire) == 0)) {
+		____cswiftslash_threads_pool_worker_left(_, __);
+		pthread_mutex_unlock(&_->____m);
+		return false;
+	}
+	pthread_mutex_unlock(&_->____m);
+	return true;
+}
+
+/// the entry point of a pool worker thread.
+void *_Nullable ____cswiftslash_threads_worker_f(void *_Nonnull _) {
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+	pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
+	__cswiftslash_threads_worker_t *__0 = _;
+	__cswiftslash_threads_pool_t *__1 = __0->____p;
+	____cswiftslash_threads_current_worker = __0;
+	pthread_cleanup_push(____cswiftslash_threads_worker_cancelled, __0);
+	while (true) {
+		__cswiftslash_threads_job_t *__2 = ____cswiftslash_threads_pool_take(__1, __0);
+		if (__2 != NULL) {
+			____cswiftslash_threads_job_run(__2);
+			// a cancellation that raced with the end of the job may still be pending on this thread. act on it here, between jobs, so that it can never reach the next job. the cleanup handler replaces this worker.
+			pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+			pthread_testcancel();
+			pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+			continue;
+		}
+		if (____cswiftslash_threads_pool_idle(__1, __0) == false) {
+			break;
+		}
+	}
+	pthread_cleanup_pop(0);
+	____cswiftslash_threads_pool_release(__1);
+	return NULL;
+}
+
+__cswiftslash_threads_pool_t *_Nullable __cswiftslash_threads_pool_init(
+	const size_t _,
+	const size_t __
+) {
+	size_t __0 = _;
+	if (__0 == 0) {
+		const long __1 = sysconf(_SC_NPROCESSORS_ONLN);
+		__0 = __1 > 0 ? (size_t)__1 : 1;
+	}
+	// one extra slot is reserved for overflow workers. it is never pushed to, but it gives overflow workers a slot to identify with.
+	__cswiftslash_threads_pool_t *__2 = malloc(sizeof(__cswiftslash_threads_pool_t) + ((__0 + 1) * sizeof(__cswiftslash_threads_worker_t)));
+	if (__2 == NULL) {
+		printf("swiftslash threads internal error: couldn't allocate worker pool\n");
+		abort();
+	}
+	pthread_mutex_init(&__2->____m, NULL);
+	pthread_cond_init(&__2->____cv, NULL);
+	pthread_cond_init(&__2->____xv, NULL);
+	__2->____lw = 0;
+	__2->____iw = 0;
+	__2->____wk = 0;
+	__2->____ow = 0;
+	__2->____sd = false;
+	atomic_init(&__2->____pj, 0);
+	atomic_init(&__2->____rr, 0);
+	atomic_init(&__2->____rc, 1);
+	atomic_init(&__2->____tc, 0);
+	__2->____ss = __;
+	__2->____wn = __0;
+	for (size_t __3 = 0; __3 <= __0; __3++) {
+		__cswiftslash_threads_worker_t *__4 = &__2->____w[__3];
+		__4->____p = __2;
+		__4->____x = __3;
+		pthread_mutex_init(&__4->____d.____m, NULL);
+		__4->____d.____b = malloc(INITIAL_DEQUE_CAPACITY * sizeof(__cswiftslash_threads_job_t *));
+		__4->____d.____h = 0;
+		__4->____d.____n = 0;
+		__4->____d.____cap = INITIAL_DEQUE_CAPACITY;
+	}
+	pthread_mutex_lock(&__2->____m);
+	for (size_t __3 = 0; __3 < __0; __3++) {
+		if (____cswiftslash_threads_pool_spawn(__2, &__2->____w[__3]) == true) {
+			__2->____lw += 1;
+		}
+	}
+	const size_t __5 = __2->____lw;
+	pthread_mutex_unlock(&__2->____m);
+	if (__5 == 0) {
+		____cswiftslash_threads_pool_release(__2);
+		return NULL;
+	}
+	return __2;
+}
+
+__cswiftslash_threads_job_ptr_t __cswiftslash_threads_pool_submit(
+	const __cswiftslash_threads_pool_ptr_t _,
+	const __cswiftslash_threads_config_t *_Nonnull __
+) {
+	__cswiftslash_threads_job_t *__0 = ____cswiftslash_threads_job_make(__);
+	__cswiftslash_threads_worker_t *__1 = ____cswiftslash_threads_current_worker;
+	if (__1 == NULL || __1->____p != _ || __1->____x >= _->____wn) {
+		__1 = &_->____w[atomic_fetch_add_explicit(&_->____rr, 1, memory_order_relaxed) % _->____wn];
+	}
+	____cswiftslash_threads_deque_push(&__1->____d, __0);
+	atomic_fetch_add_explicit(&_->____pj, 1, memory_order_release);
+	pthread_mutex_lock(&_->____m);
+	if (_->____iw > 0) {
+		// claim an idle worker for this job.
+		_->____iw -= 1;
+		_->____wk += 1;
+		pthread_cond_signal(&_->____cv);
+	} else if (_->____sd == false && _->____ow < __CSWIFTSLASH_THREADS_POOL_OVERFLOW_MAX) {
+		// every worker is busy, possibly blocked for a long time. start an overflow worker rather than letting the job wait behind them. if the thread cannot be started (or the overflow workers are at their limit), the job waits for the next free worker.
+		if (____cswiftslash_threads_pool_spawn(_, &_->____w[_->____wn]) == true) {
+			_->____lw += 1;
+			_->____ow += 1;
+		}
+	}
+	pthread_mutex_unlock(&_->____m);
+	return __0;
+}
+
+size_t __cswiftslash_threads_pool_threads_created(
+	const __cswiftslash_threads_pool_ptr_t _
+) {
+	return atomic_load_explicit(&_->____tc, memory_order_acquire);
+}
+
+void __cswiftslash_threads_pool_destroy(
+	const __cswiftslash_threads_pool_ptr_t _
+) {
+	pthread_mutex_lock(&_->____m);
+	_->____sd = true;
+	pthread_cond_broadcast(&_->____cv);
+	while (_->____lw > 0) {
+		pthread_cond_wait(&_->____xv, &_->____m);
+	}
+	pthread_mutex_unlock(&_->____m);
+	____cswiftslash_threads_pool_release(_);
 }
\ No newline at end of file
@@ -14,6 +14,11 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 #include "__cswiftslash_types.h"
 #include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __APPLE__
 typedef pthread_t _Nonnull __cswiftslash_threads_t_type;
@@ -38,6 +43,17 @@ typedef void(* __cswiftslash_threads_dealloc_f)(__cswiftslash_ptr_t ws);
 /// @param ws a pointer to the workspace that the pthread used.
 typedef void(* __cswiftslash_threads_cancel_f)(__cswiftslash_ptr_t ws);
 
+/// the number of 64 bit words in a thread configuration cpu set. enough for 1024 cpus, matching the default glibc cpu_set_t.
+#define __CSWIFTSLASH_THREADS_CPU_SET_WORDS 16
+/// the maximum length of a thread name, including the terminating NUL. linux rejects longer names, so this is the portable limit.
+#define __CSWIFTSLASH_THREADS_NAME_MAX 16
+/// scheduling policy value that leaves the policy inherited from the creating thread.
+#define __CSWIFTSLASH_THREADS_SCHED_INHERIT -1
+/// the scheduling policies of the platform, named here so that swift callers do not need the platform module.
+#define __CSWIFTSLASH_THREADS_SCHED_OTHER SCHED_OTHER
+#define __CSWIFTSLASH_THREADS_SCHED_FIFO SCHED_FIFO
+#define __CSWIFTSLASH_THREADS_SCHED_RR SCHED_RR
+
 /// a configuration for a pthread. this structure outlines the standardized way that work threads are created and managed.
 typedef struct __cswiftslash_threads_config_t {
 	__cswiftslash_ptr_t ____aa;
@@ -45,6 +61,11 @@ typedef struct __cswiftslash_threads_config_t {
 	__cswiftslash_threads_main_f _Nonnull ____mf;
 	__cswiftslash_threads_cancel_f _Nonnull ____cr;
 	__cswiftslash_threads_dealloc_f _Nonnull ____df;
+	size_t ____ss;
+	int ____sp;
+	int ____sr;
+	char ____nm[__CSWIFTSLASH_THREADS_NAME_MAX];
+	uint64_t ____cs[__CSWIFTSLASH_THREADS_CPU_SET_WORDS];
 } __cswiftslash_threads_config_t;
 
 /// create a pthread configuration.
@@ -61,6 +82,43 @@ __cswiftslash_threads_config_t *_Nonnull __cswiftslash_threads_config_init (
 	__cswiftslash_threads_dealloc_f _Nonnull _____
 );
 
+// thread attributes. these apply to pthreads that are created for a single configuration (`__cswiftslash_threads_config_run` and `__cswiftslash_threads_job_launch_dedicated`). pool workers are shared between jobs, so a job submitted to a pool runs with the attributes of the pool.
+
+/// set the stack size of the pthread.
+/// @param _ the configuration to modify.
+/// @param __ the stack size in bytes. 0 uses the system default. values below PTHREAD_STACK_MIN cause the launch to fail.
+void __cswiftslash_threads_config_set_stack_size(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const size_t __
+);
+
+/// set the name of the pthread. the name is applied by the pthread itself as it starts.
+/// @param _ the configuration to modify.
+/// @param __ the name to apply. truncated to `__CSWIFTSLASH_THREADS_NAME_MAX - 1` bytes.
+void __cswiftslash_threads_config_set_name(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const char *_Nonnull __
+);
+
+/// add a cpu to the set of cpus the pthread may run on. when no cpus are added, the pthread may run on any cpu. the affinity is applied by the pthread itself as it starts. on platforms without a cpu affinity interface (darwin), the set is ignored.
+/// @param _ the configuration to modify.
+/// @param __ the index of the cpu to allow.
+/// @return false if the cpu index is beyond what the configuration can represent.
+bool __cswiftslash_threads_config_add_cpu(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const size_t __
+);
+
+/// set an explicit scheduling policy for the pthread.
+/// @param _ the configuration to modify.
+/// @param __ the scheduling policy (SCHED_OTHER, SCHED_FIFO, SCHED_RR), or `__CSWIFTSLASH_THREADS_SCHED_INHERIT` to inherit the policy of the creating thread.
+/// @param ___ the scheduling priority to use with the policy. realtime policies usually require elevated privileges, and the launch fails without them.
+void __cswiftslash_threads_config_set_sched(
+	__cswiftslash_threads_config_t *_Nonnull _,
+	const int __,
+	const int ___
+);
+
 /// create a new pthread.
 /// @param _ the configuration to use for the pthread lifecycle. this pointer will be freed internally by this function.
 /// @param __ the result of the pthread creation.
@@ -70,4 +128,129 @@ __cswiftslash_threads_t_type __cswiftslash_threads_config_run(
 	int *_Nonnull __
 );
 
+// jobs and the worker pool.
+
+/// the states that a job moves through. a job only ever moves forward through these states.
+typedef enum __cswiftslash_threads_job_state_t {
+	/// the job is waiting in a queue for a thread to pick it up.
+	__CSWIFTSLASH_THREADS_JOB_QUEUED = 0,
+	/// a thread has picked up the job and is running its lifecycle functions. the job may be cancelled in this state.
+	__CSWIFTSLASH_THREADS_JOB_RUNNING = 1,
+	/// the job's lifecycle has fully completed, including the workspace deallocator.
+	__CSWIFTSLASH_THREADS_JOB_DONE = 2,
+} __cswiftslash_threads_job_state_t;
+
+/// a single unit of pthread work. the job carries the same lifecycle functions as a dedicated pthread and gives callers a handle for cancellation and joining that does not depend on which thread ends up running the work.
+typedef struct __cswiftslash_threads_job {
+	__cswiftslash_threads_config_t ____c;
+	pthread_mutex_t ____m;
+	pthread_cond_t ____cv;
+	__cswiftslash_threads_job_state_t ____s;
+	bool ____cq;
+	__cswiftslash_threads_t_type ____t;
+} __cswiftslash_threads_job_t;
+
+/// non-null pointer to a job.
+typedef __cswiftslash_threads_job_t* _Nonnull __cswiftslash_threads_job_ptr_t;
+
+/// a double ended queue of jobs owned by a single pool worker. the owning worker takes from the back, other workers steal from the front.
+typedef struct __cswiftslash_threads_deque {
+	pthread_mutex_t ____m;
+	__cswiftslash_threads_job_t *_Nullable *_Nonnull ____b;
+	size_t ____h;
+	size_t ____n;
+	size_t ____cap;
+} __cswiftslash_threads_deque_t;
+
+struct __cswiftslash_threads_pool;
+
+/// the maximum number of overflow workers that a pool runs at once. once this many overflow workers are alive, a job that finds every worker busy waits for the next worker to become free.
+#define __CSWIFTSLASH_THREADS_POOL_OVERFLOW_MAX 64
+
+/// one worker slot of a pool.
+typedef struct __cswiftslash_threads_worker {
+	struct __cswiftslash_threads_pool *_Nonnull ____p;
+	size_t ____x;
+	__cswiftslash_threads_deque_t ____d;
+} __cswiftslash_threads_worker_t;
+
+/// a persistent pool of pthreads that run jobs. the pool keeps one worker per slot alive for its whole lifetime. when a job is submitted and no worker is idle, an overflow worker is started (up to `__CSWIFTSLASH_THREADS_POOL_OVERFLOW_MAX` at once) so that a job does not wait behind blocking work. overflow workers exit after sitting idle.
+typedef struct __cswiftslash_threads_pool {
+	pthread_mutex_t ____m;
+	pthread_cond_t ____cv;
+	pthread_cond_t ____xv;
+	size_t ____lw;
+	size_t ____iw;
+	size_t ____wk;
+	size_t ____ow;
+	bool ____sd;
+	_Atomic size_t ____pj;
+	_Atomic size_t ____rr;
+	_Atomic size_t ____rc;
+	_Atomic size_t ____tc;
+	size_t ____ss;
+	size_t ____wn;
+	__cswiftslash_threads_worker_t ____w[];
+} __cswiftslash_threads_pool_t;
+
+/// non-null pointer to a worker pool.
+typedef __cswiftslash_threads_pool_t* _Nonnull __cswiftslash_threads_pool_ptr_t;
+
+/// create a worker pool and start its workers.
+/// @param _ the number of persistent workers. pass 0 to use the number of online processors.
+/// @param __ the stack size of every worker thread in bytes, rounded up to the page size. pass 0 to use the system default.
+/// @return a heap pointer to the new pool. must be destroyed with `__cswiftslash_threads_pool_destroy`. NULL if the pool could not start any workers.
+__cswiftslash_threads_pool_t *_Nullable __cswiftslash_threads_pool_init(
+	const size_t _,
+	const size_t __
+);
+
+/// submit work to a pool.
+/// @param _ the pool to run the work on.
+/// @param __ the configuration to use for the work lifecycle. this pointer will be freed internally by this function.
+/// @return a handle for the submitted job. must be joined with `__cswiftslash_threads_job_join` and then freed with `__cswiftslash_threads_job_destroy`.
+__cswiftslash_threads_job_ptr_t __cswiftslash_threads_pool_submit(
+	const __cswiftslash_threads_pool_ptr_t _,
+	const __cswiftslash_threads_config_t *_Nonnull __
+);
+
+/// returns the number of pthreads the pool has created over its lifetime. a reused pool keeps this close to the number of persistent workers.
+/// @param _ the pool to query.
+size_t __cswiftslash_threads_pool_threads_created(
+	const __cswiftslash_threads_pool_ptr_t _
+);
+
+/// stop the workers of a pool and free it. every submitted job must have been joined before this is called.
+/// @param _ the pool to destroy.
+void __cswiftslash_threads_pool_destroy(
+	const __cswiftslash_threads_pool_ptr_t _
+);
+
+/// run work on a new dedicated pthread, but hand back a job instead of a bare pthread. use this for work that blocks for the lifetime of its owner, so that it does not occupy a pool worker.
+/// @param _ the configuration to use for the work lifecycle. this pointer will be freed internally by this function.
+/// @param __ the result of the pthread creation.
+/// @return a handle for the job if result is 0, NULL otherwise.
+__cswiftslash_threads_job_t *_Nullable __cswiftslash_threads_job_launch_dedicated(
+	const __cswiftslash_threads_config_t *_Nonnull _,
+	int *_Nonnull __
+);
+
+/// cancel a job. if the job is running, its thread is cancelled and the job exits at the next cancellation point, running the cancel handler and the deallocator. if the job has not started, it will run the cancel handler and deallocator as soon as it is picked up. a job that has already finished is not affected.
+/// @param _ the job to cancel.
+void __cswiftslash_threads_job_cancel(
+	const __cswiftslash_threads_job_ptr_t _
+);
+
+/// block until a job has completed its full lifecycle.
+/// @param _ the job to join.
+void __cswiftslash_threads_job_join(
+	const __cswiftslash_threads_job_ptr_t _
+);
+
+/// free a job handle. the job must have been joined.
+/// @param _ the job to free.
+void __cswiftslash_threads_job_destroy(
+	const __cswiftslash_threads_job_ptr_t _
+);
+
 #endif // __CLIBSWIFTSLASH_THREADS_H
\ No newline at end of file
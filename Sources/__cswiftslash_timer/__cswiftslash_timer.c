@@ -0,0 +1,256 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "__cswiftslash_timer.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+
+/// the index of a deadline that is not stored in the heap.
+#define ____CSWIFTSLASH_TIMER_UNSCHEDULED SIZE_MAX
+
+/// the state of the shared timer thread. the heap and the reference counts of its deadlines are guarded by the mutex.
+static struct {
+	pthread_once_t ____o;
+	pthread_mutex_t ____m;
+	pthread_cond_t ____v;
+	__cswiftslash_timer_entry_t *_Nonnull *_Nullable ____h;
+	size_t ____n;
+	size_t ____cap;
+} ____cswiftslash_timer_shared = {
+	.____o = PTHREAD_ONCE_INIT,
+	.____m = PTHREAD_MUTEX_INITIALIZER,
+	.____h = NULL,
+	.____n = 0,
+	.____cap = 0
+};
+
+uint64_t __cswiftslash_timer_now(void) {
+	struct timespec __0;
+	clock_gettime(CLOCK_MONOTONIC, &__0);
+	return ((uint64_t)__0.tv_sec * 1000000000ULL) + (uint64_t)__0.tv_nsec;
+}
+
+uint64_t __cswiftslash_timer_deadline(
+	const int64_t _,
+	const int64_t __
+) {
+	const uint64_t __0 = __cswiftslash_timer_now();
+	if (_ < 0 || (_ == 0 && __ <= 0)) {
+		return __0;
+	}
+	// durations that are centuries long are treated as unbounded. this also keeps the deadline below from overflowing.
+	if (_ >= (int64_t)UINT32_MAX) {
+		return UINT64_MAX;
+	}
+	return __0 + ((uint64_t)_ * 1000000000ULL) + (uint64_t)(__ / 1000000000LL);
+}
+
+/// internal function that swaps two slots of the heap, keeping the stored index of each deadline current.
+/// @param _ the first slot.
+/// @param __ the second slot.
+void ____cswiftslash_timer_swap(
+	const size_t _,
+	const size_t __
+) {
+	__cswiftslash_timer_entry_t *_Nonnull *_Nonnull __0 = ____cswiftslash_timer_shared.____h;
+	__cswiftslash_timer_entry_t *_Nonnull __1 = __0[_];
+	__0[_] = __0[__];
+	__0[__] = __1;
+	__0[_]->____i = _;
+	__0[__]->____i = __;
+}
+
+/// internal function that restores the heap order around a slot whose deadline has changed.
+/// @param _ the slot to restore the order around.
+void ____cswiftslash_timer_sift(
+	size_t _
+) {
+	__cswiftslash_timer_entry_t *_Nonnull *_Nonnull __0 = ____cswiftslash_timer_shared.____h;
+	while (_ > 0 && __0[(_ - 1) / 2]->____d > __0[_]->____d) {
+		____cswiftslash_timer_swap(_, (_ - 1) / 2);
+		_ = (_ - 1) / 2;
+	}
+	while (true) {
+		const size_t __1 = (_ * 2) + 1;
+		const size_t __2 = __1 + 1;
+		size_t __3 = _;
+		if (__1 < ____cswiftslash_timer_shared.____n && __0[__1]->____d < __0[__3]->____d) {
+			__3 = __1;
+		}
+		if (__2 < ____cswiftslash_timer_shared.____n && __0[__2]->____d < __0[__3]->____d) {
+			__3 = __2;
+		}
+		if (__3 == _) {
+			return;
+		}
+		____cswiftslash_timer_swap(_, __3);
+		_ = __3;
+	}
+}
+
+/// internal function that removes a deadline from the heap. must be called while holding the mutex.
+/// @param _ the deadline to remove. this must be stored in the heap.
+void ____cswiftslash_timer_remove(
+	__cswiftslash_timer_entry_t *_Nonnull _
+) {
+	const size_t __0 = _->____i;
+	const size_t __1 = ____cswiftslash_timer_shared.____n - 1;
+	if (__0 != __1) {
+		____cswiftslash_timer_swap(__0, __1);
+	}
+	____cswiftslash_timer_shared.____n = __1;
+	_->____i = ____CSWIFTSLASH_TIMER_UNSCHEDULED;
+	if (__0 < __1) {
+		____cswiftslash_timer_sift(__0);
+	}
+}
+
+/// internal function that drops a reference to a deadline, freeing it when no references remain. must be called while holding the mutex.
+/// @param _ the deadline to release.
+void ____cswiftslash_timer_release(
+	__cswiftslash_timer_entry_t *_Nonnull _
+) {
+	_->____r -= 1;
+	if (_->____r == 0) {
+		free(_);
+	}
+}
+
+/// internal function that parks the timer thread until the deadline passes or the condition is signaled. must be called while holding the mutex.
+/// @param _ the deadline to wait for.
+void ____cswiftslash_timer_wait(
+	const uint64_t _
+) {
+	#if defined(__APPLE__)
+	const uint64_t __0 = __cswiftslash_timer_now();
+	if (__0 >= _) {
+		return;
+	}
+	const struct timespec __1 = {
+		.tv_sec = (time_t)((_ - __0) / 1000000000ULL),
+		.tv_nsec = (long)((_ - __0) % 1000000000ULL)
+	};
+	pthread_cond_timedwait_relative_np(&____cswiftslash_timer_shared.____v, &____cswiftslash_timer_shared.____m, &__1);
+	#else
+	const struct timespec __1 = {
+		.tv_sec = (time_t)(_ / 1000000000ULL),
+		.tv_nsec = (long)(_ % 1000000000ULL)
+	};
+	pthread_cond_timedwait(&____cswiftslash_timer_shared.____v, &____cswiftslash_timer_shared.____m, &__1);
+	#endif
+}
+
+/// internal function that runs the shared timer thread. deadlines are fired in order, with the mutex released while each handler runs.
+/// @param _ unused.
+void *_Nullable ____cswiftslash_timer_main(
+	void *_Nullable _
+) {
+	(void)_;
+	pthread_mutex_lock(&____cswiftslash_timer_shared.____m);
+	while (true) {
+		if (____cswiftslash_timer_shared.____n == 0) {
+			pthread_cond_wait(&____cswiftslash_timer_shared.____v, &____cswiftslash_timer_shared.____m);
+			continue;
+		}
+		__cswiftslash_timer_entry_t *_Nonnull __0 = ____cswiftslash_timer_shared.____h[0];
+		if (__0->____d > __cswiftslash_timer_now()) {
+			____cswiftslash_timer_wait(__0->____d);
+			continue;
+		}
+		____cswiftslash_timer_remove(__0);
+		pthread_mutex_unlock(&____cswiftslash_timer_shared.____m);
+		__0->____f(__0->____c);
+		pthread_mutex_lock(&____cswiftslash_timer_shared.____m);
+		____cswiftslash_timer_release(__0);
+	}
+	return NULL;
+}
+
+/// internal function that initializes the condition and starts the shared timer thread. on linux, the condition is bound to the monotonic clock. apple platforms use relative timed waits, which are unaffected by the wall clock.
+void ____cswiftslash_timer_start(void) {
+	#if defined(__APPLE__)
+	pthread_cond_init(&____cswiftslash_timer_shared.____v, NULL);
+	#else
+	pthread_condattr_t __0;
+	pthread_condattr_init(&__0);
+	pthread_condattr_setclock(&__0, CLOCK_MONOTONIC);
+	pthread_cond_init(&____cswiftslash_timer_shared.____v, &__0);
+	pthread_condattr_destroy(&__0);
+	#endif
+	pthread_t __1;
+	if (pthread_create(&__1, NULL, ____cswiftslash_timer_main, NULL) != 0) {
+		printf("swiftslash timer internal error: couldn't start the timer thread\n");
+		abort();
+	}
+	pthread_detach(__1);
+}
+
+__cswiftslash_timer_entry_ptr_t __cswiftslash_timer_schedule(
+	const uint64_t _,
+	const __cswiftslash_timer_f _Nonnull __,
+	const __cswiftslash_optr_t ___
+) {
+	pthread_once(&____cswiftslash_timer_shared.____o, ____cswiftslash_timer_start);
+	__cswiftslash_timer_entry_t *__0 = malloc(sizeof(__cswiftslash_timer_entry_t));
+	if (__0 == NULL) {
+		printf("swiftslash timer internal error: couldn't allocate timer entry\n");
+		abort();
+	}
+	__0->____d = _;
+	__0->____f = __;
+	__0->____c = ___;
+	// one reference is held by the heap (until the handler is fired or cancelled) and one by the caller (until it is passed to cancel).
+	__0->____r = 2;
+	pthread_mutex_lock(&____cswiftslash_timer_shared.____m);
+	if (____cswiftslash_timer_shared.____n == ____cswiftslash_timer_shared.____cap) {
+		const size_t __1 = (____cswiftslash_timer_shared.____cap == 0) ? 16 : ____cswiftslash_timer_shared.____cap * 2;
+		__cswiftslash_timer_entry_t *_Nonnull *__2 = realloc(____cswiftslash_timer_shared.____h, sizeof(__cswiftslash_timer_entry_t *) * __1);
+		if (__2 == NULL) {
+			printf("swiftslash timer internal error: couldn't grow timer heap\n");
+			abort();
+		}
+		____cswiftslash_timer_shared.____h = __2;
+		____cswiftslash_timer_shared.____cap = __1;
+	}
+	__0->____i = ____cswiftslash_timer_shared.____n;
+	____cswiftslash_timer_shared.____h[__0->____i] = __0;
+	____cswiftslash_timer_shared.____n += 1;
+	____cswiftslash_timer_sift(__0->____i);
+	// the timer thread only needs to be woken when this deadline is now the earliest.
+	if (__0->____i == 0) {
+		pthread_cond_signal(&____cswiftslash_timer_shared.____v);
+	}
+	pthread_mutex_unlock(&____cswiftslash_timer_shared.____m);
+	return __0;
+}
+
+bool __cswiftslash_timer_cancel(
+	const __cswiftslash_timer_entry_ptr_t _
+) {
+	bool __0 = false;
+	pthread_mutex_lock(&____cswiftslash_timer_shared.____m);
+	if (_->____i != ____CSWIFTSLASH_TIMER_UNSCHEDULED) {
+		____cswiftslash_timer_remove(_);
+		____cswiftslash_timer_release(_);
+		__0 = true;
+	}
+	____cswiftslash_timer_release(_);
+	pthread_mutex_unlock(&____cswiftslash_timer_shared.____m);
+	return __0;
+}
\ No newline at end of file
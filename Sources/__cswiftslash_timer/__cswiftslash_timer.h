@@ -0,0 +1,70 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+#ifndef __CLIBSWIFTSLASH_TIMER_H
+#define __CLIBSWIFTSLASH_TIMER_H
+
+#include "__cswiftslash_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// function prototype for a deadline handler. a scheduled handler is fired exactly once, from the shared timer thread, unless it is cancelled before its deadline.
+/// @param _ the context pointer that was scheduled with the handler.
+typedef void (* __cswiftslash_timer_f)(
+	const __cswiftslash_optr_t
+);
+
+/// structure representing a single scheduled deadline. NOTE: none of the fields in this structure need to be accessed directly by the caller.
+typedef struct __cswiftslash_timer_entry {
+	uint64_t ____d;
+	__cswiftslash_timer_f _Nonnull ____f;
+	__cswiftslash_optr_t ____c;
+	size_t ____i;
+	uint8_t ____r;
+} __cswiftslash_timer_entry_t;
+
+/// a non-null pointer to a scheduled deadline.
+typedef __cswiftslash_timer_entry_t *_Nonnull __cswiftslash_timer_entry_ptr_t;
+
+/// returns the current time of the monotonic clock that deadlines are measured against.
+/// @return the current time, in nanoseconds.
+uint64_t __cswiftslash_timer_now(void);
+
+/// converts a duration from now into a deadline on the clock of `__cswiftslash_timer_now`. the duration is given as the components of a swift `Duration`, which share the sign of the duration.
+/// @param _ the whole seconds of the duration.
+/// @param __ the attoseconds of the duration beyond its whole seconds.
+/// @return the deadline, in nanoseconds. a duration that is not positive returns the current time. a duration that is centuries long returns `UINT64_MAX`, which never passes.
+uint64_t __cswiftslash_timer_deadline(
+	const int64_t _,
+	const int64_t __
+);
+
+/// schedules a handler to be fired at a deadline. every scheduled deadline in the process is serviced by a single timer thread, which is started the first time a deadline is scheduled.
+/// @param _ the deadline, in nanoseconds on the clock of `__cswiftslash_timer_now`. deadlines that have already passed are fired as soon as possible.
+/// @param __ the handler to fire at the deadline. this runs on the timer thread and must not block.
+/// @param ___ the context pointer to pass to the handler.
+/// @return a pointer to the scheduled deadline. NOTE: this pointer must be passed to `__cswiftslash_timer_cancel` exactly once, whether or not the handler has fired.
+__cswiftslash_timer_entry_ptr_t __cswiftslash_timer_schedule(
+	const uint64_t _,
+	const __cswiftslash_timer_f _Nonnull __,
+	const __cswiftslash_optr_t ___
+);
+
+/// cancels a scheduled deadline and releases the caller's reference to it.
+/// @param _ the scheduled deadline to cancel. this pointer must not be used after this function returns.
+/// @return `true` if the deadline was cancelled before its handler was fired, in which case the handler will never fire; `false` if the handler has already been fired (or is being fired).
+bool __cswiftslash_timer_cancel(
+	const __cswiftslash_timer_entry_ptr_t _
+);
+
+#endif // __CLIBSWIFTSLASH_TIMER_H
\ No newline at end of file
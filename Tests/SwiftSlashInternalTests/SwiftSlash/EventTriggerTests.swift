@@ -26,46 +26,161 @@ extension SwiftSlashTests {
 		@Test("SwiftSlashEventTrigger :: reading lifecycle simple", .timeLimit(.minutes(1)))
 		func readingRegistration() async throws {
 			let newPipe = try PosixPipe()
-			let readingFIFO = FIFO<Int, Never>()
-			let asyncConsumer = readingFIFO.makeAsyncConsumer()
+			let readableDoorbell = Doorbell()
+			let asyncConsumer = readableDoorbell.makeAsyncConsumer()
 			let et:EventTrigger = try await EventTrigger()
 			let fut = Future<Void, DataChannel.ChildWrite.ParentRead.Error>()
 			fut.whenResult { result in
-				readingFIFO.finish()
+				readableDoorbell.finish()
 			}
-			try await et.register(reader:newPipe.reading, readingFIFO, finishFuture:fut)
+			try await et.register(reader:newPipe.reading, readableDoorbell, finishFuture:fut)
 			#expect(try newPipe.writing.writeFH(singleByte:0x0) == 1)
 			var nextItem:Int? = await asyncConsumer.next()
-			#expect(nextItem == 1, "readingFIFO should have 1 byte but instead found \(String(describing:nextItem))")
-			#expect(fut.hasResult() == false, "readingFIFO should not have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
+			#expect(nextItem == 1, "readableDoorbell should have 1 byte but instead found \(String(describing:nextItem))")
+			#expect(fut.hasResult() == false, "readableDoorbell should not have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
 			var myByte:UInt8 = 255
 			#expect(try newPipe.reading.readFH(into:&myByte, size:1) == 1)
-			#expect(myByte == 0x0, "readingFIFO should have read 0x0 but instead found \(String(describing:myByte))")
+			#expect(myByte == 0x0, "readableDoorbell should have read 0x0 but instead found \(String(describing:myByte))")
 			try newPipe.writing.closeFileHandle()
 			nextItem = await asyncConsumer.next()
-			#expect(nextItem == nil, "readingFIFO should be nil but instead found \(String(describing:nextItem))")
-			#expect(fut.hasResult() == true, "readingFIFO should have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
+			#expect(nextItem == nil, "readableDoorbell should be nil but instead found \(String(describing:nextItem))")
+			#expect(fut.hasResult() == true, "readableDoorbell should have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
 			try newPipe.reading.closeFileHandle()
 		}
 		@Test("SwiftSlashEventTrigger :: writing lifecycle simple", .timeLimit(.minutes(1)))
 		func writingRegistration() async throws {
 			let newPipe = try PosixPipe()
-			let writingFIFO = FIFO<Void, Never>()
-			let asyncConsumer: FIFO<Void, Never>.AsyncConsumer = writingFIFO.makeAsyncConsumer()
+			let writableDoorbell = Doorbell()
+			let asyncConsumer:Doorbell.AsyncConsumer = writableDoorbell.makeAsyncConsumer()
 			let et = try await EventTrigger()
 			let fut = Future<Void, Never>()
 			fut.whenResult { result in
-				writingFIFO.finish()
+				writableDoorbell.finish()
 			}
-			try await et.register(writer:newPipe.writing, writingFIFO, finishFuture:fut)
-			var nextItem:Void? = await asyncConsumer.next()
-			#expect(nextItem != nil, "writingFIFO should not be nil but instead found nil")
-			// #expect(fut.hasResult() == false, "writingFIFO should not have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
+			try await et.register(writer:newPipe.writing, writableDoorbell, finishFuture:fut)
+			var nextItem:Int? = await asyncConsumer.next()
+			#expect(nextItem != nil, "writableDoorbell should not be nil but instead found nil")
+			// #expect(fut.hasResult() == false, "writableDoorbell should not have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
 			try newPipe.reading.closeFileHandle()
 			nextItem = await asyncConsumer.next()
-			#expect(nextItem == nil, "writingFIFO should be nil but instead found \(String(describing:nextItem))")
-			// #expect(fut.hasResult() == true, "writingFIFO should have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
+			#expect(nextItem == nil, "writableDoorbell should be nil but instead found \(String(describing:nextItem))")
+			// #expect(fut.hasResult() == true, "writableDoorbell should have a result but instead found hasResult == \(String(describing:fut.hasResult()))")
 			try newPipe.writing.closeFileHandle()
 		}
+		@Test("SwiftSlashEventTrigger :: reading and writing lifecycle on the io_uring backend", .timeLimit(.minutes(1)))
+		func uringLifecycle() async throws {
+			let et = try await EventTrigger(backend:.ioUring)
+			// the backend is allowed to fall back where the kernel refuses io_uring. the lifecycle must hold either way.
+			#if !os(Linux)
+			#expect(et.backend == .poll)
+			#endif
+
+			let readPipe = try PosixPipe()
+			let readingDoorbell = Doorbell()
+			let readConsumer = readingDoorbell.makeAsyncConsumer()
+			let readFuture = Future<Void, DataChannel.ChildWrite.ParentRead.Error>()
+			readFuture.whenResult { _ in
+				readingDoorbell.finish()
+			}
+			try await et.register(reader:readPipe.reading, readingDoorbell, finishFuture:readFuture)
+			#expect(try readPipe.writing.writeFH(singleByte:0x0) == 1)
+			#expect(await readConsumer.next() != nil)
+			var myByte:UInt8 = 255
+			#expect(try readPipe.reading.readFH(into:&myByte, size:1) == 1)
+			try readPipe.writing.closeFileHandle()
+			#expect(await readConsumer.next() == nil)
+			#expect(readFuture.hasResult() == true)
+			try et.deregister(reader:readPipe.reading)
+			try readPipe.reading.closeFileHandle()
+
+			let writePipe = try PosixPipe()
+			let writingDoorbell = Doorbell()
+			let writeConsumer = writingDoorbell.makeAsyncConsumer()
+			let writeFuture = Future<Void, Never>()
+			writeFuture.whenResult { _ in
+				writingDoorbell.finish()
+			}
+			try await et.register(writer:writePipe.writing, writingDoorbell, finishFuture:writeFuture)
+			#expect(await writeConsumer.next() != nil)
+			try writePipe.reading.closeFileHandle()
+			#expect(await writeConsumer.next() == nil)
+			try et.deregister(writer:writePipe.writing)
+			try writePipe.writing.closeFileHandle()
+			#expect(et.load == 0)
+		}
+		@Test("SwiftSlashEventTrigger :: shard assignment and load", .timeLimit(.minutes(1)))
+		func shardAssignmentAndLoad() async throws {
+			let roundRobin = try await EventTriggerShards(count:3, policy:.roundRobin)
+			#expect(roundRobin.shards.count == 3)
+			for i in 0..<6 {
+				#expect(roundRobin.assign() === roundRobin.shards[i % 3])
+			}
+
+			let leastLoaded = try await EventTriggerShards(count:2, policy:.leastLoaded)
+			var pipes = [PosixPipe]()
+			var futures = [Future<Void, DataChannel.ChildWrite.ParentRead.Error>]()
+			var assigned = [EventTrigger]()
+			for _ in 0..<4 {
+				let newPipe = try PosixPipe()
+				let fut = Future<Void, DataChannel.ChildWrite.ParentRead.Error>()
+				let et = leastLoaded.assign()
+				try await et.register(reader:newPipe.reading, Doorbell(), finishFuture:fut)
+				pipes.append(newPipe)
+				futures.append(fut)
+				assigned.append(et)
+			}
+			#expect(leastLoaded.load == [2, 2], "expected an even spread but instead found \(leastLoaded.load)")
+			for (newPipe, et) in zip(pipes, assigned) {
+				try et.deregister(reader:newPipe.reading)
+				try newPipe.writing.closeFileHandle()
+				try newPipe.reading.closeFileHandle()
+			}
+			#expect(leastLoaded.load == [0, 0])
+		}
+		@Test("SwiftSlashEventTrigger :: timers fire in deadline order", .timeLimit(.minutes(1)))
+		func timerOrdering() async throws {
+			let et = try await EventTrigger()
+			let start = ContinuousClock.now
+			let late = Future<Void, Never>()
+			let early = Future<Void, Never>()
+			let cancelled = Future<Void, Never>()
+			et.register(timer:start.advanced(by:.milliseconds(300)), late)
+			et.register(timer:start.advanced(by:.milliseconds(50)), early)
+			et.register(timer:start.advanced(by:.milliseconds(10)), cancelled)
+			try cancelled.cancel()
+			#expect(await early.result() != nil)
+			#expect(late.hasResult() == false, "the later timer should not fire with the earlier one")
+			#expect(await late.result() != nil)
+			#expect(ContinuousClock.now - start >= .milliseconds(300))
+			#expect(await cancelled.result() == nil)
+		}
+		@Test("SwiftSlashEventTrigger :: cancelled timers are compacted out of the heap", .timeLimit(.minutes(1)))
+		func timerCompaction() async throws {
+			let timers = EventTriggerTimers()
+			timers.attach(arm:{ _ in })
+			let deadline = EventTriggerTimers.monotonicDeadline(ContinuousClock.now.advanced(by:.seconds(3600)))
+			let live = Future<Void, Never>()
+			timers.schedule(deadline, live)
+			for _ in 0..<10_000 {
+				let cancelled = Future<Void, Never>()
+				timers.schedule(deadline, cancelled)
+				try cancelled.cancel()
+			}
+			#expect(timers.count <= 128, "expected the cancelled timers to be compacted, but the heap holds \(timers.count) timers")
+			#expect(live.hasResult() == false)
+		}
+		@Test("SwiftSlashEventTrigger :: past deadlines convert to the current time", .timeLimit(.minutes(1)))
+		func timerPastDeadline() async throws {
+			for past in [Duration.milliseconds(500), .seconds(2), .zero] {
+				let converted = EventTriggerTimers.monotonicDeadline(ContinuousClock.now - past)
+				#expect(converted <= EventTriggerTimers.now())
+			}
+		}
+		@Test("SwiftSlashEventTrigger :: deadlines centuries away never pass", .timeLimit(.minutes(1)))
+		func timerDistantDeadline() async throws {
+			for distant in [Duration.seconds(Int64(UInt32.max)), .seconds(Int64(1) << 40)] {
+				#expect(EventTriggerTimers.monotonicDeadline(ContinuousClock.now.advanced(by:distant)) == UInt64.max)
+			}
+		}
 	}
 }
\ No newline at end of file
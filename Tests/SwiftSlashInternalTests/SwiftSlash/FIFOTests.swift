@@ -136,5 +136,285 @@ extension SwiftSlashTests {
 				}
 			}
 		}
+
+		@Test("SwiftSlashFIFO :: batch yield and drain", .timeLimit(.minutes(1)))
+		func testYieldContentsOfAndDrain() async {
+			var fifo:FIFO<WhenDeinitTool<Int>, Never>? = FIFO<WhenDeinitTool<Int>, Never>(maximumElementCount:8)
+			await confirmation("verify correct memory management of elements passed to the fifo", expectedCount:12) { deinitThing in
+				let consumer = fifo!.makeSyncConsumerNonBlocking()
+				#expect(consumer.drain()?.count == 0)
+				// the final four elements do not fit and are discarded immediately.
+				#expect(fifo!.yield(contentsOf:(0..<12).map { WhenDeinitTool($0, deinitThing) }) == .fifoFull)
+				#expect(consumer.drain()?.map { $0.value } == Array(0..<8))
+				fifo!.finish()
+				#expect(consumer.drain() == nil)
+				fifo = nil
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: intentional overflow of ring capacity (async)", .timeLimit(.minutes(1)))
+		func testRingCapacityOverflow() async {
+			let writeCount = 1000
+			let ringCapacity = 10 // rounded up to 16
+			var fifo:FIFO<WhenDeinitTool<Int>, Never>? = FIFO<WhenDeinitTool<Int>, Never>(ringCapacity:ringCapacity)
+			await confirmation("verify correct memory management of elements passed to the fifo", expectedCount:writeCount) { deinitThing in
+				await withTaskGroup(of:[Int].self) { tg in
+					var written = [Int]()
+					for i in 0..<writeCount {
+						if i < 16 {
+							#expect(fifo!.yield(WhenDeinitTool(i, deinitThing)) == .success)
+							written.append(i)
+						} else {
+							#expect(fifo!.yield(WhenDeinitTool(i, deinitThing)) == .fifoFull)
+						}
+					}
+					tg.addTask { [asc = fifo!.makeAsyncConsumer()] in
+						var buildInts = [Int]()
+						while let nextElement = await asc.next() {
+							buildInts.append(nextElement.value)
+						}
+						return buildInts
+					}
+					fifo!.finish()
+					let foundItem = await tg.next()!
+					#expect(written == foundItem, "\(foundItem) != \(written)")
+					fifo = nil
+				}
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: ring producer and consumer on separate tasks (async)", .timeLimit(.minutes(1)))
+		func testRingFullConsumption() async {
+			let elementCount = 10000
+			let fifo = FIFO<Int, Never>(ringCapacity:8)
+			await withTaskGroup(of:[Int].self) { tg in
+				tg.addTask { [asc = fifo.makeAsyncConsumer()] in
+					var buildInts = [Int]()
+					while let nextElement = await asc.next() {
+						buildInts.append(nextElement)
+					}
+					return buildInts
+				}
+				var written = [Int]()
+				for i in 0..<elementCount {
+					while fifo.yield(i) == .fifoFull {
+						await Task.yield()
+					}
+					written.append(i)
+				}
+				fifo.finish()
+				#expect(await tg.next() == written)
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: unboxed trivial elements round trip", .timeLimit(.minutes(1)))
+		func testUnboxedElements() async {
+			let written:[Int] = [0, -1, 1, Int.min, Int.max, 0, 42]
+			let intFIFO = FIFO<Int, Never>()
+			for value in written {
+				#expect(intFIFO.yield(value) == .success)
+			}
+			intFIFO.finish()
+			let syncConsumer = intFIFO.makeSyncConsumerNonBlocking()
+			var consumed = [Int]()
+			while let nextElement = syncConsumer.next() {
+				consumed.append(nextElement)
+			}
+			#expect(consumed == written)
+
+			let boolRing = FIFO<Bool, Never>(ringCapacity:4)
+			#expect(boolRing.yield(contentsOf:[false, true, false]) == .success)
+			#expect(boolRing.makeSyncConsumerNonBlocking().drain() == [false, true, false])
+
+			let voidFIFO = FIFO<Void, Never>()
+			for _ in 0..<3 {
+				voidFIFO.yield(())
+			}
+			voidFIFO.finish()
+			var voidCount = 0
+			let voidConsumer = voidFIFO.makeAsyncConsumer()
+			while await voidConsumer.next() != nil {
+				voidCount += 1
+			}
+			#expect(voidCount == 3)
+		}
+
+		@Test("SwiftSlashFIFO :: consume with a deadline (sync and async)", .timeLimit(.minutes(1)))
+		func testConsumeDeadline() async {
+			let fifo = FIFO<Int, Never>()
+
+			// the sync consumer gives up once the deadline passes.
+			let syncConsumer = fifo.makeSyncConsumerBlockingExplicit()
+			let syncStart = ContinuousClock.now
+			guard case .wouldBlock = syncConsumer.next(deadline:syncStart + .milliseconds(20)) else {
+				Issue.record("expected the sync consumer to time out")
+				return
+			}
+			#expect(ContinuousClock.now - syncStart >= .milliseconds(20))
+			fifo.yield(1)
+			guard case .element(1) = syncConsumer.next(deadline:.now + .seconds(1)) else {
+				Issue.record("expected the sync consumer to return the yielded element")
+				return
+			}
+
+			// the async consumer gives up once the deadline passes, then resumes normally.
+			let asyncConsumer = fifo.makeAsyncConsumerExplicit()
+			guard case .wouldBlock = await asyncConsumer.next(deadline:.now + .milliseconds(20)) else {
+				Issue.record("expected the async consumer to time out")
+				return
+			}
+			await withTaskGroup(of:Void.self) { tg in
+				tg.addTask {
+					try? await Task.sleep(for:.milliseconds(10))
+					fifo.yield(2)
+				}
+				guard case .element(2) = await asyncConsumer.next(deadline:.now + .seconds(10)) else {
+					Issue.record("expected the async consumer to return the yielded element")
+					return
+				}
+			}
+			fifo.finish()
+			guard case .capped(.success(_)) = await asyncConsumer.next(deadline:.now + .seconds(1)) else {
+				Issue.record("expected the async consumer to return the end of the FIFO")
+				return
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: consume with a deadline through the non-explicit consumers", .timeLimit(.minutes(1)))
+		func testConsumeDeadlineNonExplicit() async throws {
+			struct FinishingError:Swift.Error {}
+			let fifo = FIFO<Int, FinishingError>()
+
+			// the sync consumer reports a timeout once the deadline passes.
+			let syncConsumer = fifo.makeSyncConsumerBlocking()
+			let syncStart = ContinuousClock.now
+			#expect(throws:FIFOWaitError.timedOut) {
+				_ = try syncConsumer.next(deadline:syncStart + .milliseconds(20))
+			}
+			#expect(ContinuousClock.now - syncStart >= .milliseconds(20))
+			fifo.yield(1)
+			#expect(try syncConsumer.next(deadline:.now + .seconds(1)).get() == 1)
+
+			// the async consumer reports a timeout once the deadline passes, then resumes normally.
+			let asyncConsumer = fifo.makeAsyncConsumer()
+			await #expect(throws:FIFOWaitError.timedOut) {
+				_ = try await asyncConsumer.next(deadline:.now + .milliseconds(20))
+			}
+			try await withThrowingTaskGroup(of:Void.self) { tg in
+				tg.addTask {
+					try? await Task.sleep(for:.milliseconds(10))
+					fifo.yield(2)
+				}
+				#expect(try await asyncConsumer.next(deadline:.now + .seconds(10)).get() == 2)
+				try await tg.waitForAll()
+			}
+
+			// the end of the FIFO is not a timeout. the error that the FIFO was finished with is returned as a failure.
+			fifo.finish(throwing:FinishingError())
+			#expect(throws:FinishingError.self) {
+				_ = try syncConsumer.next(deadline:.now + .seconds(1)).get()
+			}
+			await #expect(throws:FinishingError.self) {
+				_ = try await asyncConsumer.next(deadline:.now + .seconds(1)).get()
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: broadcast fans out to every subscriber (async)", .timeLimit(.minutes(1)))
+		func testBroadcastFanOut() async {
+			let elementCount = 1000
+			let broadcast = BroadcastFIFO<Int, Never>()
+			#expect(broadcast.yield(-1) == .noSubscribers)
+			let firstSubscriber = broadcast.subscribe()
+			let secondSubscriber = broadcast.subscribe()
+			await withTaskGroup(of:[Int].self) { tg in
+				for subscriber in [firstSubscriber, secondSubscriber] {
+					tg.addTask {
+						var consumed = [Int]()
+						consumeLoop: repeat {
+							switch await subscriber.next() {
+								case .element(let element):
+									consumed.append(element)
+								case .capped:
+									break consumeLoop
+								case .wouldBlock:
+									Issue.record("async subscriber returned wouldBlock")
+									break consumeLoop
+							}
+						} while true
+						return consumed
+					}
+				}
+				for i in 0..<elementCount {
+					#expect(broadcast.yield(i) == .success)
+				}
+				broadcast.finish()
+				#expect(broadcast.yield(elementCount) == .fifoClosed)
+				for await consumed in tg {
+					#expect(consumed == Array(0..<elementCount))
+				}
+			}
+			#expect(broadcast.heldElementCount == 0)
+		}
+
+		@Test("SwiftSlashFIFO :: broadcast releases elements after the slowest subscriber", .timeLimit(.minutes(1)))
+		func testBroadcastRelease() async {
+			let broadcast = BroadcastFIFO<WhenDeinitTool<Int>, Never>()
+			let fastSubscriber = broadcast.subscribe()
+			var slowSubscriber:BroadcastFIFO<WhenDeinitTool<Int>, Never>.Subscriber? = broadcast.subscribe()
+			await confirmation("verify elements are released once every subscriber has passed them", expectedCount:3) { deinitExp in
+				broadcast.yield(WhenDeinitTool(1, deinitExp))
+				broadcast.yield(WhenDeinitTool(2, deinitExp))
+				broadcast.yield(WhenDeinitTool(3, deinitExp))
+				for expected in 1...3 {
+					guard case .element(let element) = fastSubscriber.nextNonBlocking() else {
+						Issue.record("fast subscriber did not receive element \(expected)")
+						return
+					}
+					#expect(element.value == expected)
+				}
+				guard case .wouldBlock = fastSubscriber.nextNonBlocking() else {
+					Issue.record("fast subscriber received more elements than were yielded")
+					return
+				}
+				// the slow subscriber still holds every element.
+				#expect(broadcast.heldElementCount == 3)
+				guard case .element(let element) = slowSubscriber!.nextNonBlocking() else {
+					Issue.record("slow subscriber did not receive the first element")
+					return
+				}
+				#expect(element.value == 1)
+				#expect(broadcast.heldElementCount == 2)
+				// the remaining elements are released when the slow subscriber goes away.
+				slowSubscriber = nil
+				#expect(broadcast.heldElementCount == 0)
+			}
+		}
+
+		@Test("SwiftSlashFIFO :: statistics snapshot", .timeLimit(.minutes(1)))
+		func testStatistics() async {
+			#expect(FIFO<Int, Never>().statistics == nil)
+			let fifo = FIFO<Int, Never>(collectStatistics:true)
+			fifo.yield(contentsOf:0..<10)
+			let consumer = fifo.makeAsyncConsumer()
+			for _ in 0..<4 {
+				_ = await consumer.next()
+			}
+			let stats = fifo.statistics!
+			#expect(stats.depth == 6)
+			#expect(stats.highWaterMark == 10)
+			#expect(stats.totalPassed == 10)
+			#expect(stats.totalConsumed == 4)
+
+			let broadcast = BroadcastFIFO<Int, Never>()
+			let subscriber = broadcast.subscribe()
+			for i in 0..<3 {
+				broadcast.yield(i)
+			}
+			_ = subscriber.nextNonBlocking()
+			let broadcastStats = broadcast.statistics
+			#expect(broadcastStats.depth == 2)
+			#expect(broadcastStats.highWaterMark == 3)
+			#expect(broadcastStats.totalPassed == 3)
+		}
 	}
 }
\ No newline at end of file
@@ -189,6 +189,118 @@ extension SwiftSlashTests {
 			#expect(future.cancelWaiter(resultHandler!) == false)
 		}
 
+		@Test("SwiftSlashFuture :: awaiting tasks do not occupy cooperative threads", .timeLimit(.minutes(1)))
+		func testAwaitersDoNotBlockThreads() async throws {
+			let future = Future<Int, Never>()
+			// far more awaiting tasks than there are cooperative threads. if awaiting blocked a thread, the task that sets the result could never run.
+			try await withThrowingTaskGroup(of:Int.self) { tg in
+				for _ in 0..<256 {
+					tg.addTask {
+						return await future.result()!.get()
+					}
+				}
+				tg.addTask {
+					await Task.yield()
+					try future.setSuccess(7)
+					return 7
+				}
+				var count = 0
+				for try await value in tg {
+					#expect(value == 7)
+					count += 1
+				}
+				#expect(count == 257)
+			}
+		}
+
+		@Test("SwiftSlashFuture :: awaiting task cancellation throws", .timeLimit(.minutes(1)))
+		func testAwaiterCancellationThrows() async throws {
+			struct Cancelled:Swift.Error {}
+			let future = Future<Int, Never>()
+			let waitingTask = Task {
+				return try await future.result(throwingOnCurrentTaskCancellation:Cancelled.self, taskCancellationError:Cancelled())
+			}
+			waitingTask.cancel()
+			await #expect(throws:Cancelled.self) {
+				_ = try await waitingTask.value
+			}
+			// the future is unaffected by the cancellation of a single waiter.
+			#expect(future.hasResult() == false)
+			try future.setSuccess(3)
+			#expect(await future.result()!.get() == 3)
+		}
+
+		@Test("SwiftSlashFuture :: whenAll waits for a large batch with one suspension", .timeLimit(.minutes(1)))
+		func testWhenAll() async throws {
+			let futures = (0..<1000).map { _ in Future<Int, Never>() }
+			// some futures are resolved before the wait begins, the rest are resolved while it is suspended.
+			for i in stride(from:0, to:1000, by:3) {
+				try futures[i].setSuccess(i)
+			}
+			let resolver = Task {
+				for i in 0..<1000 where i % 3 != 0 {
+					if i == 500 {
+						try futures[i].cancel()
+					} else {
+						try futures[i].setSuccess(i)
+					}
+				}
+			}
+			let results = try await Future.whenAll(futures)
+			try await resolver.value
+			#expect(results.count == 1000)
+			for (i, result) in results.enumerated() {
+				if i == 500 {
+					#expect(result == nil)
+				} else {
+					#expect(result?.get() == i)
+				}
+			}
+		}
+
+		@Test("SwiftSlashFuture :: whenAny returns the first resolved future", .timeLimit(.minutes(1)))
+		func testWhenAny() async throws {
+			let futures = (0..<16).map { _ in Future<Int, Never>() }
+			let resolver = Task {
+				try futures[11].setSuccess(42)
+			}
+			let first = try await Future.whenAny(futures)
+			try await resolver.value
+			#expect(first.index == 11)
+			#expect(first.result?.get() == 42)
+			// the remaining futures are unaffected.
+			#expect(futures[0].hasResult() == false)
+		}
+
+		@Test("SwiftSlashFuture :: result with timeout", .timeLimit(.minutes(1)))
+		func testResultTimeout() async throws {
+			let future = Future<Int, Never>()
+			await #expect(throws:FutureWaitError.self) {
+				_ = try await future.result(timeout:.milliseconds(20))
+			}
+			try future.setSuccess(9)
+			#expect(try await future.result(timeout:.seconds(10))?.get() == 9)
+		}
+
+		@Test("SwiftSlashFuture :: repeated and elapsed timeouts", .timeLimit(.minutes(1)))
+		func testRepeatedResultTimeouts() async throws {
+			let future = Future<Int, Never>()
+			// timeouts that have already elapsed (or are negative) time out without waiting.
+			for timeout in [Duration.zero, .nanoseconds(-1), .milliseconds(-250)] {
+				await #expect(throws:FutureWaitError.timedOut) {
+					_ = try await future.result(timeout:timeout)
+				}
+			}
+			// every timed out wait gives its registration back to the future.
+			for _ in 0..<200 {
+				await #expect(throws:FutureWaitError.timedOut) {
+					_ = try await future.result(timeout:.microseconds(50))
+				}
+			}
+			try future.setSuccess(3)
+			#expect(try await future.result(timeout:.seconds(10))?.get() == 3)
+		}
+
 		@Test("SwiftSlashFuture :: test blocking waiter", .timeLimit(.minutes(1)))
 		func testBlockingWaiter() throws {
 			let future = Future<Int, Never>()
@@ -84,4 +84,130 @@
 // 			#expect(result == keptItems)
 // 		}
 // 	}
-// }
\ No newline at end of file
+// }
+
+import Testing
+@testable import __cswiftslash_identified_list
+
+extension Tag {
+	@Tag internal static var swiftSlashIdentifiedListStorage:Self
+}
+
+extension SwiftSlashTests {
+	@Suite("SwiftSlashIdentifiedList storage",
+		.serialized,
+		.tags(.swiftSlashIdentifiedListStorage)
+	)
+	internal struct IdentifiedListStorageTests {
+		/// a list that is owned by a single test and closed when the harness is released.
+		private final class ListHarness {
+			private let listPtr:UnsafeMutablePointer<__cswiftslash_identified_list_pair_t>
+
+			fileprivate init() {
+				listPtr = UnsafeMutablePointer<__cswiftslash_identified_list_pair_t>.allocate(capacity:1)
+				listPtr.initialize(to:__cswiftslash_identified_list_init())
+			}
+
+			fileprivate func insert(_ data:UnsafeMutableRawPointer) -> UInt64 {
+				return __cswiftslash_identified_list_insert(listPtr, data)
+			}
+
+			fileprivate func remove(key:UInt64) -> UnsafeMutableRawPointer? {
+				return __cswiftslash_identified_list_remove(listPtr, key)
+			}
+
+			/// the number of nodes the list has allocated over its lifetime.
+			fileprivate func nodeAllocations() -> Int {
+				return __cswiftslash_identified_list_node_allocations(listPtr)
+			}
+
+			/// the number of slots in the hash table of the list.
+			fileprivate func tableSize() -> Int {
+				return listPtr.pointee.____hn
+			}
+
+			/// the number of elements stored in the list.
+			fileprivate func count() -> Int {
+				return listPtr.pointee.____i
+			}
+
+			deinit {
+				__cswiftslash_identified_list_close(listPtr, { _, _, _ in }, nil)
+				listPtr.deinitialize(count:1)
+				listPtr.deallocate()
+			}
+		}
+
+		@Test("SwiftSlashIdentifiedList :: node allocations follow the peak number of stored elements", .timeLimit(.minutes(1)))
+		func testNodeAllocationsPerElement() {
+			let list = ListHarness()
+			let data = UnsafeMutableRawPointer(bitPattern:0x1)!
+			let elementCount = 10_240
+
+			// one element stored at a time (the waiter registration pattern). the same node should be recycled for every insertion.
+			for _ in 0..<elementCount {
+				let key = list.insert(data)
+				#expect(list.remove(key:key) == data)
+			}
+			#expect(list.nodeAllocations() == 1)
+
+			// bursts that fit within the node pool should not allocate beyond the size of the first burst.
+			let burstSize = Int(__CSWIFTSLASH_IDENTIFIED_LIST_NODE_POOL_MAX)
+			var keys:[UInt64] = []
+			for _ in 0..<(elementCount / burstSize) {
+				for _ in 0..<burstSize {
+					keys.append(list.insert(data))
+				}
+				for key in keys {
+					#expect(list.remove(key:key) == data)
+				}
+				keys.removeAll(keepingCapacity:true)
+			}
+			#expect(list.nodeAllocations() == burstSize)
+		}
+
+		@Test("SwiftSlashIdentifiedList :: the table grows, shrinks and reuses slots vacated by backward-shift deletion", .timeLimit(.minutes(1)))
+		func testGrowShrinkAndBackwardShiftReuse() {
+			let list = ListHarness()
+			let initialSize = list.tableSize()
+			let peakCount = 4_096
+
+			// growth keeps the load of the table at or below three quarters.
+			var stored:[UInt64:UnsafeMutableRawPointer] = [:]
+			for i in 1...peakCount {
+				let data = UnsafeMutableRawPointer(bitPattern:i)!
+				stored[list.insert(data)] = data
+			}
+			#expect(list.count() == peakCount)
+			#expect(list.tableSize() > initialSize)
+			#expect(list.count() * 4 <= list.tableSize() * 3)
+			let grownSize = list.tableSize()
+
+			// removing every other key shifts the remainder of each probe run backward. a removed key must not be found again, and half the elements is not enough to shrink the table.
+			let removedKeys = stored.keys.sorted().filter { $0 % 2 == 0 }
+			for key in removedKeys {
+				#expect(list.remove(key:key) == stored.removeValue(forKey:key))
+			}
+			for key in removedKeys {
+				#expect(list.remove(key:key) == nil)
+			}
+			#expect(list.tableSize() == grownSize)
+
+			// the vacated slots are filled again without growing the table, and the new elements take their nodes from the pool before allocating.
+			for i in 1...removedKeys.count {
+				let data = UnsafeMutableRawPointer(bitPattern:peakCount + i)!
+				stored[list.insert(data)] = data
+			}
+			#expect(list.count() == peakCount)
+			#expect(list.tableSize() == grownSize)
+			#expect(list.nodeAllocations() == peakCount + removedKeys.count - Int(__CSWIFTSLASH_IDENTIFIED_LIST_NODE_POOL_MAX))
+
+			// every element is still found after the shifts, and the table shrinks back to its initial size as the list empties.
+			for key in stored.keys.sorted(by:>) {
+				#expect(list.remove(key:key) == stored[key])
+			}
+			#expect(list.count() == 0)
+			#expect(list.tableSize() == initialSize)
+		}
+	}
+}
\ No newline at end of file
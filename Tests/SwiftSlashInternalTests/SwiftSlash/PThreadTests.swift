@@ -15,6 +15,7 @@ import Testing
 import __cswiftslash_threads
 import SwiftSlashFuture
 import func Foundation.sleep
+import class Foundation.ProcessInfo
 
 extension Tag {
 	@Tag internal static var swiftSlashPThread:Self
@@ -57,6 +58,71 @@ extension SwiftSlashTests {
 			}
 		}
 
+
+		@Test("SwiftSlashPThread :: launch options", .timeLimit(.minutes(1)))
+		func testPthreadLaunchOptions() async throws {
+			let options = PThreadLaunchOptions(stackSize:256 * 1024, cpus:[0], name:"swiftslash-test")
+			let randomString = String.random(length:56)
+			let launched = try SimpleReturnWorker<String?>.launch(randomString, options:options)
+			let myString:String? = try await launched.workResult()!.get()
+			#expect(randomString == myString)
+
+			// options that a thread configuration cannot hold are rejected before anything is launched.
+			#expect(throws:PThreadLaunchFailure.self) {
+				_ = try SimpleReturnWorker<String?>.launch(randomString, options:PThreadLaunchOptions(cpus:[-1]))
+			}
+			#expect(throws:PThreadLaunchFailure.self) {
+				_ = try SimpleReturnWorker<String?>.launchDedicated(randomString, options:PThreadLaunchOptions(stackSize:0))
+			}
+		}
+
+		@Test("SwiftSlashPThread :: pool configuration is only taken before the pool starts", .timeLimit(.minutes(1)))
+		func testPoolConfiguration() async throws {
+			// values that the pool cannot hold are rejected outright.
+			#expect(PThreadPoolConfiguration.configure(PThreadPoolConfiguration(workers:0)) == false)
+			#expect(PThreadPoolConfiguration.configure(PThreadPoolConfiguration(stackSize:-1)) == false)
+			// once work has run on the pool, its configuration is fixed.
+			let randomString = String.random(length:56)
+			let myString:String? = try await SimpleReturnWorker<String?>.run(randomString)!.get()
+			#expect(randomString == myString)
+			#expect(PThreadPoolConfiguration.configure(PThreadPoolConfiguration(workers:2, stackSize:256 * 1024)) == false)
+		}
+
+		@Test("SwiftSlashPThread :: launching onto a saturated pool does not wait for a worker", .timeLimit(.minutes(1)))
+		func testPthreadLaunchOnSaturatedPool() async throws {
+			let gateFuture = Future<Void, Never>()
+			let saturatedFuture = Future<Void, Never>()
+			let innerFuture = Future<Running<GenericPThread<Int>>, Never>()
+
+			// a pool job that launches more work once every worker (including the overflow workers) is busy.
+			let launcher = try SwiftSlashPThread.launch { [gf = gateFuture, sf = saturatedFuture, inf = innerFuture] in
+				sf.blockingResult()!.get()
+				try inf.setSuccess(try SwiftSlashPThread.launch { 42 })
+				gf.blockingResult()!.get()
+			}
+
+			// occupy more workers than the pool may run at once, so the remaining jobs are queued.
+			let blockerCount = ProcessInfo.processInfo.processorCount + Int(__CSWIFTSLASH_THREADS_POOL_OVERFLOW_MAX) + 8
+			var blockers:[Running<GenericPThread<Void>>] = []
+			for _ in 0..<blockerCount {
+				blockers.append(try SwiftSlashPThread.launch { [gf = gateFuture] in
+					gf.blockingResult()!.get()
+				})
+			}
+			try saturatedFuture.setSuccess(())
+
+			// the inner job is queued behind the blocked workers. its launch must still hand back the running job straight away.
+			let inner = await innerFuture.result()!.get()
+
+			// release the pool and collect all of the work.
+			try gateFuture.setSuccess(())
+			#expect(try await inner.workResult()!.get() == 42)
+			_ = try await launcher.workResult()!.get()
+			for blocker in blockers {
+				_ = try await blocker.workResult()!.get()
+			}
+		}
+
 		
 		@Test("SwiftSlashPThread :: cancellation of pthreads that are already in flight (with memory checks)", .timeLimit(.minutes(1)))
 		func testPthreadCancellation() async throws {
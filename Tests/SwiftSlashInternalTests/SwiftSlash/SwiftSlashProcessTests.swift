@@ -58,6 +58,54 @@ extension SwiftSlashTests {
 			#expect(await errTask.result.get() == 0, "expected no errors from child process")
 			#expect(try await exitResult == .code(0))
 		}
+		@Test("SwiftSlashProcessTests :: subscriber iterators do not buffer for an unclaimed default iterator",
+			.timeLimit(.minutes(1))
+		)
+		func testSubscriberOnlyDataChannel() async throws {
+			let stream = DataChannel.ChildWrite.ParentRead()
+			let subscriberIterator = stream.makeSubscriberIterator()
+			stream.yield([[1]])
+			stream.yield([[2]])
+			#expect(await subscriberIterator.next() == [[1]])
+			#expect(await subscriberIterator.next() == [[2]])
+			// nothing is held for the default iterator, which was never created.
+			#expect(stream.broadcast.heldElementCount == 0)
+			// the default iterator now receives the data chunks written after it is created.
+			let defaultIterator = stream.makeAsyncIterator()
+			stream.yield([[3]])
+			stream.closeDataChannel()
+			#expect(await defaultIterator.next() == [[3]])
+			#expect(await defaultIterator.next() == nil)
+			#expect(await subscriberIterator.next() == [[3]])
+		}
+		@Test("SwiftSlashProcessTests :: reap a signaled child process without data channels",
+			.timeLimit(.minutes(1))
+		)
+		func testReapWithoutDataChannels() async throws {
+			// with no data channels, nothing but the reap registration keeps the event trigger engaged with the child process.
+			let command = Command(absolutePath:"/bin/sh", arguments:["-c", "kill -9 $$"])
+			let process = ChildProcess(command, dataChannels:[:])
+			#expect(try await process.run() == .signal(9))
+		}
+		@Test("SwiftSlashProcessTests :: deadline signals a child process that runs too long",
+			.timeLimit(.minutes(1))
+		)
+		func testDeadline() async throws {
+			let command = Command(absolutePath:"/bin/sleep", arguments:["30"])
+			let process = ChildProcess(command, dataChannels:[:])
+			#expect(try await process.run(deadline:.now.advanced(by:.milliseconds(100))) == .signal(SIGTERM))
+		}
+		@Test("SwiftSlashProcessTests :: deadline escalates to SIGKILL after the grace period",
+			.timeLimit(.minutes(1))
+		)
+		func testDeadlineEscalation() async throws {
+			// the child process ignores SIGTERM, so only the escalation stops it.
+			let command = Command(absolutePath:"/bin/sh", arguments:["-c", "trap '' TERM; while :; do :; done"])
+			let process = ChildProcess(command, dataChannels:[:])
+			let start = ContinuousClock.now
+			#expect(try await process.run(deadline:start.advanced(by:.milliseconds(100)), escalation:.init(grace:.milliseconds(200))) == .signal(SIGKILL))
+			#expect(ContinuousClock.now - start >= .milliseconds(300))
+		}
 		@Test("SwiftSlashProcessTests :: getting started example test",
 			  .timeLimit(.minutes(1))
 		)
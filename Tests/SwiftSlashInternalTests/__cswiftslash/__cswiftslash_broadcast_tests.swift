@@ -0,0 +1,141 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import Testing
+@testable import __cswiftslash_broadcast
+
+extension Tag {
+	@Tag internal static var __cswiftslash_broadcast:Self
+}
+
+extension __cswiftslash_tests {
+	@Suite("__cswiftslash_broadcast",
+		.serialized,
+		.tags(.__cswiftslash_broadcast)
+	)
+	internal struct __cswiftslash_broadcast {
+		// MARK: c harness
+		private final class Harness:@unchecked Sendable {
+			fileprivate let broadcastPtr:UnsafeMutablePointer<__cswiftslash_broadcast_t>
+			/// the data pointers that were released by the broadcast, in the order they were released
+			fileprivate var released = [Int]()
+			fileprivate init() {
+				broadcastPtr = __cswiftslash_broadcast_init()
+			}
+			/// passes an integer into the broadcast
+			fileprivate func pass(_ value:Int) -> Int8 {
+				return __cswiftslash_broadcast_pass(broadcastPtr, UnsafeMutableRawPointer(bitPattern:value))
+			}
+			/// caps the broadcast
+			fileprivate func cap() -> Bool {
+				return __cswiftslash_broadcast_pass_cap(broadcastPtr, nil)
+			}
+			/// adds a subscriber to the broadcast
+			fileprivate func subscribe() -> UnsafeMutablePointer<__cswiftslash_broadcast_subscriber_t> {
+				return __cswiftslash_broadcast_subscribe(broadcastPtr)
+			}
+			/// removes a subscriber from the broadcast, recording the data pointers that were no longer held by any subscriber
+			fileprivate func unsubscribe(_ subscriber:UnsafeMutablePointer<__cswiftslash_broadcast_subscriber_t>) {
+				withUnsafeMutablePointer(to:&released) { releasedPointer in
+					__cswiftslash_broadcast_unsubscribe(subscriber, { pointer, ctx in
+						ctx!.assumingMemoryBound(to:[Int].self).pointee.append(Int(bitPattern:pointer))
+					}, releasedPointer)
+				}
+			}
+			/// consumes the next element of a subscriber without waiting. the hold on the element is released, and the element is recorded when the subscriber held the last hold on it.
+			fileprivate func consume(_ subscriber:UnsafeMutablePointer<__cswiftslash_broadcast_subscriber_t>) -> (__cswiftslash_broadcast_consume_result_t, Int?) {
+				var pointer:__cswiftslash_optr_t = nil
+				var hold:__cswiftslash_broadcast_node_ptr_t = nil
+				let result = __cswiftslash_broadcast_consume_nonblocking(subscriber, &pointer, &hold)
+				guard result == __CSWIFTSLASH_BROADCAST_CONSUME_RESULT else {
+					return (result, nil)
+				}
+				if __cswiftslash_broadcast_release(broadcastPtr, hold!) == true {
+					released.append(Int(bitPattern:pointer))
+				}
+				return (result, Int(bitPattern:pointer))
+			}
+			/// the number of elements held by the broadcast
+			fileprivate var heldCount:Int {
+				return __cswiftslash_broadcast_held_count(broadcastPtr)
+			}
+			deinit {
+				var capPtr:__cswiftslash_optr_t = nil
+				__cswiftslash_broadcast_destroy(broadcastPtr, &capPtr)
+			}
+		}
+
+		// MARK: test cases
+
+		@Test("__cswiftslash_broadcast :: pass without subscribers", .timeLimit(.minutes(1)))
+		func passWithoutSubscribers() {
+			let broadcast = Harness()
+			#expect(broadcast.pass(1) == 1)
+			#expect(broadcast.heldCount == 0)
+		}
+
+		@Test("__cswiftslash_broadcast :: every subscriber consumes every element in order", .timeLimit(.minutes(1)))
+		func everySubscriberConsumes() {
+			let broadcast = Harness()
+			let first = broadcast.subscribe()
+			let second = broadcast.subscribe()
+			for i in 1...5 {
+				#expect(broadcast.pass(i) == 0)
+			}
+			// a late subscriber only sees elements passed after it subscribed.
+			let late = broadcast.subscribe()
+			#expect(broadcast.pass(6) == 0)
+			#expect(broadcast.cap() == true)
+			#expect(broadcast.cap() == false)
+			#expect(broadcast.pass(7) == -1)
+			for i in 1...6 {
+				#expect(broadcast.consume(first).1 == i)
+			}
+			#expect(broadcast.consume(first).0 == __CSWIFTSLASH_BROADCAST_CONSUME_CAP)
+			#expect(broadcast.released.isEmpty == true)
+			for i in 1...6 {
+				#expect(broadcast.consume(second).1 == i)
+			}
+			#expect(broadcast.consume(second).0 == __CSWIFTSLASH_BROADCAST_CONSUME_CAP)
+			// the first five elements were released by the second subscriber. the sixth is still held by the late subscriber.
+			#expect(broadcast.released == [1, 2, 3, 4, 5])
+			#expect(broadcast.heldCount == 1)
+			#expect(broadcast.consume(late).1 == 6)
+			#expect(broadcast.consume(late).0 == __CSWIFTSLASH_BROADCAST_CONSUME_CAP)
+			#expect(broadcast.released == [1, 2, 3, 4, 5, 6])
+			#expect(broadcast.heldCount == 0)
+			broadcast.unsubscribe(first)
+			broadcast.unsubscribe(second)
+			broadcast.unsubscribe(late)
+		}
+
+		@Test("__cswiftslash_broadcast :: unsubscribing releases held elements", .timeLimit(.minutes(1)))
+		func unsubscribeReleases() {
+			let broadcast = Harness()
+			let fast = broadcast.subscribe()
+			let slow = broadcast.subscribe()
+			for i in 1...4 {
+				#expect(broadcast.pass(i) == 0)
+			}
+			for i in 1...4 {
+				#expect(broadcast.consume(fast).1 == i)
+			}
+			#expect(broadcast.consume(fast).0 == __CSWIFTSLASH_BROADCAST_CONSUME_WOULDBLOCK)
+			#expect(broadcast.consume(slow).1 == 1)
+			#expect(broadcast.released == [1])
+			broadcast.unsubscribe(slow)
+			#expect(broadcast.released == [1, 2, 3, 4])
+			#expect(broadcast.heldCount == 0)
+			broadcast.unsubscribe(fast)
+			#expect(broadcast.pass(5) == 1)
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import Testing
+@testable import __cswiftslash_doorbell
+
+extension Tag {
+	@Tag internal static var __cswiftslash_doorbell:Self
+}
+
+extension __cswiftslash_tests {
+	@Suite("__cswiftslash_doorbell",
+		.serialized,
+		.tags(.__cswiftslash_doorbell)
+	)
+	internal struct __cswiftslash_doorbell {
+		// MARK: c harness
+		private final class Harness:@unchecked Sendable {
+			private let doorbellPtr:UnsafeMutablePointer<__cswiftslash_doorbell_t>
+			fileprivate init() {
+				doorbellPtr = __cswiftslash_doorbell_init()
+			}
+			/// rings the doorbell with the specified hint
+			fileprivate func ring(_ hint:Int) -> Int8 {
+				return __cswiftslash_doorbell_ring(doorbellPtr, hint)
+			}
+			/// closes the doorbell
+			fileprivate func close() -> Bool {
+				return __cswiftslash_doorbell_close(doorbellPtr)
+			}
+			/// takes the pending ring from the doorbell without waiting
+			fileprivate func take() -> (__cswiftslash_doorbell_take_result_t, Int) {
+				var hint:Int = 0
+				let result = __cswiftslash_doorbell_take(doorbellPtr, &hint)
+				return (result, hint)
+			}
+			/// the outcome of an async take that is handed to the suspended waiter
+			private struct AsyncHandoff:@unchecked Sendable {
+				fileprivate let result:__cswiftslash_doorbell_take_result_t
+				fileprivate let hint:Int
+			}
+			/// the context that is stored in the doorbell while an async consumer is suspended
+			private final class AsyncWaiter {
+				fileprivate let continuation:UnsafeContinuation<AsyncHandoff, Never>
+				fileprivate init(_ continuation:UnsafeContinuation<AsyncHandoff, Never>) {
+					self.continuation = continuation
+				}
+			}
+			/// takes the pending ring from the doorbell without blocking a thread. when the doorbell is not rung, the waiter is resumed by the next ring or close.
+			fileprivate func takeAsync() async -> (__cswiftslash_doorbell_take_result_t, Int) {
+				let handoff = await withUnsafeContinuation { (continuation:UnsafeContinuation<AsyncHandoff, Never>) in
+					let waiter = Unmanaged.passRetained(AsyncWaiter(continuation)).toOpaque()
+					var hint:Int = 0
+					let result = __cswiftslash_doorbell_take_async(doorbellPtr, &hint, { result, hint, ctx in
+						Unmanaged<AsyncWaiter>.fromOpaque(ctx!).takeRetainedValue().continuation.resume(returning:AsyncHandoff(result:result, hint:hint))
+					}, waiter)
+					guard result != __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK else {
+						return
+					}
+					_ = Unmanaged<AsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+					continuation.resume(returning:AsyncHandoff(result:result, hint:hint))
+				}
+				return (handoff.result, handoff.hint)
+			}
+			deinit {
+				__cswiftslash_doorbell_destroy(doorbellPtr)
+			}
+		}
+
+		// MARK: test cases
+
+		@Test("__cswiftslash_doorbell :: take from unrung doorbell", .timeLimit(.minutes(1)))
+		func takeFromUnrung() {
+			let doorbell = Harness()
+			#expect(doorbell.take().0 == __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK)
+		}
+
+		@Test("__cswiftslash_doorbell :: rings coalesce and retain the largest hint", .timeLimit(.minutes(1)))
+		func ringsCoalesce() {
+			let doorbell = Harness()
+			#expect(doorbell.ring(5) == 0)
+			#expect(doorbell.ring(12) == 1)
+			#expect(doorbell.ring(3) == 1)
+			let (takeResult, takeHint) = doorbell.take()
+			#expect(takeResult == __CSWIFTSLASH_DOORBELL_TAKE_RUNG)
+			#expect(takeHint == 12)
+			// the ring was consumed in its entirety.
+			#expect(doorbell.take().0 == __CSWIFTSLASH_DOORBELL_TAKE_WOULDBLOCK)
+		}
+
+		@Test("__cswiftslash_doorbell :: pending ring survives close", .timeLimit(.minutes(1)))
+		func pendingRingSurvivesClose() {
+			let doorbell = Harness()
+			#expect(doorbell.ring(7) == 0)
+			#expect(doorbell.close() == true)
+			#expect(doorbell.close() == false)
+			#expect(doorbell.ring(9) == -1)
+			let (takeResult, takeHint) = doorbell.take()
+			#expect(takeResult == __CSWIFTSLASH_DOORBELL_TAKE_RUNG)
+			#expect(takeHint == 7)
+			#expect(doorbell.take().0 == __CSWIFTSLASH_DOORBELL_TAKE_CLOSED)
+		}
+
+		@Test("__cswiftslash_doorbell :: waiter resumed by ring and by close", .timeLimit(.minutes(1)))
+		func waiterResumed() async {
+			let doorbell = Harness()
+			async let ringTake = doorbell.takeAsync()
+			try? await Task.sleep(nanoseconds:10_000_000)
+			#expect(doorbell.ring(42) == 0)
+			let (ringResult, ringHint) = await ringTake
+			#expect(ringResult == __CSWIFTSLASH_DOORBELL_TAKE_RUNG)
+			#expect(ringHint == 42)
+
+			async let closeTake = doorbell.takeAsync()
+			try? await Task.sleep(nanoseconds:10_000_000)
+			#expect(doorbell.close() == true)
+			#expect(await closeTake.0 == __CSWIFTSLASH_DOORBELL_TAKE_CLOSED)
+		}
+
+		@Test("__cswiftslash_doorbell :: chatty ringer costs one pending wakeup", .timeLimit(.minutes(1)))
+		func chattyRinger() async {
+			let doorbell = Harness()
+			let ringCount = 100_000
+			var wakeups = 0
+			var largestHint = 0
+			await withTaskGroup(of:Void.self) { tg in
+				tg.addTask {
+					for i in 1...ringCount {
+						_ = doorbell.ring(i)
+					}
+					_ = doorbell.close()
+				}
+				takeLoop: repeat {
+					let (takeResult, takeHint) = await doorbell.takeAsync()
+					guard takeResult == __CSWIFTSLASH_DOORBELL_TAKE_RUNG else {
+						break takeLoop
+					}
+					wakeups += 1
+					largestHint = max(largestHint, takeHint)
+				} while true
+			}
+			#expect(largestHint == ringCount)
+			#expect(wakeups <= ringCount)
+		}
+	}
+}
\ No newline at end of file
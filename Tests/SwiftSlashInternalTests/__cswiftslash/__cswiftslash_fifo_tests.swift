@@ -11,6 +11,7 @@ copyright (c) tanner silva 2025. all rights reserved.
 
 import Testing
 @testable import __cswiftslash_fifo
+import __cswiftslash_timer
 
 import class Foundation.ProcessInfo
 
@@ -50,14 +51,88 @@ extension __cswiftslash_tests {
 					continuation.resume(returning:(__cswiftslash_fifo_consume_blocking(fifoPtr, &consumedData), consumedData))
 				}
 			}
+			/// consumes data from the FIFO, blocking until data is available or the specified number of nanoseconds elapses
+			fileprivate func consumeBlocking(timeoutNanoseconds:UInt64) async -> (__cswiftslash_fifo_consume_result_t, UnsafeMutableRawPointer?) {
+				return await withUnsafeContinuation { (continuation:UnsafeContinuation<(__cswiftslash_fifo_consume_result_t, UnsafeMutableRawPointer?), Never>) in
+					var consumedData:UnsafeMutableRawPointer?
+					continuation.resume(returning:(__cswiftslash_fifo_consume_blocking_until(fifoPtr, &consumedData, __cswiftslash_timer_now() + timeoutNanoseconds), consumedData))
+				}
+			}
+			/// the outcome of an async consume that is handed to the suspended waiter
+			private struct AsyncHandoff:@unchecked Sendable {
+				fileprivate let result:__cswiftslash_fifo_consume_result_t
+				fileprivate let data:UnsafeMutableRawPointer?
+			}
+			/// the context that is stored in the FIFO while an async consumer is suspended
+			private final class AsyncWaiter {
+				fileprivate let continuation:UnsafeContinuation<AsyncHandoff, Never>
+				fileprivate init(_ continuation:UnsafeContinuation<AsyncHandoff, Never>) {
+					self.continuation = continuation
+				}
+			}
+			/// consumes data from the FIFO without blocking a thread. when the FIFO is empty, the waiter is resumed by the next pass or cap.
+			fileprivate func consumeAsync() async -> (__cswiftslash_fifo_consume_result_t, UnsafeMutableRawPointer?) {
+				let handoff = await withUnsafeContinuation { (continuation:UnsafeContinuation<AsyncHandoff, Never>) in
+					let waiter = Unmanaged.passRetained(AsyncWaiter(continuation)).toOpaque()
+					var consumedData:UnsafeMutableRawPointer?
+					let result = __cswiftslash_fifo_consume_async(fifoPtr, &consumedData, { result, data, ctx in
+						Unmanaged<AsyncWaiter>.fromOpaque(ctx!).takeRetainedValue().continuation.resume(returning:AsyncHandoff(result:result, data:data))
+					}, waiter)
+					guard result != __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK else {
+						return
+					}
+					_ = Unmanaged<AsyncWaiter>.fromOpaque(waiter).takeRetainedValue()
+					continuation.resume(returning:AsyncHandoff(result:result, data:consumedData))
+				}
+				return (handoff.result, handoff.data)
+			}
 			/// caps the FIFO with a final element
 			fileprivate func passCap(_ capData: UnsafeMutableRawPointer?) -> Bool {
 				return __cswiftslash_fifo_pass_cap(fifoPtr, capData)
 			}
+			/// passes a batch of data into the FIFO
+			fileprivate func passMany(_ data:[UnsafeMutableRawPointer]) -> (Int8, Int) {
+				var passedCount = 0
+				let result = data.map { Optional($0) }.withUnsafeBufferPointer { dataBuffer in
+					return __cswiftslash_fifo_pass_many(fifoPtr, dataBuffer.baseAddress!, dataBuffer.count, &passedCount)
+				}
+				return (result, passedCount)
+			}
+			/// consumes all of the data that is currently stored in the FIFO
+			fileprivate func consumeAll() -> (__cswiftslash_fifo_consume_result_t, [UnsafeMutableRawPointer], UnsafeMutableRawPointer?) {
+				var consumedData = [UnsafeMutableRawPointer]()
+				var capData:UnsafeMutableRawPointer? = nil
+				let result = withUnsafeMutablePointer(to:&consumedData) { consumedDataPointer in
+					return __cswiftslash_fifo_consume_all(fifoPtr, { data, ctx in
+						ctx!.assumingMemoryBound(to:[UnsafeMutableRawPointer].self).pointee.append(data!)
+					}, consumedDataPointer, &capData)
+				}
+				return (result, consumedData, capData)
+			}
+			/// returns the number of links the FIFO has allocated over its lifetime
+			fileprivate func linkAllocations() -> Int {
+				return __cswiftslash_fifo_link_allocations(fifoPtr)
+			}
 			/// sets the maximum number of elements in the FIFO
 			fileprivate func setMaxElements(_ maxElements:Int) -> Bool {
 				return __cswiftslash_fifo_set_max_elements(fifoPtr, maxElements)
 			}
+			/// enables the introspection counters of the FIFO
+			fileprivate func enableStatistics() -> Bool {
+				return __cswiftslash_fifo_enable_statistics(fifoPtr)
+			}
+			/// reads the introspection counters of the FIFO, or `nil` if they are not enabled
+			fileprivate func statistics() -> (depth:Int, highWaterMark:Int, passed:UInt64, consumed:UInt64, blockedNanoseconds:UInt64)? {
+				var depth:Int = 0
+				var highWaterMark:Int = 0
+				var passed:UInt64 = 0
+				var consumed:UInt64 = 0
+				var blockedNanoseconds:UInt64 = 0
+				guard __cswiftslash_fifo_statistics(fifoPtr, &depth, &highWaterMark, &passed, &consumed, &blockedNanoseconds) == true else {
+					return nil
+				}
+				return (depth, highWaterMark, passed, consumed, blockedNanoseconds)
+			}
 			private func closeFIFO() -> (Bool, UnsafeMutableRawPointer?) {
 				var cptr:UnsafeMutableRawPointer? = nil
 				return (__cswiftslash_fifo_close(fifoPtr, { _, _ in }, nil, &cptr), cptr)
@@ -236,6 +311,136 @@ extension __cswiftslash_tests {
 			#expect(consumedData == capData)
 		}
 
+		@Test("__cswiftslash_fifo :: async consume (element already available)", .timeLimit(.minutes(1)))
+		func testAsyncConsumeAvailable() async {
+			let data = UnsafeMutableRawPointer(bitPattern:0x1357)!
+			#expect(fifo!.pass(data) == 0)
+			let (consumeResult, consumedData) = await fifo!.consumeAsync()
+			#expect(consumeResult == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+			#expect(consumedData == data)
+		}
+
+		@Test("__cswiftslash_fifo :: async consume (waiter resumed by pass and cap)", .timeLimit(.minutes(1)))
+		func testAsyncConsumeWaiter() async {
+			let data = UnsafeMutableRawPointer(bitPattern:0x9bdf)!
+			let capData = UnsafeMutableRawPointer(bitPattern:0xbeef)!
+			await withTaskGroup(of:Void.self) { [fifo] group in
+				group.addTask {
+					let (consumeResult, consumedData) = await fifo!.consumeAsync()
+					#expect(consumeResult == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+					#expect(consumedData == data)
+					let (capResult, consumedCap) = await fifo!.consumeAsync()
+					#expect(capResult == __CSWIFTSLASH_FIFO_CONSUME_CAP)
+					#expect(consumedCap == capData)
+				}
+				group.addTask {
+					#expect(fifo!.pass(data) == 0)
+					#expect(fifo!.passCap(capData) == true)
+				}
+				await group.waitForAll()
+			}
+			// the element was handed directly to the waiter, so nothing remains in the chain.
+			let (consumeResult, _) = fifo!.consumeNonBlocking()
+			#expect(consumeResult == __CSWIFTSLASH_FIFO_CONSUME_CAP)
+		}
+
+		@Test("__cswiftslash_fifo :: async consume without a mutex (waiter resumed by pass and cap)", .timeLimit(.minutes(1)))
+		func testAsyncConsumeWaiterWithoutMutex() async {
+			let unguarded = Harness(hasMutex:false)
+			let capData = UnsafeMutableRawPointer(bitPattern:0xbeef)!
+			let elements = (1...1_000).map { UnsafeMutableRawPointer(bitPattern:$0)! }
+			await withTaskGroup(of:Void.self) { group in
+				group.addTask {
+					// every element reaches the consumer, whether it is handed to a stored waiter or linked into the chain as the waiter is stored.
+					for element in elements {
+						let (consumeResult, consumedData) = await unguarded.consumeAsync()
+						#expect(consumeResult == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+						#expect(consumedData == element)
+					}
+					let (capResult, consumedCap) = await unguarded.consumeAsync()
+					#expect(capResult == __CSWIFTSLASH_FIFO_CONSUME_CAP)
+					#expect(consumedCap == capData)
+				}
+				group.addTask {
+					for element in elements {
+						// without a mutex, a pass can lose the race to link its element and must be retried.
+						var passResult:Int8
+						repeat {
+							passResult = unguarded.pass(element)
+						} while passResult == 1
+						#expect(passResult == 0)
+					}
+					#expect(unguarded.passCap(capData) == true)
+				}
+				await group.waitForAll()
+			}
+		}
+
+		@Test("__cswiftslash_fifo :: batch pass then consume all", .timeLimit(.minutes(1)))
+		func testPassManyConsumeAll() async {
+			let data = (1...8).map { UnsafeMutableRawPointer(bitPattern:$0)! }
+			#expect(fifo!.consumeAll().0 == __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK)
+
+			let (passResult, passedCount) = fifo!.passMany(data)
+			#expect(passResult == 0)
+			#expect(passedCount == data.count)
+
+			let (consumeResult, consumedData, _) = fifo!.consumeAll()
+			#expect(consumeResult == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+			#expect(consumedData == data)
+			#expect(fifo!.consumeNonBlocking().0 == __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK)
+
+			// a batch that exceeds the maximum element count is passed in part.
+			#expect(fifo!.setMaxElements(5) == true)
+			let (partialResult, partialCount) = fifo!.passMany(data)
+			#expect(partialResult == -2)
+			#expect(partialCount == 5)
+			#expect(fifo!.consumeAll().1 == Array(data.prefix(5)))
+
+			// once capped, the cap is returned when the chain is empty.
+			let capData = UnsafeMutableRawPointer(bitPattern:0xfeed)!
+			#expect(fifo!.passCap(capData) == true)
+			#expect(fifo!.passMany(data) == (-1, 0))
+			let (capResult, _, consumedCap) = fifo!.consumeAll()
+			#expect(capResult == __CSWIFTSLASH_FIFO_CONSUME_CAP)
+			#expect(consumedCap == capData)
+		}
+
+		@Test("__cswiftslash_fifo :: link allocations per element", .timeLimit(.minutes(1)))
+		func testLinkAllocationsPerElement() async {
+			let data = UnsafeMutableRawPointer(bitPattern:0x1)!
+			let elementCount = 10_240
+
+			// one element in flight at a time (the reader fifo pattern). the same link should be recycled for every element.
+			for _ in 0..<elementCount {
+				#expect(fifo!.pass(data) == 0)
+				#expect(fifo!.consumeNonBlocking().0 == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+			}
+			let steadyAllocations = fifo!.linkAllocations()
+			#expect(steadyAllocations == 1)
+
+			// bursts that fit within the link pool should not allocate beyond the size of the first burst.
+			let burstSize = Int(__CSWIFTSLASH_FIFO_LINK_POOL_MAX)
+			for _ in 0..<(elementCount / burstSize) {
+				for _ in 0..<burstSize {
+					#expect(fifo!.pass(data) == 0)
+				}
+				for _ in 0..<burstSize {
+					#expect(fifo!.consumeNonBlocking().0 == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+				}
+			}
+			let burstAllocations = fifo!.linkAllocations()
+			#expect(burstAllocations == burstSize)
+
+			// a fifo without a state mutex has nothing to guard the link pool, so every element allocates its own link.
+			let unguarded = Harness(hasMutex:false)
+			for _ in 0..<burstSize {
+				#expect(unguarded.pass(data) == 0)
+				#expect(unguarded.consumeNonBlocking().0 == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+			}
+			#expect(unguarded.linkAllocations() == burstSize)
+		}
+
 		@Test("__cswiftslash_fifo :: set max elements to zero", .timeLimit(.minutes(1)))
 		func testSetMaxElementsToZero() async {
 			#expect(fifo!.setMaxElements(0) == true)
@@ -313,5 +518,58 @@ extension __cswiftslash_tests {
 				consumedData!.deallocate()
 			}
 		}
+
+		@Test("__cswiftslash_fifo :: blocking consume with a deadline", .timeLimit(.minutes(1)))
+		func consumeBlockingUntil() async {
+			// an empty fifo times out once the deadline passes.
+			let waitStart = __cswiftslash_timer_now()
+			let (timeoutResult, timeoutData) = await fifo!.consumeBlocking(timeoutNanoseconds:20_000_000)
+			#expect(timeoutResult == __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK)
+			#expect(timeoutData == nil)
+			#expect(__cswiftslash_timer_now() - waitStart >= 20_000_000)
+
+			// an element that is passed before the deadline is returned.
+			let data = UnsafeMutableRawPointer(bitPattern:0x1357)!
+			#expect(fifo!.pass(data) == 0)
+			let (elementResult, elementData) = await fifo!.consumeBlocking(timeoutNanoseconds:1_000_000_000)
+			#expect(elementResult == __CSWIFTSLASH_FIFO_CONSUME_RESULT)
+			#expect(elementData == data)
+
+			// a capped fifo returns the cap rather than timing out.
+			let capData = UnsafeMutableRawPointer(bitPattern:0x2468)!
+			#expect(fifo!.passCap(capData) == true)
+			let (capResult, consumedCap) = await fifo!.consumeBlocking(timeoutNanoseconds:1_000_000_000)
+			#expect(capResult == __CSWIFTSLASH_FIFO_CONSUME_CAP)
+			#expect(consumedCap == capData)
+		}
+
+		@Test("__cswiftslash_fifo :: statistics counters", .timeLimit(.minutes(1)))
+		func statisticsCounters() async {
+			#expect(fifo!.statistics() == nil)
+			#expect(fifo!.enableStatistics() == true)
+			#expect(fifo!.enableStatistics() == false)
+			for i in 1...5 {
+				#expect(fifo!.pass(UnsafeMutableRawPointer(bitPattern:i)!) == 0)
+			}
+			_ = fifo!.consumeNonBlocking()
+			_ = fifo!.consumeNonBlocking()
+			#expect(fifo!.passMany([UnsafeMutableRawPointer(bitPattern:6)!, UnsafeMutableRawPointer(bitPattern:7)!]).0 == 0)
+			let midStats = fifo!.statistics()!
+			#expect(midStats.depth == 5)
+			#expect(midStats.highWaterMark == 5)
+			#expect(midStats.passed == 7)
+			#expect(midStats.consumed == 2)
+			#expect(midStats.blockedNanoseconds == 0)
+
+			// a blocked consumer accumulates the time it spent waiting.
+			_ = fifo!.consumeAll()
+			let (timeoutResult, _) = await fifo!.consumeBlocking(timeoutNanoseconds:20_000_000)
+			#expect(timeoutResult == __CSWIFTSLASH_FIFO_CONSUME_WOULDBLOCK)
+			let endStats = fifo!.statistics()!
+			#expect(endStats.depth == 0)
+			#expect(endStats.highWaterMark == 5)
+			#expect(endStats.consumed == 7)
+			#expect(endStats.blockedNanoseconds >= 20_000_000)
+		}
 	}
 }
\ No newline at end of file
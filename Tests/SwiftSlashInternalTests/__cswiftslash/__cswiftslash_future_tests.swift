@@ -94,6 +94,23 @@ extension __cswiftslash_tests {
 				return __cswiftslash_future_t_broadcast_res_throw(futurePtr, errType, errVal)
 			}
 
+			/// registers the specified number of async waiters that increment a shared counter when they are fired with a result.
+			fileprivate func registerCountingWaiters(_ count:Int, counter:UnsafeMutablePointer<Atomic<Int>>) -> [UInt64] {
+				var ids = [UInt64]()
+				for _ in 0..<count {
+					ids.append(__cswiftslash_future_t_wait_async(futurePtr, counter, Self.countingResultHandler, Self.countingErrorHandler, Self.countingCancelHandler))
+				}
+				return ids
+			}
+			fileprivate func invalidateAsyncWaiter(_ id:UInt64) -> Bool {
+				return __cswiftslash_future_t_wait_async_invalidate(futurePtr, id)
+			}
+			private static let countingResultHandler:__cswiftslash_future_result_val_handler_f = { _, _, ctxPtr in
+				ctxPtr!.assumingMemoryBound(to:Atomic<Int>.self).pointee.add(1, ordering:.relaxed)
+			}
+			private static let countingErrorHandler:__cswiftslash_future_result_err_handler_f = { _, _, _ in }
+			private static let countingCancelHandler:__cswiftslash_future_result_cncl_handler_f = { _ in }
+
 			fileprivate struct UnexpectedAsyncronousThreading:Swift.Error {}
 			private final class AsyncResult {
 
@@ -357,6 +374,23 @@ extension __cswiftslash_tests {
 					#expect(i == 1)
 				}
 			}
+
+			@Test("__cswiftslash_future :: core :: destroy a cancelled future", .timeLimit(.minutes(1)))
+			func testDestroyCancelledFuture() {
+				// a Future that is cancelled and then released takes this path from its deinitializer.
+				let futurePtr = __cswiftslash_future_t_init()
+				#expect(__cswiftslash_future_t_broadcast_cancel(futurePtr) == true)
+				// a cancelled future has no result to hand back, so neither handler is fired.
+				var handlerFired = false
+				withUnsafeMutablePointer(to:&handlerFired) { handlerFiredPtr in
+					__cswiftslash_future_t_destroy(futurePtr, handlerFiredPtr, { _, _, ctxPtr in
+						ctxPtr!.assumingMemoryBound(to:Bool.self).pointee = true
+					}, { _, _, ctxPtr in
+						ctxPtr!.assumingMemoryBound(to:Bool.self).pointee = true
+					})
+				}
+				#expect(handlerFired == false)
+			}
 		}
 
 		// MARK: - core async tests
@@ -908,6 +942,77 @@ extension __cswiftslash_tests {
 				// ensure that either the result or the error was broadcasted
 				#expect((resultCount == waiterCount && errorCount == 0) || (resultCount == 0 && errorCount == waiterCount))
 			}
+
+			@Test("__cswiftslash_future :: multiple waiters :: invalidation across inline and overflow storage", .timeLimit(.minutes(1)))
+			func testInvalidationAcrossWaiterStorage() async throws {
+				let future = Harness()
+				let counter = UnsafeMutablePointer<Atomic<Int>>.allocate(capacity:1)
+				counter.initialize(to:Atomic<Int>(0))
+				defer {
+					counter.deinitialize(count:1)
+					counter.deallocate()
+				}
+
+				// the first waiter is stored inline and the rest are stored in allocated links. every identifier must be unique and non-zero.
+				let ids = future.registerCountingWaiters(6, counter:counter)
+				#expect(Set(ids).count == 6)
+				#expect(ids.contains(0) == false)
+
+				// invalidate one inline waiter and one overflow waiter. a second invalidation of the same waiter must fail.
+				#expect(future.invalidateAsyncWaiter(ids[0]) == true)
+				#expect(future.invalidateAsyncWaiter(ids[4]) == true)
+				#expect(future.invalidateAsyncWaiter(ids[4]) == false)
+
+				// a waiter that is registered after an invalidation does not collide with the remaining waiters.
+				let reused = future.registerCountingWaiters(1, counter:counter)
+				#expect(ids.contains(reused[0]) == false)
+
+				#expect(future.broadcastResultValue(resType:1, resVal:nil) == true)
+				#expect(counter.pointee.load(ordering:.relaxed) == 5)
+				#expect(future.invalidateAsyncWaiter(ids[1]) == false)
+			}
+
+			@Test("__cswiftslash_future :: multiple waiters :: stale and foreign identifiers are rejected and links are reused", .timeLimit(.minutes(1)))
+			func testStaleIdentifiersAndLinkReuse() async throws {
+				let future = Harness()
+				let otherFuture = Harness()
+				let counter = UnsafeMutablePointer<Atomic<Int>>.allocate(capacity:1)
+				counter.initialize(to:Atomic<Int>(0))
+				defer {
+					counter.deinitialize(count:1)
+					counter.deallocate()
+				}
+
+				// identifiers that were never issued by a future are rejected without being dereferenced.
+				let ids = future.registerCountingWaiters(2, counter:counter)
+				#expect(otherFuture.invalidateAsyncWaiter(ids[0]) == false)
+				#expect(future.invalidateAsyncWaiter(0xDEADBEEF_00000005) == false)
+				#expect(future.invalidateAsyncWaiter(UInt64.max) == false)
+
+				// a waiter that is registered and invalidated repeatedly keeps reusing the same link, and every identifier it is given is unique.
+				var issued = Set<UInt64>()
+				var slots = Set<UInt64>()
+				for _ in 0..<10_000 {
+					let id = future.registerCountingWaiters(1, counter:counter)[0]
+					#expect(issued.insert(id).inserted == true)
+					slots.insert(id & 0xFFFF_FFFF)
+					#expect(future.invalidateAsyncWaiter(id) == true)
+				}
+				#expect(slots.count == 1)
+
+				// a stale identifier does not invalidate the waiter that now occupies its link.
+				#expect(future.invalidateAsyncWaiter(ids[1]) == true)
+				let current = future.registerCountingWaiters(1, counter:counter)[0]
+				#expect(future.invalidateAsyncWaiter(ids[1]) == false)
+				for stale in issued {
+					#expect(future.invalidateAsyncWaiter(stale) == false)
+				}
+
+				#expect(future.broadcastResultValue(resType:1, resVal:nil) == true)
+				#expect(counter.pointee.load(ordering:.relaxed) == 2)
+				#expect(future.invalidateAsyncWaiter(current) == false)
+				#expect(otherFuture.broadcastResultValue(resType:1, resVal:nil) == true)
+			}
 		}
 	}
 }
\ No newline at end of file
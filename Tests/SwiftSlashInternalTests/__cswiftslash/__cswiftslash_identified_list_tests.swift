@@ -12,6 +12,8 @@ copyright (c) tanner silva 2024. all rights reserved.
 import Testing
 @testable import __cswiftslash_identified_list
 
+import class Foundation.ProcessInfo
+
 extension Tag {
 	@Tag internal static var __cswiftslash_identified_list:Self
 }
@@ -22,6 +24,9 @@ extension __cswiftslash_tests {
 		.tags(.__cswiftslash_identified_list)
 	)
 	internal struct IdentifiedList {
+		/// benchmarks are only run when the `SWIFTSLASH_BENCHMARKS` environment variable is set, so that they do not slow down the unit suite.
+		fileprivate static let benchmarksEnabled = ProcessInfo.processInfo.environment["SWIFTSLASH_BENCHMARKS"] != nil
+
 		private actor KeyManager {
 			private var keys:[UInt64] = []
 			fileprivate func addKey(_ key: UInt64) {
@@ -99,6 +104,56 @@ extension __cswiftslash_tests {
 			}
 		}
 
+		fileprivate final class ShardedIdentifiedListHarness:@unchecked Sendable {
+			fileprivate let listPtr:UnsafeMutablePointer<__cswiftslash_identified_list_sharded_t>
+			/// the number of shards the list is expected to have, after rounding the requested count up to a power of two.
+			fileprivate let shardCount:Int
+
+			/// initializes a new sharded list instance.
+			fileprivate init(shards:Int) {
+				listPtr = __cswiftslash_identified_list_sharded_init(shards)
+				shardCount = 1 << (Int.bitWidth - (shards - 1).leadingZeroBitCount)
+			}
+
+			/// inserts a data pointer into the sharded list.
+			@discardableResult fileprivate func insert(_ data:UnsafeMutableRawPointer) -> UInt64 {
+				__cswiftslash_identified_list_sharded_insert(listPtr, data)
+			}
+
+			/// removes a data pointer from the sharded list by key.
+			fileprivate func remove(key:UInt64) -> UnsafeMutableRawPointer? {
+				__cswiftslash_identified_list_sharded_remove(listPtr, key)
+			}
+
+			/// iterates over the sharded list, processing each element with the provided consumer function.
+			fileprivate func iterate(_ consumer:@escaping (UInt64, UnsafeMutableRawPointer?) -> Void) {
+				let cc = Unmanaged.passRetained(ShardedConsumerContext(consumer)).toOpaque()
+				__cswiftslash_identified_list_sharded_iterate(listPtr, ShardedIdentifiedListHarness.consumerFunction, cc, false)
+				_ = Unmanaged<ShardedConsumerContext>.fromOpaque(cc).takeRetainedValue()
+			}
+
+			/// closes the sharded list, deallocating any remaining elements.
+			fileprivate func close(consumer:@escaping ((UInt64, UnsafeMutableRawPointer?) -> Void) = { _, _ in }) {
+				let cc = Unmanaged.passRetained(ShardedConsumerContext(consumer)).toOpaque()
+				__cswiftslash_identified_list_sharded_close(listPtr, ShardedIdentifiedListHarness.consumerFunction, cc)
+				_ = Unmanaged<ShardedConsumerContext>.fromOpaque(cc).takeRetainedValue()
+			}
+
+			/// context to pass the consumer closure
+			private final class ShardedConsumerContext {
+				fileprivate let consumer:(UInt64, UnsafeMutableRawPointer?) -> Void
+				fileprivate init(_ consumer: @escaping (UInt64, UnsafeMutableRawPointer?) -> Void) {
+					self.consumer = consumer
+				}
+			}
+
+			/// C function pointer compatible with __cswiftslash_identified_list_iterator_f
+			private static let consumerFunction:__cswiftslash_identified_list_iterator_f = { (key, ptr, ctx) in
+				let context = Unmanaged<ShardedConsumerContext>.fromOpaque(ctx).takeUnretainedValue()
+				context.consumer(key, ptr)
+			}
+		}
+
 		private let list = IdentifiedListHarness()
 
 
@@ -371,6 +426,51 @@ extension __cswiftslash_tests {
 			list.close()
 		}
 
+		@Test("__cswiftslash_identified_list :: insert, iterate and remove benchmark", .enabled(if:IdentifiedList.benchmarksEnabled, "set SWIFTSLASH_BENCHMARKS to run benchmarks"), .timeLimit(.minutes(1)))
+		func testInsertIterateRemoveBenchmark() {
+			let data = UnsafeMutableRawPointer(bitPattern:0x1)!
+			var perElement:[Int:Duration] = [:]
+			for elementCount in [10, 1_000, 1_000_000] {
+				let benchList = IdentifiedListHarness()
+				var keys:[UInt64] = []
+				keys.reserveCapacity(elementCount)
+
+				let insertStart = ContinuousClock.now
+				for _ in 0..<elementCount {
+					keys.append(benchList.insert(data))
+				}
+				let insertDuration = ContinuousClock.now - insertStart
+
+				var iterated = 0
+				let iterateStart = ContinuousClock.now
+				benchList.iterate { _, _ in
+					iterated += 1
+				}
+				let iterateDuration = ContinuousClock.now - iterateStart
+				#expect(iterated == elementCount)
+
+				// remove in insertion order so that every removal lands at the front of a probe run, which is where backward-shift deletion does the most work.
+				var removed = 0
+				let removeStart = ContinuousClock.now
+				for key in keys {
+					if benchList.remove(key:key) != nil {
+						removed += 1
+					}
+				}
+				let removeDuration = ContinuousClock.now - removeStart
+				#expect(removed == elementCount)
+
+				// the table has shrunk back down, so a fresh insert must still be found.
+				let lastKey = benchList.insert(data)
+				#expect(benchList.remove(key:lastKey) == data)
+				benchList.close()
+				perElement[elementCount] = (insertDuration + iterateDuration + removeDuration) / elementCount
+			}
+			// every operation is amortized constant time, so the cost per element must not grow with the size of the list. the bound is loose enough to absorb cache effects, but not a quadratic pass.
+			#expect(perElement[1_000_000]! < perElement[1_000]! * 100)
+			list.close()
+		}
+
 		@Test("__cswiftslash_identified_list :: insert and remove same element multiple times", .timeLimit(.minutes(1)))
 		func testInsertRemoveSameElementMultipleTimes() {
 			let data = UnsafeMutableRawPointer.allocate(byteCount: 1, alignment: 1)
@@ -387,5 +487,72 @@ extension __cswiftslash_tests {
 			data.deallocate()
 			list.close()
 		}
+
+		@Test("__cswiftslash_identified_list :: sharded concurrent insertions and removals", .timeLimit(.minutes(1)))
+		func testShardedConcurrentInsertionsAndRemovals() async {
+			let sharded = ShardedIdentifiedListHarness(shards:6)
+			let taskCount = 8
+			let roundsPerTask = 2_000
+			let keptKeys = await withTaskGroup(of:[UInt64].self, returning:Set<UInt64>.self) { group in
+				for taskIndex in 0..<taskCount {
+					group.addTask {
+						var kept:[UInt64] = []
+						for round in 0..<roundsPerTask {
+							let data = UnsafeMutableRawPointer(bitPattern:(taskIndex * roundsPerTask) + round + 1)!
+							let key = sharded.insert(data)
+							if round % 2 == 0 {
+								#expect(sharded.remove(key:key) == data)
+								#expect(sharded.remove(key:key) == nil)
+							} else {
+								kept.append(key)
+							}
+						}
+						return kept
+					}
+				}
+				var allKept = Set<UInt64>()
+				for await kept in group {
+					allKept.formUnion(kept)
+				}
+				return allKept
+			}
+			#expect(keptKeys.count == taskCount * roundsPerTask / 2)
+
+			var foundKeys = Set<UInt64>()
+			sharded.close { k, _ in
+				foundKeys.insert(k)
+			}
+			#expect(foundKeys == keptKeys)
+			list.close()
+		}
+
+		@Test("__cswiftslash_identified_list :: sharded iteration keeps insertion order per shard", .timeLimit(.minutes(1)))
+		func testShardedIterationOrder() {
+			let sharded = ShardedIdentifiedListHarness(shards:3)
+			let data = UnsafeMutableRawPointer(bitPattern:0x1)!
+			var keys:[UInt64] = []
+			for _ in 0..<1_000 {
+				keys.append(sharded.insert(data))
+			}
+			// remove a spread of keys so that the per-shard chains have holes in them.
+			for key in keys where key % 7 == 0 {
+				#expect(sharded.remove(key:key) == data)
+			}
+
+			let shardMask = UInt64(sharded.shardCount - 1)
+			var perShard:[UInt64:[UInt64]] = [:]
+			var iterated = 0
+			sharded.iterate { k, _ in
+				perShard[k & shardMask, default:[]].append(k)
+				iterated += 1
+			}
+			#expect(iterated == keys.filter { $0 % 7 != 0 }.count)
+			#expect(perShard.count == sharded.shardCount)
+			for (_, shardKeys) in perShard {
+				#expect(shardKeys == shardKeys.sorted())
+			}
+			sharded.close()
+			list.close()
+		}
 	}
 }
\ No newline at end of file
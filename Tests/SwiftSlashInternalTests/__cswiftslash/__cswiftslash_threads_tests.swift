@@ -59,6 +59,8 @@ extension __cswiftslash_tests {
 		
 			// thread
 			fileprivate var thread:__cswiftslash_threads_t_type? = nil
+			// job (when submitted to a pool)
+			fileprivate var job:UnsafeMutablePointer<__cswiftslash_threads_job_t>? = nil
 		
 			// function pointers for the thread configuration
 			fileprivate let alloc_f:__cswiftslash_threads_alloc_f!
@@ -115,6 +117,36 @@ extension __cswiftslash_tests {
 				self.thread = thread
 			}
 		
+			fileprivate func submitJob(to pool:UnsafeMutablePointer<__cswiftslash_threads_pool_t>) {
+				let arg = Unmanaged.passUnretained(self).toOpaque()
+				let config = __cswiftslash_threads_config_init(
+					arg,
+					alloc_f,
+					run_f.pointee,
+					cancel_f,
+					dealloc_f
+				)
+				job = __cswiftslash_threads_pool_submit(pool, config)
+			}
+
+			fileprivate func cancelJob() {
+				__cswiftslash_threads_job_cancel(job!)
+			}
+
+			fileprivate func joinJob() async -> [HandlerCall] {
+				await withUnsafeContinuation { (continuation:UnsafeContinuation<Void, Never>) in
+					__cswiftslash_threads_job_join(job!)
+					__cswiftslash_threads_job_destroy(job!)
+					job = nil
+					continuation.resume()
+				}
+				return await withUnsafeContinuation { (continuation:UnsafeContinuation<[HandlerCall], Never>) in
+					handlerCallsLock.lock()
+					continuation.resume(returning:handlerCalls.pointee)
+					handlerCallsLock.unlock()
+				}
+			}
+
 			fileprivate func cancelThread() {
 				pthread_cancel(thread!)
 			}
@@ -278,5 +310,95 @@ extension __cswiftslash_tests {
 				}
 			}
 		}
+
+		@Test("__cswiftslash_threads :: pool reuses its workers", .timeLimit(.minutes(1)))
+		func testPoolReusesWorkers() async {
+			let pool = __cswiftslash_threads_pool_init(2, 0)!
+			let jobCount = 256
+			for _ in 0..<jobCount {
+				let harness = ThreadHarness()
+				harness.run_f.pointee = { _ in }
+				harness.submitJob(to:pool)
+				let calls = await harness.joinJob()
+				#expect(calls.count == 3, "expected 3 handler calls, got \(calls.count)")
+				#expect(calls.last == .deallocCalled, "expected deallocator to be called last")
+			}
+			let created = __cswiftslash_threads_pool_threads_created(pool)
+			#expect(created < jobCount / 4, "expected the pool to reuse its threads, but it created \(created) for \(jobCount) jobs")
+			__cswiftslash_threads_pool_destroy(pool)
+		}
+
+		@Test("__cswiftslash_threads :: pool rounds the stack size of its workers to the page size", .timeLimit(.minutes(1)))
+		func testPoolStackSizeIsRounded() async {
+			// a stack size that is not a multiple of the page size is rejected by darwin unless the pool rounds it up, as dedicated threads do.
+			let pool = __cswiftslash_threads_pool_init(2, (256 * 1024) + 1)
+			#expect(pool != nil, "expected the pool to start workers with an unaligned stack size")
+			guard let pool else {
+				return
+			}
+			let harness = ThreadHarness()
+			harness.run_f.pointee = { _ in }
+			harness.submitJob(to:pool)
+			let calls = await harness.joinJob()
+			#expect(calls.count == 3, "expected 3 handler calls, got \(calls.count)")
+			__cswiftslash_threads_pool_destroy(pool)
+		}
+
+		@Test("__cswiftslash_threads :: pool starts blocked work beyond its worker count", .timeLimit(.minutes(1)))
+		func testPoolOverflowsWhenSaturated() async {
+			let pool = __cswiftslash_threads_pool_init(2, 0)!
+			// every job sleeps for a second, so finishing in well under the serial time proves they all ran at once instead of queueing behind the two workers.
+			let harnesses = (0..<8).map { _ in ThreadHarness() }
+			let start = ContinuousClock.now
+			for harness in harnesses {
+				harness.submitJob(to:pool)
+			}
+			for harness in harnesses {
+				let calls = await harness.joinJob()
+				#expect(calls.count == 3, "expected 3 handler calls, got \(calls.count)")
+			}
+			#expect(ContinuousClock.now - start < .seconds(4))
+			__cswiftslash_threads_pool_destroy(pool)
+		}
+
+		@Test("__cswiftslash_threads :: pool caps its overflow workers", .timeLimit(.minutes(1)))
+		func testPoolCapsOverflowWorkers() async {
+			let pool = __cswiftslash_threads_pool_init(2, 0)!
+			// more blocked jobs than the pool may run at once. the jobs beyond the cap wait for a worker instead of each starting a thread.
+			let overflowMax = Int(__CSWIFTSLASH_THREADS_POOL_OVERFLOW_MAX)
+			let harnesses = (0..<(2 + overflowMax + 8)).map { _ in ThreadHarness() }
+			for harness in harnesses {
+				harness.submitJob(to:pool)
+			}
+			for harness in harnesses {
+				let calls = await harness.joinJob()
+				#expect(calls.count == 3, "expected 3 handler calls, got \(calls.count)")
+			}
+			let created = __cswiftslash_threads_pool_threads_created(pool)
+			#expect(created <= 2 + overflowMax, "expected at most \(2 + overflowMax) threads, but the pool created \(created)")
+			__cswiftslash_threads_pool_destroy(pool)
+		}
+
+		@Test("__cswiftslash_threads :: pool job cancellation", .timeLimit(.minutes(1)))
+		func testPoolJobCancellation() async {
+			let pool = __cswiftslash_threads_pool_init(2, 0)!
+			let cancelled = ThreadHarness()
+			cancelled.submitJob(to:pool)
+			usleep(100_000) // 100ms
+			cancelled.cancelJob()
+			let cancelledCalls = await cancelled.joinJob()
+			#expect(cancelledCalls.contains(.cancelCalled), "cancel handler was not called")
+			#expect(cancelledCalls.last == .deallocCalled, "expected deallocator to be called last")
+
+			// the cancelled worker is replaced, and the cancellation does not leak into work that runs afterwards.
+			for _ in 0..<4 {
+				let harness = ThreadHarness()
+				harness.submitJob(to:pool)
+				let calls = await harness.joinJob()
+				#expect(calls.contains(.cancelCalled) == false, "a later job was cancelled")
+				#expect(calls.count == 3, "expected 3 handler calls, got \(calls.count)")
+			}
+			__cswiftslash_threads_pool_destroy(pool)
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+LICENSE MIT
+copyright (c) tanner silva 2025. all rights reserved.
+
+   _____      ______________________   ___   ______ __
+  / __/ | /| / /  _/ __/_  __/ __/ /  / _ | / __/ // /
+ _\ \ | |/ |/ // // _/  / / _\ \/ /__/ __ |_\ \/ _  / 
+/___/ |__/|__/___/_/   /_/ /___/____/_/ |_/___/_//_/  
+
+*/
+
+import Testing
+@testable import __cswiftslash_timer
+
+import Synchronization
+
+extension Tag {
+	@Tag internal static var __cswiftslash_timer:Self
+}
+
+extension __cswiftslash_tests {
+	@Suite("__cswiftslash_timer",
+		.serialized,
+		.tags(.__cswiftslash_timer)
+	)
+	internal struct __cswiftslash_timer {
+		// MARK: c harness
+		/// records the order in which scheduled deadlines are fired
+		private final class FireLog:Sendable {
+			fileprivate let fired:Mutex<[Int]> = .init([])
+			fileprivate let continuation:Mutex<CheckedContinuation<Void, Never>?> = .init(nil)
+			fileprivate let expected:Int
+			fileprivate init(expected:Int) {
+				self.expected = expected
+			}
+			/// appends a fired tag, resuming the waiting task once the expected number of deadlines have fired
+			fileprivate func append(_ tag:Int) {
+				let done = fired.withLock { fired in
+					fired.append(tag)
+					return fired.count == expected
+				}
+				if done == true {
+					continuation.withLock { $0.take() }?.resume()
+				}
+			}
+			/// suspends until the expected number of deadlines have fired
+			fileprivate func wait() async {
+				await withCheckedContinuation { (newContinuation:CheckedContinuation<Void, Never>) in
+					continuation.withLock { $0 = newContinuation }
+					// the deadlines may have fired before the continuation was stored.
+					if fired.withLock({ $0.count }) == expected {
+						continuation.withLock { $0.take() }?.resume()
+					}
+				}
+			}
+		}
+		/// the context that is scheduled with each deadline
+		private final class Tagged {
+			fileprivate let log:FireLog
+			fileprivate let tag:Int
+			fileprivate init(_ log:FireLog, tag:Int) {
+				self.log = log
+				self.tag = tag
+			}
+		}
+		/// schedules a deadline that appends its tag to the log when it fires
+		private static func schedule(_ log:FireLog, tag:Int, at deadline:UInt64) -> (timer:UnsafeMutablePointer<__cswiftslash_timer_entry_t>, context:UnsafeMutableRawPointer) {
+			let context = Unmanaged.passRetained(Tagged(log, tag:tag)).toOpaque()
+			let timer = __cswiftslash_timer_schedule(deadline, { ctxPtr in
+				let tagged = Unmanaged<Tagged>.fromOpaque(ctxPtr!).takeRetainedValue()
+				tagged.log.append(tagged.tag)
+			}, context)
+			return (timer:timer, context:context)
+		}
+
+		// MARK: test cases
+
+		@Test("__cswiftslash_timer :: deadlines fire in order and cancelled deadlines never fire", .timeLimit(.minutes(1)))
+		func deadlinesFireInOrder() async {
+			let log = FireLog(expected:3)
+			let now = __cswiftslash_timer_now()
+			// scheduled out of order, with the last deadline cancelled before it fires.
+			let deadlines:[(tag:Int, offset:UInt64)] = [(3, 40_000_000), (2, 30_000_000), (1, 10_000_000), (0, 20_000_000)]
+			let scheduled = deadlines.map { Self.schedule(log, tag:$0.tag, at:now + $0.offset) }
+			#expect(__cswiftslash_timer_cancel(scheduled[3].timer) == true)
+			// the cancelled handler never fires, so its context is released here.
+			Unmanaged<Tagged>.fromOpaque(scheduled[3].context).release()
+			await log.wait()
+			#expect(log.fired.withLock { $0 } == [1, 2, 3])
+			// every handler has fired, so none of the remaining deadlines can be cancelled.
+			for entry in scheduled.prefix(3) {
+				#expect(__cswiftslash_timer_cancel(entry.timer) == false)
+			}
+		}
+
+		@Test("__cswiftslash_timer :: a deadline in the past fires immediately", .timeLimit(.minutes(1)))
+		func pastDeadlineFires() async {
+			let log = FireLog(expected:1)
+			let scheduled = Self.schedule(log, tag:7, at:0)
+			await log.wait()
+			#expect(__cswiftslash_timer_cancel(scheduled.timer) == false)
+			#expect(log.fired.withLock { $0 } == [7])
+		}
+	}
+}
\ No newline at end of file